@@ -1,9 +1,8 @@
-#define MAX_LIGHTS 10
-
 /**
  * @file
  *  Fragment shader for lighting.
- *  Per-pixel point light lighting is done in this shader.
+ *  Level lights come from a baked lightmap, and lights that move
+ *  are done per-pixel on top of it.
  *
  * @author      George Kudrayvtsev (switch1440)
  * @version     1.0
@@ -21,31 +20,59 @@
  * @addtogroup Shaders
  * @{
  */
- 
-uniform sampler2D   tex;                    // Active texture
+
+#define MAX_LIGHTS  128                     // Lights on the screen at once
+#define TILE_SIZE   32                      // Light tile size, in pixels
+#define TILE_LIGHTS 16                      // Most lights touching a tile
+
+uniform sampler2D   tex;                    // The scene, unlit
+uniform sampler2D   light_tiles;            // Light index + 1 per tile slot, 0 ends the list
+uniform sampler2D   lightmap;               // Baked level lights, in world space
+uniform vec4        lightmap_rect;          // Lightmap origin, and 1 / size, in world pixels
+uniform float       lightmap_range;         // Brightest light the lightmap holds
+uniform vec2        tile_count;             // Tiles across and down the screen
 uniform int         scr_height;             // Screen height
+uniform vec2        view_offset;            // Camera offset (screen = world + offset)
 uniform vec2        light_pos[MAX_LIGHTS];  // Light position
 uniform vec3        light_col[MAX_LIGHTS];  // Light color
 uniform vec3        light_att[MAX_LIGHTS];  // Light attenuation
 uniform float       light_brt[MAX_LIGHTS];  // Light brightness
+uniform float       light_rad[MAX_LIGHTS];  // Light radius, it's faded out towards it
 
 void main()
 {
-    vec2 pixel      = gl_FragCoord.xy;
-    pixel.y         = scr_height - pixel.y;
-    
-    vec3 lights;
-    
-    for(int i = 0; i < MAX_LIGHTS; ++i)
+    vec2 screen     = gl_FragCoord.xy;
+    screen.y        = float(scr_height) - screen.y;
+    vec2 pixel      = screen - view_offset; // Lights are in world space
+
+    // Only the lights reaching this tile are looked at.
+    vec2 tile       = floor(screen / float(TILE_SIZE));
+    float row       = (tile.y + 0.5) / tile_count.y;
+    float width     = tile_count.x * float(TILE_LIGHTS);
+
+    vec2 baked      = (pixel - lightmap_rect.xy) * lightmap_rect.zw;
+    vec3 lights     = texture2D(lightmap, baked).rgb * lightmap_range;
+
+    for(int i = 0; i < TILE_LIGHTS; ++i)
     {
-        vec2 light_vec  = light_pos[i]  - pixel;
+        float slot  = tile.x * float(TILE_LIGHTS) + float(i);
+        float entry = texture2D(light_tiles, vec2((slot + 0.5) / width, row)).r * 255.0;
+        if(entry < 0.5)
+            break;
+
+        int light       = int(entry - 0.5);
+        vec2 light_vec  = light_pos[light]  - pixel;
         float dist      = length(light_vec);
     
-        float att       = 1.0 / ( light_att[i].x + 
-                                 (light_att[i].y * dist) + 
-                                 (light_att[i].z * dist * dist));
+        float att       = 1.0 / ( light_att[light].x + 
+                                 (light_att[light].y * dist) + 
+                                 (light_att[light].z * dist * dist));
+
+        // Smoothly reach zero at the radius, so tiles don't show.
+        float fade      = dist / light_rad[light];
+        fade            = clamp(1.0 - fade * fade * fade * fade, 0.0, 1.0);
 
-        lights         += light_col[i] * att * light_brt[i];
+        lights         += light_col[light] * att * light_brt[light] * fade * fade;
     }
     
     vec4 texel      = texture2D(tex, gl_TexCoord[0].st) * gl_Color;
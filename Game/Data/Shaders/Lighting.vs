@@ -1,5 +1,3 @@
-#define MAX_LIGHTS 10
-
 /**
  * @file
  *  Vertex shader for lighting.
@@ -22,6 +22,10 @@
 #ifndef ASSETS__ASSET_MANAGER_HPP
 #define ASSETS__ASSET_MANAGER_HPP
 
+#include <string>
+#include <vector>
+#include <unordered_map>
+
 #include "CollapseDef.hpp"
 #include "Assets/Asset.hpp"
 
@@ -29,73 +33,72 @@ namespace asset
 {
     using game::g_Log;
 
+    /// 64-bit hash of a normalised asset path.
+    typedef unsigned long long path_hash;
+
+    /**
+     * Owns and tracks every loaded asset.
+     *  Assets are indexed by a hash of their normalised filename, so
+     *  "Data\Textures\Spark.png" and "data/textures/./spark.png" are
+     *  the same asset, and by their ID.
+     **/
     class CAssetManager
     {
     public:
         virtual ~CAssetManager();
 
-        static CAsset* Find(const char* pfilename)
-        {
-            // Comparing hashes is much quicker than comparing strings.
-            asset::asset_id searcher = CAsset::Hash(pfilename);
-            for(size_t i = 0; i < CAssetManager::mp_allAssets.size(); ++i)
-                if(searcher == CAsset::Hash(
-                    CAssetManager::mp_allAssets[i]->GetFilename()))
-                    return CAssetManager::mp_allAssets[i];
-
-            // Specified asset wasn't found.
-            return NULL;
-        }
-        static CAsset* Find(const asset::asset_id uid)
-        {
-            for(size_t i = 0; i < mp_allAssets.size(); ++i)
-                if(uid == CAssetManager::mp_allAssets[i]->GetID())
-                    return CAssetManager::mp_allAssets[i];
-
-            return NULL;
-        }
+        static CAsset* Find(const char* pfilename);
+        static CAsset* Find(const asset::asset_id uid);
 
         template<typename T>
         static T* Create(const char* pfilename)
         {
-            T* pTest = (T*)CAssetManager::Find(pfilename);
-            if(pTest != NULL)
+            path_hash key = CAssetManager::HashFilename(pfilename);
+
+            AssetMap::iterator i = CAssetManager::m_ByFilename.find(key);
+            if(i != CAssetManager::m_ByFilename.end())
+                return (T*)i->second;
+
+            g_Log.Flush();
+            g_Log << "[INFO] Creating asset: " << pfilename << ".\n";
+            g_Log.ShowLastLog();
+
+            T* pLatest = new T;
+            if(pLatest->LoadFromFile(pfilename))
             {
-                g_Log.Flush();
-                g_Log << "[INFO] Retrieving asset: " << pfilename << ".\n";
-                g_Log.ShowLastLog();
-                return pTest;
+                CAssetManager::Add(key, pLatest);
+                return pLatest;
             }
             else
             {
+                delete pLatest;
                 g_Log.Flush();
-                g_Log << "[INFO] Creating asset: " << pfilename << ".\n";
-                g_Log.ShowLastLog();
-
-                T* pLatest = new T;
-                if(pLatest->LoadFromFile(pfilename))
-                {
-                    CAssetManager::mp_allAssets.push_back(pLatest);
-                    return (T*)CAssetManager::mp_allAssets.back();
-                }
-                else
-                {
-                    g_Log.Flush();
-                    g_Log << "[ERROR] Failed to load asset: " << pfilename << ".\n";
-                    gk::handle_error(g_Log.GetLastLog().c_str());
-                    return NULL;
-                }
+                g_Log << "[ERROR] Failed to load asset: " << pfilename << ".\n";
+                gk::handle_error(g_Log.GetLastLog().c_str());
+                return NULL;
             }
         }
 
+        static bool Register(CAsset* pAsset);
+
+        static path_hash HashFilename(const char* pfilename);
+
         static inline u_int GetAssetCount()
         {
             return CAssetManager::mp_allAssets.size();
         }
 
     private:
+        typedef std::unordered_map<path_hash, CAsset*> AssetMap;
+        typedef std::unordered_map<asset::asset_id, CAsset*> IDMap;
+
         CAssetManager();
+
+        static void Add(const path_hash key, CAsset* pAsset);
+
         static std::vector<CAsset*> mp_allAssets;
+        static AssetMap             m_ByFilename;
+        static IDMap                m_ByID;
     };
 }
 
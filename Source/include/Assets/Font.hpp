@@ -22,6 +22,7 @@
 #ifndef ASSETS__FONT_HPP
 #define ASSETS__FONT_HPP
 
+#include <map>
 #include <string>
 
 #include "SDL/SDL_ttf.h"
@@ -29,6 +30,7 @@
 #include "Graphics/Graphics.hpp"
 #include "World/Objects/Entity.hpp"
 #include "Assets/Asset.hpp"
+#include "Assets/GlyphAtlas.hpp"
 
 namespace asset
 {
@@ -46,6 +48,8 @@ namespace asset
         obj::CEntity* RenderText(const char* ptext,
                                  const gfx::Color& Text_Color) const;
 
+        const CGlyphAtlas* GetGlyphs(const u_int size);
+
         SDL_Surface* RenderText_SDL(const char* ptext) const;
         SDL_Surface* RenderText_SDL(const char* ptext,
                                     const gfx::Color& Text_Color) const;
@@ -67,6 +71,8 @@ namespace asset
 
         TTF_Font*   mp_Data;
         u_int       m_size;
+
+        std::map<u_int, CGlyphAtlas*> mp_allGlyphs;
     };
 }
 
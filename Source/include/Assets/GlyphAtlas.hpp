@@ -0,0 +1,80 @@
+/**
+ * @file
+ *  Declarations for the CGlyphAtlas class.
+ *
+ * @author      George Kudrayvtsev (switch1440)
+ * @version     1.0
+ * @copyright   Apache License v2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License").\n
+ *  You may not use this file except in compliance with the License.\n
+ *  You may obtain a copy of the License at:
+ *  http://www.apache.org/licenses/LICENSE-2.0 \n
+ *  Unless required by applicable law or agreed to in writing, software\n
+ *  distributed under the License is distributed on an "AS IS" BASIS,\n
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.\n
+ *  See the License for the specific language governing permissions and\n
+ *  limitations under the License.
+ *
+ * @addtogroup Assets
+ **/
+/// @{
+
+#ifndef ASSETS__GLYPH_ATLAS_HPP
+#define ASSETS__GLYPH_ATLAS_HPP
+
+#include "SDL/SDL_ttf.h"
+
+#include "Math/Math.hpp"
+#include "Graphics/Graphics.hpp"
+
+namespace asset
+{
+    /// First and last characters rasterised into a glyph atlas.
+    static const char FIRST_GLYPH = ' ';
+    static const char LAST_GLYPH  = '~';
+
+    /**
+     * Every printable ASCII glyph of a font at one size, on one texture.
+     *  The glyphs are rendered once, in white, so text of any color can
+     *  be drawn from the same texture by tinting it with glColor().
+     *
+     * @see gfx::CText
+     **/
+    class CGlyphAtlas
+    {
+    public:
+        /// Where a glyph is on the atlas, and how to place it.
+        struct Glyph
+        {
+            math::CRectf TexCoords; // Normalized atlas coordinates
+            int x, y;               // Offset from the pen position
+            int w, h;               // Size in pixels
+            int advance;            // Pen movement afterwards
+        };
+
+        CGlyphAtlas();
+        ~CGlyphAtlas();
+
+        bool Create(const char* pfilename, const u_int size);
+
+        const Glyph* GetGlyph(const char c) const;
+        GLuint GetTexture() const;
+        int    GetLineSkip() const;
+        int    GetHeight() const;
+        u_int  GetSize() const;
+
+    private:
+        CGlyphAtlas(const CGlyphAtlas&);
+        CGlyphAtlas& operator= (const CGlyphAtlas&);
+
+        Glyph   m_Glyphs[LAST_GLYPH - FIRST_GLYPH + 1];
+        GLuint  m_texture;
+        int     m_line_skip;
+        int     m_height;
+        u_int   m_size;
+    };
+}
+
+#endif // ASSETS__GLYPH_ATLAS_HPP
+
+/// @}
@@ -53,7 +53,8 @@ namespace asset
         ~CSound2D();
 
         /// Initializes OpenAL and ALUT.
-        static bool InitializeOpenAL();
+        static bool InitializeOpenAL(const bool null_device = false);
+        static bool IsNullDevice();
 
         /**
          * Moves the sound source to a new location.
@@ -100,6 +101,8 @@ namespace asset
         ALuint  m_buffer;
         ALint   m_source;
         ALenum  m_lasterror;
+
+        static bool s_null_device;
     };
 }
 
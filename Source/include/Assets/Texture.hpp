@@ -27,24 +27,53 @@
 
 namespace asset
 {
+    /**
+     * An OpenGL texture.
+     *  A texture either owns its own GL texture, or is a window into
+     *  a page of an asset::CTextureAtlas, in which case GetUV() gives
+     *  the part of the page it covers.
+     **/
     class CTexture : public asset::CAsset
     {
     public:
-    	CTexture() : m_texture(0) {}
-    	virtual ~CTexture() { glDeleteTextures(1, &m_texture); }
+    	CTexture() : m_UV(0.0f, 0.0f, 1.0f, 1.0f), m_texture(0),
+            m_owner(false) {}
+    	virtual ~CTexture() { if(m_owner) glDeleteTextures(1, &m_texture); }
+
+        // Copies share the GL texture, but only the original frees it.
+        CTexture(const CTexture& Copy) : asset::CAsset(Copy),
+            m_Size(Copy.m_Size), m_UV(Copy.m_UV),
+            m_texture(Copy.m_texture), m_owner(false) {}
+        CTexture& operator=(const CTexture& Copy)
+        {
+            if(this == &Copy) return (*this);
+            if(m_owner) glDeleteTextures(1, &m_texture);
+
+            asset::CAsset::operator=(Copy);
+            m_Size      = Copy.m_Size;
+            m_UV        = Copy.m_UV;
+            m_texture   = Copy.m_texture;
+            m_owner     = false;
+            return (*this);
+        }
     
         bool LoadFromFile(const char* pfilename);
         bool LoadFromSurface(SDL_Surface* pSurface);
+        bool LoadFromAtlas(const char* pfilename, const GLuint page,
+            const u_int w, const u_int h, const math::CRectf& UV);
         
         void Resize(const u_int w, const u_int h);
 
         GLuint GetTexture() const;
         GLint  GetW() const;
         GLint  GetH() const;
+        const math::CRectf& GetUV() const;
 
     private:
         math::CRect m_Size;
+        math::CRectf m_UV;
         GLuint      m_texture;
+        bool        m_owner;
     };
 }
 
@@ -0,0 +1,103 @@
+/**
+ * @file
+ *  Declarations for the CTextureAtlas class.
+ *
+ * @author      George Kudrayvtsev (switch1440)
+ * @version     1.0
+ * @copyright   Apache License v2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License").\n
+ *  You may not use this file except in compliance with the License.\n
+ *  You may obtain a copy of the License at:
+ *  http://www.apache.org/licenses/LICENSE-2.0 \n
+ *  Unless required by applicable law or agreed to in writing, software\n
+ *  distributed under the License is distributed on an "AS IS" BASIS,\n
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.\n
+ *  See the License for the specific language governing permissions and\n
+ *  limitations under the License.
+ *
+ * @addtogroup Assets
+ **/
+/// @{
+
+#ifndef ASSETS__TEXTURE_ATLAS_HPP
+#define ASSETS__TEXTURE_ATLAS_HPP
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <algorithm>
+
+#include "Helpers.hpp"
+#include "Graphics/Graphics.hpp"
+#include "Assets/AssetManager.hpp"
+#include "Assets/Texture.hpp"
+
+namespace asset
+{
+    /// Extension for atlas index files (@a Collapse Atlas Index)
+    static const char ATLAS_INDEX_EXT[] = {".cai"};
+
+    /// Extension for atlas page files (@a Collapse Atlas Page)
+    static const char ATLAS_PAGE_EXT[]  = {".cap"};
+
+    /**
+     * Packs many small images into a few large textures.
+     *  Every image is placed on a square page with a border of padding
+     *  around it. The padding is filled with the image's edge pixels,
+     *  so linear filtering never bleeds in a neighbouring image.
+     *  Once uploaded, every packed image is registered with the
+     *  asset::CAssetManager as a asset::CTexture that refers to its
+     *  page and UV window, so it's picked up by anything that creates
+     *  a texture with that filename.
+     *
+     *  A packed atlas can be saved and loaded back on later runs,
+     *  which skips loading and packing the source images altogether.
+     *  Images too big to fit on a page are left out, and load the
+     *  usual way.
+     **/
+    class CTextureAtlas
+    {
+    public:
+        CTextureAtlas();
+        ~CTextureAtlas();
+
+        bool AddFile(const char* pfilename);
+        bool AddList(const char* plistname);
+
+        bool Pack(const u_int page_size = 1024, const u_int padding = 2);
+        bool Save(const char* pprefix) const;
+        bool Load(const char* pprefix);
+        bool Upload();
+
+        u_int GetPageCount() const;
+
+    private:
+        CTextureAtlas(const CTextureAtlas&);
+        CTextureAtlas& operator= (const CTextureAtlas&);
+
+        struct Entry
+        {
+            std::string filename;
+            u_int       file_size;  // To tell if a saved atlas is stale
+            int         page;       // -1 if it isn't on a page
+            math::CRect Region;     // Image location on its page
+        };
+
+        void ClearPages();
+
+        static u_int GetFileSize(const char* pfilename);
+        static void CopyImage(SDL_Surface* pSrc, SDL_Surface* pPage,
+            const int x, const int y, const int padding);
+        static bool CompareHeight(const std::pair<int, SDL_Surface*>& One,
+            const std::pair<int, SDL_Surface*>& Two);
+
+        std::vector<Entry>          m_Entries;
+        std::vector<SDL_Surface*>   mp_allPages;
+        std::vector<GLuint>         m_textures;
+        u_int                       m_page_size;
+    };
+}
+
+#endif // ASSETS__TEXTURE_ATLAS_HPP
+
+/// @}
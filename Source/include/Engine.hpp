@@ -44,6 +44,7 @@
 #include "Graphics/Shader.hpp"
 #include "Assets/AssetManager.hpp"
 #include "Assets/Texture.hpp"
+#include "Assets/TextureAtlas.hpp"
 #include "Assets/Sound2D.hpp"
 #include "Assets/Font.hpp"
 #include "Menus/MenuManager.hpp"
@@ -91,6 +92,7 @@ namespace game
         asset::CSound2D*    mp_IntroSong;
         asset::CFont*       mp_IntroFont;
         asset::CMusicPlayer m_MusicPlayer;
+        asset::CTextureAtlas m_Atlas;
 
         obj::CEntity        m_IngameCursor;
         obj::CEntity        m_Splash;
@@ -0,0 +1,80 @@
+/**
+ * @file
+ *  Declarations for the CCompositor class.
+ *
+ * @author      George Kudrayvtsev (switch1440)
+ * @version     1.0
+ * @copyright   Apache License v2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License").\n
+ *  You may not use this file except in compliance with the License.\n
+ *  You may obtain a copy of the License at:
+ *  http://www.apache.org/licenses/LICENSE-2.0 \n
+ *  Unless required by applicable law or agreed to in writing, software\n
+ *  distributed under the License is distributed on an "AS IS" BASIS,\n
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.\n
+ *  See the License for the specific language governing permissions and\n
+ *  limitations under the License.
+ *
+ * @addtogroup Graphics
+ **/
+/// @{
+
+#ifndef GRAPHICS__COMPOSITOR_HPP
+#define GRAPHICS__COMPOSITOR_HPP
+
+#include "Graphics/Graphics.hpp"
+#include "Graphics/Shader.hpp"
+#include "Graphics/RenderTarget.hpp"
+#include "Graphics/GPUTimer.hpp"
+
+namespace gfx
+{
+    /**
+     * Builds a frame out of offscreen passes.
+     *  The scene is drawn unlit into a target first, however many
+     *  times sprites overlap. Lighting is then done in a single pass
+     *  over it, so every pixel on the screen is lit exactly once.
+     *  Post effects run after that, each reading the last one's
+     *  result and writing into the other of a pair of targets.
+     *
+     *  A frame is BeginScene(), Light(), then Present(). Anything
+     *  drawn between Light() and Present() is added unlit, on top.
+     **/
+    class CCompositor
+    {
+    public:
+        /// Parts of a frame, timed on the GPU.
+        enum Pass
+        {
+            e_PASS_SCENE,
+            e_PASS_LIGHTING,
+            e_PASS_POST,
+            e_PASS_COUNT
+        };
+
+        CCompositor();
+        ~CCompositor();
+
+        bool Init(const u_int w, const u_int h);
+
+        void AddEffect(gfx::CShader* pEffect);
+
+        void BeginScene();
+        void Light(gfx::CShader& Lighting);
+        void Present();
+
+        float GetPassTime(const Pass pass) const;
+
+    private:
+        std::vector<gfx::CShader*>  mp_allEffects;
+
+        gfx::CRenderTarget  m_Scene;
+        gfx::CRenderTarget  m_Post[2];
+        gfx::CGPUTimer      m_Timers[e_PASS_COUNT];
+        u_int               m_current;  // Post target holding the result
+    };
+}
+
+#endif // GRAPHICS__COMPOSITOR_HPP
+
+/// @}
@@ -0,0 +1,63 @@
+/**
+ * @file
+ *  Declarations for the CGPUTimer class.
+ *
+ * @author      George Kudrayvtsev (switch1440)
+ * @version     1.0
+ * @copyright   Apache License v2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License").\n
+ *  You may not use this file except in compliance with the License.\n
+ *  You may obtain a copy of the License at:
+ *  http://www.apache.org/licenses/LICENSE-2.0 \n
+ *  Unless required by applicable law or agreed to in writing, software\n
+ *  distributed under the License is distributed on an "AS IS" BASIS,\n
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.\n
+ *  See the License for the specific language governing permissions and\n
+ *  limitations under the License.
+ *
+ * @addtogroup Graphics
+ **/
+/// @{
+
+#ifndef GRAPHICS__GPU_TIMER_HPP
+#define GRAPHICS__GPU_TIMER_HPP
+
+#include "Graphics/Graphics.hpp"
+
+namespace gfx
+{
+    /// Frames a GPU timer can fall behind before it has to wait.
+    static const u_int GPU_TIMER_FRAMES = 3;
+
+    /**
+     * Measures how long the GPU spends on a part of a frame.
+     *  The GPU runs a frame or two behind, so results are read a
+     *  few frames late rather than waiting for them. Only one timer
+     *  can be running at once.
+     *
+     *  Without timer queries (or a window), every time is 0.
+     **/
+    class CGPUTimer
+    {
+    public:
+        CGPUTimer();
+        ~CGPUTimer();
+
+        void Begin();
+        void End();
+
+        float GetTime() const;
+
+    private:
+        void Collect();
+
+        GLuint  m_queries[GPU_TIMER_FRAMES];
+        bool    m_pending[GPU_TIMER_FRAMES];
+        u_int   m_current;
+        float   m_time;
+    };
+}
+
+#endif // GRAPHICS__GPU_TIMER_HPP
+
+/// @}
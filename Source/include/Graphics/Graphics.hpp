@@ -75,6 +75,9 @@ namespace gfx
     static const Color YELLOW   = {255, 255, 0,     0};
     static const Color PURPLE   = {255, 0,   255,   0};
 
+    void set_headless(const bool headless);
+    bool is_headless();
+
     u_int SDL_Surface_to_texture(SDL_Surface* pSrc);
     u_int load_texture(const char* pfilename);
     u_int load_texture_alpha(const char* pfilename);
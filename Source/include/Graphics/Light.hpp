@@ -27,6 +27,12 @@
 
 namespace gfx
 {
+    /// Dimmest a light gets before it's treated as having no effect.
+    static const float LIGHT_CUTOFF = 1.0f / 64.0f;
+
+    /// Radius of a light whose attenuation never falls off.
+    static const float LIGHT_INFINITE_RADIUS = 1e6f;
+
     class CLight
     {
     public:
@@ -48,6 +54,7 @@ namespace gfx
         float* GetAttenuation();
         float* GetColor();
         float  GetBrightness();
+        float  GetRadius() const;
 
     private:
         float m_position[2];
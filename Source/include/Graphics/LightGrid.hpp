@@ -0,0 +1,92 @@
+/**
+ * @file
+ *  Declarations for the CLightGrid class.
+ *
+ * @author      George Kudrayvtsev (switch1440)
+ * @version     1.0
+ * @copyright   Apache License v2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License").\n
+ *  You may not use this file except in compliance with the License.\n
+ *  You may obtain a copy of the License at:
+ *  http://www.apache.org/licenses/LICENSE-2.0 \n
+ *  Unless required by applicable law or agreed to in writing, software\n
+ *  distributed under the License is distributed on an "AS IS" BASIS,\n
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.\n
+ *  See the License for the specific language governing permissions and\n
+ *  limitations under the License.
+ *
+ * @addtogroup Graphics
+ **/
+/// @{
+
+#ifndef GRAPHICS__LIGHT_GRID_HPP
+#define GRAPHICS__LIGHT_GRID_HPP
+
+#include "Math/Math.hpp"
+#include "Graphics/Graphics.hpp"
+#include "Graphics/Light.hpp"
+#include "Graphics/Shader.hpp"
+
+namespace gfx
+{
+    /// Width and height of a light tile, in pixels.
+    static const u_int LIGHT_TILE_SIZE      = 32;
+
+    /// Most lights that can touch a single tile.
+    static const u_int MAX_TILE_LIGHTS      = 16;
+
+    /// Most lights that can be on the screen at once.
+    static const u_int MAX_VISIBLE_LIGHTS   = 128;
+
+    /**
+     * Sorts lights into screen tiles for the lighting shader.
+     *  Every frame, the lights that reach into the view are picked
+     *  out and passed to the shader, and each tile of the screen
+     *  gets a list of the ones that reach it. The lists are uploaded
+     *  as a texture, so each pixel only looks at the lights touching
+     *  its tile, no matter how many lights the level has.
+     *
+     *  If a tile is reached by more than MAX_TILE_LIGHTS lights, the
+     *  extra ones are left out of it.
+     **/
+    class CLightGrid
+    {
+    public:
+        CLightGrid();
+        ~CLightGrid();
+
+        bool Init(gfx::CShader& Shader, const u_int screen_w,
+            const u_int screen_h);
+
+        void Update(const std::vector<gfx::CLight*>& allLights,
+            const math::CVector2& Offset, gfx::CShader& Shader);
+
+        u_int GetVisibleCount() const;
+
+    private:
+        void AddToTiles(const u_int index, const float x, const float y,
+            const float radius);
+
+        // Visible lights, in the layout the shader wants them.
+        std::vector<float>          m_Positions;
+        std::vector<float>          m_Colors;
+        std::vector<float>          m_Attenuations;
+        std::vector<float>          m_Brightnesses;
+        std::vector<float>          m_Radii;
+
+        std::vector<unsigned char>  m_Tiles;        // Light index + 1, per slot
+        std::vector<unsigned char>  m_Uploaded;     // What the texture holds
+        std::vector<unsigned char>  m_TileCounts;   // Slots used in each tile
+
+        gfx::UniformHandle  m_LightPos, m_LightCol, m_LightAtt,
+                            m_LightBrt, m_LightRad;
+
+        GLuint  m_texture;
+        u_int   m_tiles_x, m_tiles_y;
+        u_int   m_screen_w, m_screen_h;
+    };
+}
+
+#endif // GRAPHICS__LIGHT_GRID_HPP
+
+/// @}
@@ -0,0 +1,110 @@
+/**
+ * @file
+ *  Declarations for the CLightmap class.
+ *
+ * @author      George Kudrayvtsev (switch1440)
+ * @version     1.0
+ * @copyright   Apache License v2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License").\n
+ *  You may not use this file except in compliance with the License.\n
+ *  You may obtain a copy of the License at:
+ *  http://www.apache.org/licenses/LICENSE-2.0 \n
+ *  Unless required by applicable law or agreed to in writing, software\n
+ *  distributed under the License is distributed on an "AS IS" BASIS,\n
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.\n
+ *  See the License for the specific language governing permissions and\n
+ *  limitations under the License.
+ *
+ * @addtogroup Graphics
+ **/
+/// @{
+
+#ifndef GRAPHICS__LIGHTMAP_HPP
+#define GRAPHICS__LIGHTMAP_HPP
+
+#include "Helpers.hpp"
+#include "JobSystem.hpp"
+
+#include "Math/Math.hpp"
+#include "Graphics/Graphics.hpp"
+#include "Graphics/Light.hpp"
+#include "Graphics/Shader.hpp"
+
+namespace gfx
+{
+    /// World pixels covered by a lightmap texel, at most.
+    static const u_int LIGHTMAP_TEXEL       = 8;
+
+    /// Widest (and tallest) a lightmap gets, in texels.
+    static const u_int MAX_LIGHTMAP_SIZE    = 2048;
+
+    /// Brightest light a texel can hold, it's stored as [0, 1].
+    static const float LIGHTMAP_RANGE       = 2.0f;
+
+    /// Lightmaps are kept next to the level they were baked for.
+    static const char  LIGHTMAP_EXT[]       = {".clm"};
+
+    /**
+     * Lighting from lights that never move, baked into a texture.
+     *  Every texel holds the light summed up at its center, the same
+     *  way the lighting shader would, at a fraction of the screen's
+     *  resolution. The shader samples it with bilinear filtering, so
+     *  only lights that move need to be done per-pixel.
+     *
+     *  Baking is done on the job threads. The result can be saved,
+     *  and is only loaded back if it was baked from the same lights,
+     *  level size, and level maps.
+     **/
+    class CLightmap
+    {
+    public:
+        CLightmap();
+        ~CLightmap();
+
+        void Bake(const std::vector<gfx::CLight*>& allLights,
+            const math::CRect& Bounds, const unsigned long long level_key);
+
+        bool LoadFromFile(const char* pfilename,
+            const std::vector<gfx::CLight*>& allLights,
+            const math::CRect& Bounds, const unsigned long long level_key);
+        bool SaveToFile(const char* pfilename) const;
+
+        void Init(gfx::CShader& Shader);
+        void Update(gfx::CShader& Shader);
+
+        u_int GetW() const;
+        u_int GetH() const;
+
+    private:
+        /// A light, as it's needed to bake it.
+        struct BakedLight
+        {
+            float x, y;
+            float color[3];
+            float attenuation[3];
+            float radius;
+        };
+
+        void Prepare(const std::vector<gfx::CLight*>& allLights,
+            const math::CRect& Bounds, const unsigned long long level_key);
+        void Upload();
+
+        static void BakeRows(void* pData, const u_int begin,
+            const u_int end);
+
+        std::vector<BakedLight>     m_Lights;
+        std::vector<unsigned char>  m_texels;   // RGB, top row first
+
+        gfx::UniformHandle  m_Rect;
+
+        GLuint      m_texture;
+        math::CRect m_Bounds;       // World pixels covered
+        u_int       m_w, m_h;       // Size, in texels
+        u_int       m_texel;        // World pixels per texel
+        unsigned long long m_key;   // Hash of everything baked from
+    };
+}
+
+#endif // GRAPHICS__LIGHTMAP_HPP
+
+/// @}
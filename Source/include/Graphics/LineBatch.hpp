@@ -0,0 +1,65 @@
+/**
+ * @file
+ *  Declarations for the CLineBatch class.
+ *
+ * @author      George Kudrayvtsev (switch1440)
+ * @version     1.0
+ * @copyright   Apache License v2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License").\n
+ *  You may not use this file except in compliance with the License.\n
+ *  You may obtain a copy of the License at:
+ *  http://www.apache.org/licenses/LICENSE-2.0 \n
+ *  Unless required by applicable law or agreed to in writing, software\n
+ *  distributed under the License is distributed on an "AS IS" BASIS,\n
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.\n
+ *  See the License for the specific language governing permissions and\n
+ *  limitations under the License.
+ *
+ * @addtogroup Graphics
+ **/
+/// @{
+
+#ifndef GRAPHICS__LINE_BATCH_HPP
+#define GRAPHICS__LINE_BATCH_HPP
+
+#include <vector>
+
+#include "Math/Math.hpp"
+#include "Graphics/Graphics.hpp"
+
+namespace gfx
+{
+    /**
+     * Collects colored lines and draws them all with a single call.
+     *  Meant for debug overlays, such as collision boxes, which are
+     *  drawn untextured on top of everything else. Like
+     *  gfx::CSpriteBatch, the current matrix is used as-is.
+     **/
+    class CLineBatch
+    {
+    public:
+        CLineBatch();
+        ~CLineBatch();
+
+        void Begin();
+        void DrawLine(const float x1, const float y1,
+            const float x2, const float y2, const gfx::Color& Color);
+        void DrawRect(const math::CRect& Rect, const gfx::Color& Color);
+        void End();
+
+        u_int GetLineCount() const;
+
+    private:
+        struct Vertex
+        {
+            float x, y;
+            unsigned char r, g, b, a;
+        };
+
+        std::vector<Vertex> m_Vertices;
+    };
+}
+
+#endif // GRAPHICS__LINE_BATCH_HPP
+
+/// @}
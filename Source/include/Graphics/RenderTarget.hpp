@@ -0,0 +1,65 @@
+/**
+ * @file
+ *  Declarations for the CRenderTarget class.
+ *
+ * @author      George Kudrayvtsev (switch1440)
+ * @version     1.0
+ * @copyright   Apache License v2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License").\n
+ *  You may not use this file except in compliance with the License.\n
+ *  You may obtain a copy of the License at:
+ *  http://www.apache.org/licenses/LICENSE-2.0 \n
+ *  Unless required by applicable law or agreed to in writing, software\n
+ *  distributed under the License is distributed on an "AS IS" BASIS,\n
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.\n
+ *  See the License for the specific language governing permissions and\n
+ *  limitations under the License.
+ *
+ * @addtogroup Graphics
+ **/
+/// @{
+
+#ifndef GRAPHICS__RENDER_TARGET_HPP
+#define GRAPHICS__RENDER_TARGET_HPP
+
+#include "Graphics/Graphics.hpp"
+
+namespace gfx
+{
+    /**
+     * An offscreen framebuffer, drawn into instead of the window.
+     *  What's drawn ends up in a texture, which can then be drawn
+     *  over the screen (or another target) with any shader.
+     *
+     *  Targets use the same coordinates as the window, so nothing
+     *  needs to change to draw into one.
+     **/
+    class CRenderTarget
+    {
+    public:
+        CRenderTarget();
+        ~CRenderTarget();
+
+        bool Create(const u_int w, const u_int h);
+
+        void Bind() const;
+        static void BindScreen();
+
+        void Draw() const;
+
+        GLuint GetTexture() const;
+        u_int  GetW() const;
+        u_int  GetH() const;
+
+    private:
+        void Release();
+
+        GLuint  m_framebuffer;
+        GLuint  m_texture;
+        u_int   m_w, m_h;
+    };
+}
+
+#endif // GRAPHICS__RENDER_TARGET_HPP
+
+/// @}
@@ -28,20 +28,36 @@
 
 namespace gfx
 {
-    template<typename T>
-    struct ShaderParam
-    {
-        T*      m_pparams;      // The parameters to pass to the shader
-        u_int   m_array_size;   // The size of each parameter
-        u_int   m_array_count;  // The amount of parameters
-    };
-
+    /// Refers to a uniform of a certain gfx::CShader, from Find().
+    typedef int UniformHandle;
+
+    /// A handle that doesn't refer to any uniform.
+    static const UniformHandle INVALID_UNIFORM = -1;
+
+    /// Where linked program binaries are kept between runs.
+    static const char SHADER_CACHE_DIR[] = "Data/Shaders/Cache";
+
+    /**
+     * A GLSL vertex and fragment shader program.
+     *  Sources are preprocessed in memory: #include "file" lines are
+     *  pulled in when loading, and macros from SetMacro() are written
+     *  in before compiling. Linked programs are shared between every
+     *  shader built from the same source and macros, and are saved to
+     *  disk where the driver supports GL_ARB_get_program_binary.
+     *
+     *  Uniforms are kept in a table, along with their location in the
+     *  program and their last value. Setting a uniform only marks it
+     *  as changed, and Link() uploads just the ones that changed
+     *  since the last time.
+     **/
     class CShader
     {
     public:
         CShader();
         ~CShader();
 
+        static void ClearCache();
+
         bool LoadFromFile(const char* pvs_filename, 
             const char* pfs_filename);
         bool LoadFromSource(const char* pvs_src, const char* pfs_src);
@@ -49,9 +65,16 @@ namespace gfx
         template<typename T>
         bool SetMacro(const char* pmacro_name, const T value);
 
-        void PassVariableiv(const char* pvar_name, int pvalues[],
+        UniformHandle Find(const char* pvar_name);
+
+        void SetUniform(const UniformHandle handle, const int pvalues[],
+            const u_int array_size, const u_int array_count);
+        void SetUniform(const UniformHandle handle, const float pvalues[],
+            const u_int array_size, const u_int array_count);
+
+        void PassVariableiv(const char* pvar_name, const int pvalues[],
             u_int array_size, u_int array_count);
-        void PassVariablefv(const char* pvar_name, float pvalues[],
+        void PassVariablefv(const char* pvar_name, const float pvalues[],
             u_int array_size, u_int array_count);
 
         bool Link();
@@ -59,76 +82,96 @@ namespace gfx
 
         bool  IsLoaded() const;
         int   GetLocation(const char* pvar_name) const;
-        char* GetError() const;
+        const char* GetError() const;
 
     private:
-        GLuint  LoadShaderFile(const char* pfilename, const int shader_type);
-        GLuint  LoadShaderSource(const char* psrc, const int shader_type);
+        typedef unsigned long long program_key;
 
-        typedef std::map<char*, ShaderParam<int>*>::iterator    ShaderI_It;
-        typedef std::map<char*, ShaderParam<float>*>::iterator  ShaderF_It;
+        /// A linked program, shared by every shader built the same way.
+        struct Program
+        {
+            GLuint          program;
+            const CShader*  pUser;      // Last shader to upload uniforms
+        };
+
+        typedef std::map<program_key, Program> ProgramCache;
+
+        bool SetDefine(const std::string& name, const std::string& value);
+        bool Build();
+
+        bool ReadSource(const std::string& filename, std::string& source,
+            const u_int depth = 0);
+        std::string Preprocess(const std::string& source) const;
 
-        std::map<char*, ShaderParam<int>*>      m_iParams;
-        std::map<char*, ShaderParam<float>*>    m_fParams;
+        GLuint  CompileShader(const std::string& source,
+            const int shader_type, const std::string& name);
+        GLuint  LinkProgram(const std::string& vs_src,
+            const std::string& fs_src);
+
+        static GLuint LoadProgramBinary(const program_key key);
+        static void   SaveProgramBinary(const program_key key,
+            const GLuint program);
+
+        /// A single uniform value, ints and floats share the storage.
+        union UniformValue
+        {
+            int     i;
+            float   f;
+        };
+
+        struct Uniform
+        {
+            std::string name;
+            GLint       location;       // -1 if not in the program
+            GLenum      type;           // GL_INT or GL_FLOAT
+            u_int       array_size;     // The size of each value
+            u_int       array_count;    // The amount of values
+            u_int       offset;         // Start of the values in m_Values
+            u_int       capacity;       // Room for values at the offset
+            bool        dirty;          // Changed since the last upload
+        };
+
+        UniformValue* Reserve(const UniformHandle handle,
+            const GLenum type, const u_int array_size,
+            const u_int array_count);
+
+        void ResolveUniforms();
+        void UploadUniform(const Uniform& Current) const;
+
+        static ProgramCache m_Programs;
+
+        std::vector<Uniform>        m_Uniforms;
+        std::vector<UniformValue>   m_Values;   // Every uniform's values
+
+        std::map<std::string, std::string>  m_Defines;
 
         std::string m_vsfn, m_fsfn;
+        std::string m_vs_src, m_fs_src;         // With includes pulled in
+        std::string m_error;
 
-        GLuint  m_vshader, m_fshader;
-        GLuint  m_program;
-        GLint   m_last_error;
-        GLchar* mp_error_str;
+        Program*    mp_Program;
+        GLuint      m_program;
+        GLint       m_last_error;
     };
 
+    /**
+     * Defines a macro in both shaders and rebuilds the program.
+     *  Any #define of the same macro in the sources is replaced.
+     *  Nothing is written to disk, and a program that was built with
+     *  the same macros before is reused.
+     *
+     * @param char* Macro name
+     * @param T Macro value, anything that can be streamed
+     *
+     * @return TRUE if the program was rebuilt, FALSE otherwise.
+     * @pre The shader has been loaded.
+     **/
     template<typename T>
     bool CShader::SetMacro(const char* pmacro_name, const T value)
     {
-        std::stringstream   all_data;
-        std::fstream        vshader;
-        std::fstream        fshader;
-        std::string         line;
-
-        if(!this->IsLoaded())
-            return false;
-
-        vshader.open(m_vsfn, std::ios::in);
-        fshader.open(m_fsfn, std::ios::in);
-
-        // Read in the vertex shader's existing data.
-        // Repeat process for fragment shader.
-        std::string finder = "#define ";
-        finder += pmacro_name;
-
-        while(std::getline(vshader, line))
-        {
-            if(line.find(finder) == std::string::npos)
-                all_data << line << '\n';
-        }
-
-        // Write the macro at the beginning
-        vshader.close();
-        vshader.open(m_vsfn, std::ios::out | std::ios::trunc);
-        vshader << "#define " << pmacro_name << ' ' << value << "\n";
-        vshader << all_data.str();
-        vshader.close();
-
-        // Clear stringstream
-        all_data.str(std::string());
-
-        // Repeat process for fragment shader.
-        while(std::getline(fshader, line))
-        {
-            if(line.find(finder) == std::string::npos)
-                all_data << line << '\n';
-        }
-
-        fshader.close();
-        fshader.open(m_fsfn, std::ios::out | std::ios::trunc);
-        fshader << "#define " << pmacro_name << ' ' << value << "\n";
-        fshader << all_data.str();
-        fshader.close();
-
-        // Reload the OpenGL shader programs
-        return this->LoadFromFile(m_vsfn.c_str(), m_fsfn.c_str());
+        std::stringstream text;
+        text << value;
+        return this->SetDefine(pmacro_name, text.str());
     }
 }
 
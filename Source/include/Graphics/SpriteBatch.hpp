@@ -0,0 +1,116 @@
+/**
+ * @file
+ *  Declarations for the CSpriteBatch class.
+ *
+ * @author      George Kudrayvtsev (switch1440)
+ * @version     1.0
+ * @copyright   Apache License v2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License").\n
+ *  You may not use this file except in compliance with the License.\n
+ *  You may obtain a copy of the License at:
+ *  http://www.apache.org/licenses/LICENSE-2.0 \n
+ *  Unless required by applicable law or agreed to in writing, software\n
+ *  distributed under the License is distributed on an "AS IS" BASIS,\n
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.\n
+ *  See the License for the specific language governing permissions and\n
+ *  limitations under the License.
+ *
+ * @addtogroup Graphics
+ **/
+/// @{
+
+#ifndef GRAPHICS__SPRITE_BATCH_HPP
+#define GRAPHICS__SPRITE_BATCH_HPP
+
+#include <vector>
+#include <algorithm>
+
+#include "Math/Math.hpp"
+#include "Graphics/Graphics.hpp"
+
+namespace gfx
+{
+    /**
+     * Collects textured quads and draws them with as few calls as possible.
+     *  Sprites are queued up between Begin() and End(). On End(), they're
+     *  (optionally) sorted by texture, written to a client-side vertex
+     *  array, and drawn with one glDrawArrays() call per run of sprites
+     *  sharing a texture. Rotation is done on the CPU, so the current
+     *  matrix (the camera, usually) is left alone.
+     *
+     *  While a batch is between Begin() and End(), it's the active batch
+     *  and obj::CEntity::Draw() queues into it rather than drawing
+     *  right away. A batch can also be built once and drawn every frame
+     *  with Render(), for sprites that never move.
+     **/
+    class CSpriteBatch
+    {
+    public:
+        /// How sprites are ordered before drawing.
+        enum SortMode
+        {
+            e_SORT_NONE,    // Submission order, only merges neighbours
+            e_SORT_TEXTURE  // Grouped by texture, for non-overlapping sprites
+        };
+
+        CSpriteBatch();
+        ~CSpriteBatch();
+
+        void Begin(const SortMode mode = e_SORT_TEXTURE);
+        void Draw(const u_int texture, const math::CRectf& Dest,
+            const math::CRectf& TexCoords, const float angle = 0.0f);
+        void End(const bool draw = true);
+        void Render();
+
+        bool  IsActive() const;
+        u_int GetDrawCallCount() const;
+        u_int GetSpriteCount() const;
+
+        static CSpriteBatch* GetActive();
+        static u_int GetTotalDrawCalls();
+        static void  ResetTotalDrawCalls();
+
+    private:
+        CSpriteBatch(const CSpriteBatch&);
+        CSpriteBatch& operator= (const CSpriteBatch&);
+
+        struct Vertex
+        {
+            float x, y;
+            float u, v;
+        };
+
+        struct Sprite
+        {
+            u_int   texture;
+            Vertex  corners[4];
+        };
+
+        // Sprites [first, first + count) sharing a texture.
+        struct Run
+        {
+            u_int   texture;
+            u_int   first;
+            u_int   count;
+        };
+
+        static bool CompareTexture(const Sprite& One, const Sprite& Two);
+
+        std::vector<Sprite> m_Sprites;
+        std::vector<Vertex> m_Vertices;
+        std::vector<Run>    m_Runs;
+        CSpriteBatch*       mp_Previous;    // Active batch before Begin()
+
+        SortMode    m_mode;
+        bool        m_active;
+        u_int       m_draw_calls;
+        u_int       m_sprite_count;
+
+        static CSpriteBatch*    mp_Active;
+        static u_int            m_total_draw_calls;
+    };
+}
+
+#endif // GRAPHICS__SPRITE_BATCH_HPP
+
+/// @}
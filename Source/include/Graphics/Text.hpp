@@ -0,0 +1,78 @@
+/**
+ * @file
+ *  Declarations for the CText class.
+ *
+ * @author      George Kudrayvtsev (switch1440)
+ * @version     1.0
+ * @copyright   Apache License v2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License").\n
+ *  You may not use this file except in compliance with the License.\n
+ *  You may obtain a copy of the License at:
+ *  http://www.apache.org/licenses/LICENSE-2.0 \n
+ *  Unless required by applicable law or agreed to in writing, software\n
+ *  distributed under the License is distributed on an "AS IS" BASIS,\n
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.\n
+ *  See the License for the specific language governing permissions and\n
+ *  limitations under the License.
+ *
+ * @addtogroup Graphics
+ **/
+/// @{
+
+#ifndef GRAPHICS__TEXT_HPP
+#define GRAPHICS__TEXT_HPP
+
+#include <string>
+
+#include "Math/Math.hpp"
+#include "Graphics/Graphics.hpp"
+#include "Graphics/SpriteBatch.hpp"
+#include "Assets/Font.hpp"
+
+namespace gfx
+{
+    /**
+     * A piece of text drawn from a font's glyph atlas.
+     *  The text is laid out into a quad per character once, and only
+     *  laid out again when the string, font or size changes, so setting
+     *  the same text every frame is nearly free. The whole string is a
+     *  single draw call.
+     *
+     * @see asset::CFont::GetGlyphs()
+     **/
+    class CText
+    {
+    public:
+        CText();
+        ~CText();
+
+        bool SetFont(asset::CFont* pFont, const u_int size);
+        void SetText(const std::string& text);
+        void SetColor(const gfx::Color& Text_Color);
+
+        void Move(const float x, const float y);
+        void Update();
+
+        const std::string& GetText() const;
+        int GetW() const;
+        int GetH() const;
+
+    private:
+        CText(const CText&);
+        CText& operator= (const CText&);
+
+        void Layout();
+
+        gfx::CSpriteBatch           m_Mesh;
+        const asset::CGlyphAtlas*   mp_Glyphs;
+        std::string                 m_text;
+        math::CVector2              m_Position;
+        gfx::Color                  m_Color;
+        int                         m_width, m_height;
+        bool                        m_dirty;
+    };
+}
+
+#endif // GRAPHICS__TEXT_HPP
+
+/// @}
@@ -21,6 +21,9 @@
  **/
 /// @{
 
+#ifndef HELPERS_HPP
+#define HELPERS_HPP
+
 #include <string>
 #include <sstream>
 #include <vector>
@@ -37,6 +40,14 @@ namespace gk
     std::string combine(const std::string& str1, const char* str2);
     std::string combine(const char* str2, const std::string& str1);
     std::vector<std::string> split(const std::string& str, char token);
+
+    /// Starting value for gk::hash().
+    static const unsigned long long HASH_SEED = 14695981039346656037ULL;
+
+    unsigned long long hash(const void* pdata, const size_t size,
+        const unsigned long long seed = HASH_SEED);
 }
 
+#endif // HELPERS_HPP
+
 /// @}
\ No newline at end of file
@@ -24,6 +24,7 @@
 
 #include "CollapseDef.hpp"
 #include "SystemEvents.hpp"
+#include "Graphics/Text.hpp"
 #include "Assets/Font.hpp"
 #include "Assets/AssetManager.hpp"
 #include "World/Objects/Entity.hpp"
@@ -46,12 +47,12 @@ namespace game
     private:
         obj::CEntity    m_Background;
         obj::CEntity    m_LargePlayerIMG;
-        obj::CEntity*   mp_Weapon1Stats;
-        obj::CEntity*   mp_Weapon2Stats;
-        obj::CEntity*   mp_PlayerStats;
-        obj::CEntity*   mp_PlayerHealth;
-        obj::CEntity*   mp_TowerHealth;
-        obj::CEntity*   mp_TankHealth;
+        gfx::CText      m_Weapon1Stats;
+        gfx::CText      m_Weapon2Stats;
+        gfx::CText      m_PlayerStats;
+        gfx::CText      m_PlayerHealth;
+        gfx::CText      m_TowerHealth;
+        gfx::CText      m_TankHealth;
         obj::CPlayer&   m_Player;
         asset::CFont*   mp_Font;
     };
@@ -0,0 +1,115 @@
+/**
+ * @file
+ *  Declarations for the CJobSystem class.
+ *
+ * @author      George Kudrayvtsev (switch1440)
+ * @version     1.0
+ * @copyright   Apache License v2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License").\n
+ *  You may not use this file except in compliance with the License.\n
+ *  You may obtain a copy of the License at:
+ *  http://www.apache.org/licenses/LICENSE-2.0 \n
+ *  Unless required by applicable law or agreed to in writing, software\n
+ *  distributed under the License is distributed on an "AS IS" BASIS,\n
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.\n
+ *  See the License for the specific language governing permissions and\n
+ *  limitations under the License.
+ *
+ * @addtogroup Game
+ **/
+/// @{
+
+#ifndef JOB_SYSTEM_HPP
+#define JOB_SYSTEM_HPP
+
+#include <deque>
+#include <vector>
+
+#include "SDL/SDL_thread.h"
+#include "SDL/SDL_mutex.h"
+
+#include "CollapseDef.hpp"
+
+namespace game
+{
+    /**
+     * A function run over part of a parallel loop.
+     *
+     * @param void* User data given to CJobSystem::ParallelFor()
+     * @param u_int First index to process
+     * @param u_int One past the last index to process
+     **/
+    typedef void (*JobFunc)(void* pData, const u_int begin, const u_int end);
+
+    /**
+     * Spreads loops over a pool of worker threads.
+     *  Every thread, including the one calling ParallelFor(), has its
+     *  own queue of jobs. Threads take jobs from the back of their own
+     *  queue, and once it's empty they steal from the front of the
+     *  others', so an uneven split evens itself out.
+     *
+     *  If no worker threads are running, loops are run in one go on
+     *  the calling thread.
+     **/
+    class CJobSystem
+    {
+    public:
+        ~CJobSystem();
+
+        static CJobSystem& GetInstance();
+        static u_int GetCoreCount();
+
+        bool Init(const u_int thread_count);
+        void Shutdown();
+
+        void ParallelFor(const u_int count, const u_int grain,
+            JobFunc func, void* pData);
+
+        u_int GetWorkerCount() const;
+
+    private:
+        CJobSystem();
+        CJobSystem(const CJobSystem&);
+        CJobSystem& operator= (const CJobSystem&);
+
+        struct Job
+        {
+            JobFunc func;
+            void*   pData;
+            u_int   begin, end;
+        };
+
+        struct JobQueue
+        {
+            SDL_mutex*      pLock;
+            std::deque<Job> Jobs;
+        };
+
+        struct Worker
+        {
+            CJobSystem* pSystem;
+            u_int       index;      // Queue owned by this worker
+        };
+
+        static int WorkerThread(void* pData);
+
+        bool TakeJob(const u_int index, Job& Next);
+        void RunJob(const Job& Current);
+
+        std::vector<SDL_Thread*>    mp_allThreads;
+        std::vector<JobQueue*>      mp_allQueues;   // 0 is the caller's
+        std::vector<Worker>         m_Workers;
+
+        SDL_mutex*  mp_Lock;
+        SDL_cond*   mp_WorkReady;
+        SDL_cond*   mp_AllDone;
+
+        int     m_queued;       // Jobs not yet taken by a thread
+        int     m_unfinished;   // Jobs not yet finished
+        bool    m_running;
+    };
+}
+
+#endif // JOB_SYSTEM_HPP
+
+/// @}
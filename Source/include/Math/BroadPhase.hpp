@@ -0,0 +1,84 @@
+/**
+ * @file
+ *  Declarations for the CBroadPhase class.
+ *
+ * @author      George Kudrayvtsev (switch1440)
+ * @version     1.0
+ * @copyright   Apache License v2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License").\n
+ *  You may not use this file except in compliance with the License.\n
+ *  You may obtain a copy of the License at:
+ *  http://www.apache.org/licenses/LICENSE-2.0 \n
+ *  Unless required by applicable law or agreed to in writing, software\n
+ *  distributed under the License is distributed on an "AS IS" BASIS,\n
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.\n
+ *  See the License for the specific language governing permissions and\n
+ *  limitations under the License.
+ *
+ * @addtogroup Math
+ **/
+/// @{
+
+#ifndef MATH__BROAD_PHASE_HPP
+#define MATH__BROAD_PHASE_HPP
+
+#include <vector>
+#include <algorithm>
+
+#include "Math/MathDef.hpp"
+#include "Math/Shapes.hpp"
+
+namespace math
+{
+    /**
+     * Finds which boxes might be touching, without testing every pair.
+     *  Boxes are added every frame, each on a layer (a single bit) and
+     *  with a mask of the layers it cares about. FindPairs() sorts the
+     *  boxes by their left edge and sweeps across them, so only boxes
+     *  overlapping on the x-axis are ever compared, and only if one's
+     *  mask has the other's layer in it.
+     *
+     *  The pairs it finds overlap as axis-aligned boxes, which is all
+     *  the narrow phase currently needs. The storage is kept around
+     *  between frames, so a steady number of bodies doesn't allocate.
+     **/
+    class CBroadPhase
+    {
+    public:
+        /// Two boxes that overlap, by the IDs they were added with.
+        struct Pair
+        {
+            u_int first_layer, first_id;
+            u_int second_layer, second_id;
+        };
+
+        CBroadPhase();
+
+        void Clear();
+        void Add(const CRect& Box, const u_int layer, const u_int mask,
+            const u_int id);
+
+        const std::vector<Pair>& FindPairs();
+
+        u_int GetBodyCount() const;
+        u_int GetPairCount() const;
+        u_int GetTestCount() const;
+
+    private:
+        struct Body
+        {
+            int   left, right, top, bottom;
+            u_int layer, mask, id;
+        };
+
+        static bool CompareLeft(const Body& One, const Body& Two);
+
+        std::vector<Body> m_Bodies;
+        std::vector<Pair> m_Pairs;
+        u_int             m_test_count;
+    };
+}
+
+#endif // MATH__BROAD_PHASE_HPP
+
+/// @}
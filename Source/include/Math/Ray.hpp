@@ -51,6 +51,7 @@ namespace math
             math::CVector2* p_Intersection = NULL) const;
         bool CheckCollision(const CRect& Other,
             math::CVector2* p_Intersection = NULL) const;
+        bool Clip(const CRect& Other, float& t) const;
 
         void Rotate(const float angle);
         void Print() const;
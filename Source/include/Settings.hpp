@@ -22,10 +22,16 @@
 #ifndef SETTINGS_HPP
 #define SETTINGS_HPP
 
+#include <ctime>
+#include <cstdlib>
 #include <fstream>
 #include <sstream>
 #include <string>
 #include <vector>
+#include <unordered_map>
+
+#include <sys/types.h>
+#include <sys/stat.h>
 
 #include "Errors.hpp"
 #include "Helpers.hpp"
@@ -36,6 +42,11 @@ namespace game
      * Handles a settings file (typically Settings.ini), 
      * which is supposed to contain critical game values
      * such as sprite locations.
+     *
+     *  The file is parsed once by Load() into a table. Every key can
+     *  be looked up either on its own ("PlayerIMG1") or together with
+     *  its section ("SpriteLocations.PlayerIMG1"); if a bare key shows
+     *  up in several sections, the first one wins.
      **/
     class CSettings
     {
@@ -45,16 +56,44 @@ namespace game
         static CSettings& GetInstance();
 
         bool Load(const std::string& filename);
+        bool Reload();
+        bool CheckForChanges();
+
+        const std::string& ChooseValueAt(const std::string& tag) const;
+        const std::string& GetValueAt(const std::string& tag) const;
 
-        std::string ChooseValueAt(const std::string& tag);
-        std::string GetValueAt(const std::string& tag);
+        int   GetInt(const std::string& tag, const int default_val = 0) const;
+        float GetFloat(const std::string& tag,
+                       const float default_val = 0.0f) const;
+        bool  GetBool(const std::string& tag,
+                      const bool default_val = false) const;
+        const std::vector<std::string>& GetList(const std::string& tag) const;
+
+        bool HasValue(const std::string& tag) const;
 
     private:
-        CSettings(){}
+        /// A value, with any list in it already split up.
+        struct Value
+        {
+            std::string              text;
+            std::vector<std::string> choices;
+        };
+
+        typedef std::unordered_map<std::string, Value> SettingsTable;
+
+        CSettings() : m_modified(0), m_last_check(0) {}
         CSettings(const CSettings&);
         CSettings& operator= (const CSettings&);
 
-        std::ifstream m_settingsfile;
+        const Value* Find(const std::string& tag) const;
+
+        static bool   Parse(const std::string& filename, SettingsTable& Table);
+        static time_t GetModifiedTime(const std::string& filename);
+
+        SettingsTable   m_Table;
+        std::string     m_filename;
+        time_t          m_modified;
+        time_t          m_last_check;
     };
 }
 
@@ -28,11 +28,30 @@ typedef unsigned int u_int;
 
 namespace game
 {
-    /// A timer for controlling frame rates.
+    /**
+     * Simulation rate, in ticks per second.
+     *  Every per-tick quantity (speeds, turn rates, weapon delays,
+     *  projectile lifetimes) is tuned for this rate, so it can't be
+     *  changed without changing how fast the game plays.
+     **/
+    static const u_int SIM_RATE = 60;
+
+    /// Most simulation ticks run in one frame before time is dropped.
+    static const u_int DEFAULT_MAX_STEPS = 5;
+
+    /**
+     * A timer for controlling frame rates.
+     *  It also runs the fixed-step simulation clock: Advance() is
+     *  called once per frame and says how many simulation ticks are
+     *  due, independent of how fast frames are drawn. If a frame takes
+     *  so long that more than the maximum number of ticks are due, the
+     *  extra time is dropped rather than caught up on, so one slow
+     *  frame can't snowball into more and more ticks per frame.
+     **/
     class CTimer
     {
     public:
-        CTimer() : m_FRAMERATE(60), m_ticks(0), m_frame(0) {}
+        CTimer();
         
         /**
          * Starts the timer.
@@ -61,10 +80,27 @@ namespace game
         int     GetFrameRate() const;
         void    SetFrameRate(const u_int new_fps);
 
+        // Fixed-step simulation clock
+        void    SetMaxSteps(const u_int max_steps);
+        void    ResetClock();
+        u_int   Advance();
+
+        float   GetStep() const;
+        float   GetAlpha() const;
+        u_int   GetSimRate() const;
+        double  GetTimeToNextStep() const;
+
+        static double GetTime();
+
     private:
         u_int m_FRAMERATE;
         int m_ticks;
         int m_frame;
+
+        u_int   m_max_steps;
+        double  m_step;
+        double  m_accumulator;
+        double  m_last_time;
     };
 }
 
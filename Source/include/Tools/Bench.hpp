@@ -0,0 +1,44 @@
+/**
+ * @file
+ *  Declarations for the benchmark and tool drivers.
+ *
+ * @author      George Kudrayvtsev (switch1440)
+ * @version     1.0
+ * @copyright   Apache License v2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License").\n
+ *  You may not use this file except in compliance with the License.\n
+ *  You may obtain a copy of the License at:
+ *  http://www.apache.org/licenses/LICENSE-2.0 \n
+ *  Unless required by applicable law or agreed to in writing, software\n
+ *  distributed under the License is distributed on an "AS IS" BASIS,\n
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.\n
+ *  See the License for the specific language governing permissions and\n
+ *  limitations under the License.
+ *
+ * @addtogroup Game
+ **/
+/// @{
+
+#ifndef TOOLS__BENCH_HPP
+#define TOOLS__BENCH_HPP
+
+typedef unsigned int u_int;
+
+/**
+ * Drivers for the command line tools and benchmarks.
+ *  Each one runs in place of the game, with no window or audio,
+ *  and returns the exit code for the run.
+ **/
+namespace tools
+{
+    int simulate(const u_int ticks);
+    int compile_level(const int level_no);
+    int benchmark_load(const int size);
+    int check_batching(const int level_no);
+    int benchmark_grid(const int size);
+    int benchmark_paths(const u_int pairs);
+}
+
+#endif // TOOLS__BENCH_HPP
+
+/// @}
\ No newline at end of file
@@ -71,11 +71,21 @@ namespace ai
         void AddState(AIState state);
         void SetState(AIState state);
         void ResetState();
+        void CollectPath();
 
         virtual void ProcessAI()    = 0;
         virtual void OnPatrolling() = 0;
         virtual void OnSearching()  = 0;
         virtual void OnAttacking()  = 0;
+
+        /**
+         * Points the line-of-sight where the enemy is looking.
+         *  This shouldn't worry about walls, the line-of-sight is
+         *  cut off at them afterwards.
+         *
+         * @see ai::CEnemy::UpdateAllLOS()
+         **/
+        virtual void AimLOS()       = 0;
         
         game::CLevel*           mp_Level;
         const obj::CPlayer&     m_Player;
@@ -89,6 +99,7 @@ namespace ai
         obj::CGameObject*       mp_DestinationTile;
 
         float m_axis_to_path, m_axis_to_player;
+        float m_scan_rate;      // Tower rotation while looking around
         int m_id;
 
     public:
@@ -106,24 +117,33 @@ namespace ai
         virtual void Spawn(const math::CVector2& Position) = 0;
 
         /**
-         * Adjusts the entity by a certain rate. Since there is no default entity
-         * for the enemy, it should be over-written by the inheriting class.
-         * 
-         * @param math::CVector2& The rate to adjust at
-         * @see game::CMap::GetPanRate()
+         * Decides what to do this simulation tick.
+         *  This method is left purely virtual because there are many
+         *  different types of enemies in @a Collapse, and each one will
+         *  think in its own way. It's run for many enemies at once on
+         *  job threads, so it may only change the enemy itself; anything
+         *  touching the rest of the world is left for Act().
+         *
+         * @see game::CJobSystem::ParallelFor()
          **/
-        virtual void Adjust(const math::CVector2& Rate) = 0;
+        virtual void Think() = 0;
 
         /**
-         * Updates the enemy.
-         *  This method is left purely virtual because there are many
-         *  different types of enemies in @a Collapse, and each one will
-         *  have a personal Update() method. Most of the time, rendering
-         *  of the entity and AI processing are done here.
+         * Carries out what Think() decided, on the main thread.
+         *  Weapons are fired, paths are sent off to be solved, and
+         *  the enemy is moved.
          *
          * @return The current state of the enemy.
          **/
-        virtual int Update() = 0;
+        virtual int Act() = 0;
+
+        /**
+         * Advances the enemy by a simulation tick, all on this thread.
+         *  Usually just Think() followed by Act().
+         *
+         * @return The current state of the enemy.
+         **/
+        virtual int Tick() = 0;
 
         void SetDestination(const math::CVector2& Position);
 
@@ -153,6 +173,8 @@ namespace ai
 
         int GetID();
 
+        static void UpdateAllLOS(const game::CCollisionMap& Walls);
+
         /// Contains all of the currently created enemies.
         static std::list<CEnemy*> p_allEnemies;
     };
@@ -43,9 +43,11 @@ namespace ai
 
         bool Init(game::CSettings&);
         void Spawn(const math::CVector2& Position);
-        void Adjust(const math::CVector2& Rate);
 
-        int Update();
+        void Think();
+        int  Act();
+        int  Tick();
+        void Render(gfx::CSpriteBatch& Batch, const float alpha = 1.0f) const;
 
         const math::CVector2&   GetPosition()   const;
         const obj::CGameObject* GetMainEntity() const;
@@ -58,7 +60,9 @@ namespace ai
         void OnAttacking();
 
         void FollowPath();
-        void UpdateLOS();
+        void AimLOS();
+
+        bool m_wants_fire;      // Fire at the player in Act()
     };
 }
 
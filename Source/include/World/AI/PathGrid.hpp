@@ -0,0 +1,74 @@
+/**
+ * @file
+ *  Declarations for the CPathGrid class.
+ *
+ * @author      George Kudrayvtsev (switch1440)
+ * @version     1.0
+ * @copyright   Apache License v2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License").\n
+ *  You may not use this file except in compliance with the License.\n
+ *  You may obtain a copy of the License at:
+ *  http://www.apache.org/licenses/LICENSE-2.0 \n
+ *  Unless required by applicable law or agreed to in writing, software\n
+ *  distributed under the License is distributed on an "AS IS" BASIS,\n
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.\n
+ *  See the License for the specific language governing permissions and\n
+ *  limitations under the License.
+ *
+ * @addtogroup AI
+ **/
+/// @{
+
+#ifndef WORLD__AI__PATH_GRID_HPP
+#define WORLD__AI__PATH_GRID_HPP
+
+#include <vector>
+
+#include "Math/Math.hpp"
+#include "World/Levels/Level.hpp"
+
+namespace ai
+{
+    /**
+     * A read-only snapshot of a level, as seen by the pathfinder.
+     *  Every terrain grid cell is flagged as walkable (there's a
+     *  terrain tile in it) and/or blocked (it touches a wall, so
+     *  the pathfinder won't move out of it). Once built, a grid is
+     *  never modified, which makes it safe to search from any thread.
+     **/
+    class CPathGrid
+    {
+    public:
+        CPathGrid();
+
+        void Build(game::CLevel* pLevel);
+        bool IsCurrent(game::CLevel* pLevel) const;
+
+        bool IsWalkable(const int cx, const int cy) const;
+        bool IsBlocked(const int cx, const int cy) const;
+
+        const math::CRect& GetBounds() const;
+
+    private:
+        enum CellFlags
+        {
+            e_WALKABLE  = (1 << 0),
+            e_BLOCKED   = (1 << 1)
+        };
+
+        std::vector<unsigned char>  m_cells;
+        math::CRect                 m_Bounds;
+
+        game::CLevel*   mp_Level;
+        u_int           m_terrain_revision;
+        u_int           m_collision_revision;
+
+        // Only touched by ai::CPathService, under its lock.
+        friend class CPathService;
+        u_int           m_refs;
+    };
+}
+
+#endif // WORLD__AI__PATH_GRID_HPP
+
+/// @}
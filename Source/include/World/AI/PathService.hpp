@@ -0,0 +1,130 @@
+/**
+ * @file
+ *  Declarations for the CPathService class.
+ *
+ * @author      George Kudrayvtsev (switch1440)
+ * @version     1.0
+ * @copyright   Apache License v2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License").\n
+ *  You may not use this file except in compliance with the License.\n
+ *  You may obtain a copy of the License at:
+ *  http://www.apache.org/licenses/LICENSE-2.0 \n
+ *  Unless required by applicable law or agreed to in writing, software\n
+ *  distributed under the License is distributed on an "AS IS" BASIS,\n
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.\n
+ *  See the License for the specific language governing permissions and\n
+ *  limitations under the License.
+ *
+ * @addtogroup AI
+ **/
+/// @{
+
+#ifndef WORLD__AI__PATH_SERVICE_HPP
+#define WORLD__AI__PATH_SERVICE_HPP
+
+#include <list>
+#include <map>
+#include <vector>
+
+#include "SDL/SDL_thread.h"
+#include "SDL/SDL_mutex.h"
+
+#include "CollapseDef.hpp"
+#include "World/AI/PathGrid.hpp"
+#include "World/AI/PathSolver.hpp"
+
+namespace ai
+{
+    /// The outcome of a path request.
+    struct PathResult
+    {
+        bool                found;  // Was a complete path found?
+        math::CRect         Bounds; // Grid bounds the cells are relative to
+        std::vector<int>    cells;  // Grid cell indices, end to start
+    };
+
+    /**
+     * Solves path requests on worker threads.
+     *  Requests are submitted from the main thread and handed a
+     *  ticket, which is used to pick up the result later on. Workers
+     *  only ever see an ai::CPathGrid snapshot of the level, which is
+     *  rebuilt (on the main thread) whenever the terrain or walls
+     *  change. Snapshots are reference counted, so requests already
+     *  in flight keep searching the one they were submitted against.
+     *
+     *  If no worker threads are running, requests are solved
+     *  immediately when they're submitted.
+     **/
+    class CPathService
+    {
+    public:
+        ~CPathService();
+
+        static CPathService& GetInstance();
+
+        bool Init(const u_int thread_count);
+        void Shutdown();
+
+        u_int Submit(game::CLevel* pLevel,
+            const int start_x, const int start_y,
+            const int end_x, const int end_y);
+
+        bool Collect(const u_int ticket, ai::PathResult& Result);
+        void Wait(const u_int ticket);
+        void Cancel(const u_int ticket);
+
+        u_int GetQueueDepth() const;
+        u_int GetSolvedCount() const;
+        double GetMaxSolveTime() const;
+        double GetAverageSolveTime() const;
+
+    private:
+        CPathService();
+        CPathService(const CPathService&);
+        CPathService& operator= (const CPathService&);
+
+        enum JobState
+        {
+            e_QUEUED,       // Waiting for a worker
+            e_SOLVING,      // Being searched by a worker
+            e_FINISHED      // Result is ready to be collected
+        };
+
+        struct PathJob
+        {
+            JobState        state;
+            bool            cancelled;  // Nobody wants the result anymore
+            ai::CPathGrid*  pGrid;
+            int             start_x, start_y, end_x, end_y;
+            ai::PathResult  Result;
+        };
+
+        static int WorkerThread(void* pData);
+
+        void SolveJob(ai::CPathSolver& Solver, PathJob* pJob);
+        void FinishJob(PathJob* pJob, const double solve_time);
+        void ReleaseGrid(ai::CPathGrid* pGrid);
+
+        std::vector<SDL_Thread*>        mp_allThreads;
+        std::list<PathJob*>             mp_allPending;
+        std::map<u_int, PathJob*>       mp_allJobs;
+
+        SDL_mutex*      mp_Lock;
+        SDL_cond*       mp_JobReady;
+        SDL_cond*       mp_JobDone;
+
+        ai::CPathGrid*  mp_Grid;
+        ai::CPathSolver m_Solver;       // For solving without workers
+
+        u_int   m_next_ticket;
+        bool    m_running;
+
+        u_int   m_solved_count;
+        double  m_total_time;           // Milliseconds
+        double  m_max_time;             // Milliseconds
+    };
+}
+
+#endif // WORLD__AI__PATH_SERVICE_HPP
+
+/// @}
@@ -0,0 +1,77 @@
+/**
+ * @file
+ *  Declarations for the CPathSolver class.
+ *
+ * @author      George Kudrayvtsev (switch1440)
+ * @version     1.0
+ * @copyright   Apache License v2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License").\n
+ *  You may not use this file except in compliance with the License.\n
+ *  You may obtain a copy of the License at:
+ *  http://www.apache.org/licenses/LICENSE-2.0 \n
+ *  Unless required by applicable law or agreed to in writing, software\n
+ *  distributed under the License is distributed on an "AS IS" BASIS,\n
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.\n
+ *  See the License for the specific language governing permissions and\n
+ *  limitations under the License.
+ *
+ * @addtogroup AI
+ **/
+/// @{
+
+#ifndef WORLD__AI__PATH_SOLVER_HPP
+#define WORLD__AI__PATH_SOLVER_HPP
+
+#include <vector>
+
+#include "World/AI/PathGrid.hpp"
+
+namespace ai
+{
+    /**
+     * The A* search used by the pathfinder.
+     *  Search state lives in a flat array with one node per grid
+     *  cell, and the open list is an indexed binary heap. Nodes are
+     *  stamped with the query that last touched them, so nothing has
+     *  to be cleared or allocated between queries. A solver is not
+     *  thread-safe, but any number of solvers can search the same
+     *  ai::CPathGrid at once.
+     **/
+    class CPathSolver
+    {
+    public:
+        CPathSolver();
+
+        bool Solve(const ai::CPathGrid& Grid,
+            const int start_x, const int start_y,
+            const int end_x, const int end_y,
+            std::vector<int>& path);
+
+    private:
+        struct Node
+        {
+            int     parent;         // Cell index of the parent, -1 for none
+            int     move_count;     // Moves taken from the start
+            int     cost;           // Move count + heuristic
+            int     heap_index;     // Position in the open heap, -1 if closed
+            u_int   order;          // Order opened in, breaks cost ties
+            u_int   generation;     // Query that last touched this node
+        };
+
+        void PrepareNodes(const math::CRect& Bounds);
+        bool IsBetter(const int a, const int b) const;
+        void HeapPush(const int node);
+        int  HeapPop();
+        void HeapSiftUp(int pos);
+        void HeapSiftDown(int pos);
+
+        std::vector<Node>   m_Nodes;
+        std::vector<int>    m_OpenHeap;
+        math::CRect         m_Bounds;
+        u_int               m_generation;
+    };
+}
+
+#endif // WORLD__AI__PATH_SOLVER_HPP
+
+/// @}
@@ -23,9 +23,12 @@
 #ifndef WORLD__AI__PATHFINDER_HPP
 #define WORLD__AI__PATHFINDER_HPP
 
+#include <vector>
+
 #include "Math/Math.hpp"
 #include "World/Objects/GameObject.hpp"
 #include "World/Levels/Level.hpp"
+#include "World/AI/PathService.hpp"
 
 /**
  * Dynamic decision making, enemies, objects,
@@ -33,17 +36,41 @@
  **/
 namespace ai
 {
-    /// Implements a custom pathfinding algorithm that's based on A*.
+    /**
+     * Implements a custom pathfinding algorithm that's based on A*.
+     *  The search itself is done by ai::CPathService, usually on a
+     *  worker thread. A new path is requested with RequestPath() and
+     *  sent off with Submit(), and the current one keeps being
+     *  followed until the new one is picked up with Collect().
+     **/
     class CPathfinder
     {
     public:
+        /// Outcome of a path request, as returned by Collect().
+        enum PathStatus
+        {
+            e_NO_REQUEST,   // Nothing has been requested
+            e_WAITING,      // Still being solved
+            e_FOUND,        // Path found and installed
+            e_NOT_FOUND     // No complete path, partial one installed
+        };
+
         CPathfinder(game::CLevel* pCurrentLevel) : 
-            mp_Level(pCurrentLevel), m_current_node(0) {}
-        ~CPathfinder(){}
+            mp_Level(pCurrentLevel), m_current_node(0), m_ticket(0),
+            m_start_x(0), m_start_y(0), m_end_x(0), m_end_y(0),
+            m_queued(false) {}
+        ~CPathfinder();
 
         bool FindPath(obj::CGameObject* pStart_Tile,
             obj::CGameObject* pEnd_Tile);
-        void ShowPath();
+        void RequestPath(obj::CGameObject* pStart_Tile,
+            obj::CGameObject* pEnd_Tile);
+        void Submit();
+        PathStatus Collect();
+        void Cancel();
+        bool IsWaiting() const;
+
+        void ShowPath(gfx::CSpriteBatch& Batch) const;
         void ReversePath();
 
         obj::CGameObject* NextTile();
@@ -52,19 +79,15 @@ namespace ai
         const math::CVector2& GetCurrentDestination() const;
 
     private:
-        struct Node
-        {
-            Node* pParent;
-            obj::CGameObject* pTile;
-            int cost;
-            int move_count;
-            int heuristic;
-        };
-
         std::vector<obj::CGameObject*>  mp_Path;
         game::CLevel*                   mp_Level;
 
-        int m_current_node;
+        int     m_current_node;
+        u_int   m_ticket;
+
+        // Request waiting for Submit()
+        int     m_start_x, m_start_y, m_end_x, m_end_y;
+        bool    m_queued;
     };
 }
 
@@ -0,0 +1,67 @@
+/**
+ * @file
+ *  Declarations of the CCamera class.
+ *
+ * @author      George Kudrayvtsev (switch1440)
+ * @version     1.0
+ * @copyright   Apache License v2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License").\n
+ *  You may not use this file except in compliance with the License.\n
+ *  You may obtain a copy of the License at:
+ *  http://www.apache.org/licenses/LICENSE-2.0 \n
+ *  Unless required by applicable law or agreed to in writing, software\n
+ *  distributed under the License is distributed on an "AS IS" BASIS,\n
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.\n
+ *  See the License for the specific language governing permissions and\n
+ *  limitations under the License.
+ *
+ * @addtogroup Game
+ **/
+/// @{
+
+#ifndef WORLD__LEVELS__CAMERA_HPP
+#define WORLD__LEVELS__CAMERA_HPP
+
+#include "Math/Math.hpp"
+#include "Graphics/Graphics.hpp"
+
+namespace game
+{
+    /**
+     * The view into the game world.
+     *  Everything in a level (tiles, tanks, bullets, lights) lives in
+     *  world coordinates. The camera holds a single offset that maps
+     *  them onto the screen: screen = world + offset. Panning the view
+     *  only ever changes this offset, and rendering picks it up through
+     *  the GL modelview matrix between Enable() and Disable().
+     **/
+    class CCamera
+    {
+    public:
+        CCamera();
+
+        bool Pan(const math::CVector2& Focus);
+
+        void Enable(const float alpha = 1.0f) const;
+        void Disable() const;
+
+        void SetPanRate(const int rate);
+
+        math::CVector2 ToWorld(const math::CVector2& Screen) const;
+        math::CVector2 ToScreen(const math::CVector2& World) const;
+
+        math::CRect GetView() const;
+        const math::CVector2& GetOffset() const;
+        math::CVector2 GetRenderOffset(const float alpha) const;
+        const math::CVector2& GetPanRate() const;
+
+    private:
+        math::CVector2  m_Offset;
+        math::CVector2  m_PanRate;
+        int             m_pan_adjustment_rate;
+    };
+}
+
+#endif // WORLD__LEVELS__CAMERA_HPP
+
+/// @}
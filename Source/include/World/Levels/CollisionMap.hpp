@@ -43,13 +43,15 @@ namespace game
         ~CCollisionMap();
 
         bool Load(const char* pfilename);
+        bool Load(const game::CLevelFile& Level);
         bool Save(const char* pfilename);
 
         void PlaceTile(int x, int y);
-        void Update(bool show_active);
+        void Render(bool show_active);
         
     private:
-        SDL_Surface* mp_Overlay;
+        SDL_Surface*    mp_Overlay;
+        asset::CTexture m_OverlayTexture;   // Shared by compiled tiles
     };
 }
 
@@ -22,6 +22,7 @@
 #ifndef WORLD__LEVELS__LEVEL_HPP
 #define WORLD__LEVELS__LEVEL_HPP
 
+#include "World/Levels/Camera.hpp"
 #include "World/Levels/TerrainMap.hpp"
 #include "World/Levels/CollisionMap.hpp"
 #include "World/Levels/ObjectiveMap.hpp"
@@ -33,22 +34,34 @@ namespace game
     public:
         CLevel();
 
-    	bool LoadLevel(const int level_no);
-        bool PanMaps(const math::CVector2& Pos);
-        void Update();
+    	bool LoadLevel(const int level_no, const bool compiled = true);
+        bool LoadLevel(const std::string& name, const bool compiled = true);
+        bool Compile() const;
+        bool Pan(const math::CVector2& Pos);
+        void Render();
+        void RenderOverlay();
+        bool ToggleOverlay();
 
         void SetPanRate(const float rate);
 
+        const game::CCamera& GetCamera() const;
         game::CTerrainMap&   GetTerrainMap();
         game::CCollisionMap& GetCollisionMap();
         game::CObjectiveMap& GetObjectiveMap();
         const std::string&   GetLevelName() const;
+        unsigned long long   GetSourceKey() const;
 
     private:
+        bool LoadCompiled();
+        bool IsCompiled() const;
+
+        game::CCamera       m_Camera;
         game::CTerrainMap   m_TerrainMap;
         game::CCollisionMap m_CollisionMap;
         game::CObjectiveMap m_ObjectiveMap;
+        gfx::CLineBatch     m_Overlay;
         std::string         m_levelname;
+        unsigned long long  m_source_key;   // Of the text maps
     };
 }
 
@@ -0,0 +1,122 @@
+/**
+ * @file
+ *  Declarations for the CLevelFile class.
+ *
+ * @author      George Kudrayvtsev (switch1440)
+ * @version     1.0
+ * @copyright   Apache License v2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License").\n
+ *  You may not use this file except in compliance with the License.\n
+ *  You may obtain a copy of the License at:
+ *  http://www.apache.org/licenses/LICENSE-2.0 \n
+ *  Unless required by applicable law or agreed to in writing, software\n
+ *  distributed under the License is distributed on an "AS IS" BASIS,\n
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.\n
+ *  See the License for the specific language governing permissions and\n
+ *  limitations under the License.
+ *
+ * @addtogroup Game
+ **/
+/// @{
+
+#ifndef WORLD__LEVELS__LEVEL_FILE_HPP
+#define WORLD__LEVELS__LEVEL_FILE_HPP
+
+#include "World/Levels/TerrainMap.hpp"
+#include "World/Levels/CollisionMap.hpp"
+#include "World/Levels/ObjectiveMap.hpp"
+
+namespace game
+{
+    /// Extension for compiled levels (@a Collapse Level).
+    static const char LEVEL_FILE_EXT[] = {".clvl"};
+
+    /// Compiled levels of any other version are ignored.
+    static const u_int LEVEL_FILE_VERSION = 2;
+
+    /**
+     * A compiled level, with every map layer in one binary file.
+     *  The file is mapped into memory and used as-is: the header
+     *  gives the offsets of dense arrays covering the level's grid
+     *  of TILE_SIZE cells, which the maps read their tiles straight
+     *  out of.
+     *
+     *  - A string table of terrain texture names.
+     *  - A terrain grid, with a texture index + 1 per cell (0 is empty).
+     *  - A collision grid, with a bit per cell (set is a wall).
+     *  - Objective records, in the order they were in the text map.
+     *
+     *  Everything is stored in the native byte order, so compiled
+     *  levels are only meant for the platform that compiled them.
+     *  They're made from the text maps with Write(), and keep a hash
+     *  of them so a level whose text maps changed can be told apart.
+     **/
+    class CLevelFile
+    {
+    public:
+        /// The start of every compiled level.
+        struct Header
+        {
+            char  magic[4];         // "CLVL"
+            u_int version;          // LEVEL_FILE_VERSION
+            unsigned long long source_key;  // HashSources() of the maps
+            u_int size;             // File size, in bytes
+
+            int   x, y;             // First cell of the grids
+            u_int w, h;             // Grid size, in cells
+
+            u_int texture_count;    // Names in the string table
+            u_int strings;          // Offset of the name offsets
+            u_int strings_size;     // Bytes of names, after the offsets
+
+            u_int terrain;          // Offset of the terrain grid
+            u_int terrain_count;    // Terrain tiles in it
+            u_int collision;        // Offset of the collision bits
+            u_int collision_count;  // Walls in it
+
+            u_int objectives;       // Offset of the objective records
+            u_int objective_count;  // Records there
+        };
+
+        /// An objective map tile.
+        struct Objective
+        {
+            int   cx, cy;           // Cell
+            u_int type;             // game::CObjectiveMap::TileAttributes
+        };
+
+        CLevelFile();
+        ~CLevelFile();
+
+        bool Open(const char* pfilename);
+        void Close();
+
+        static bool Write(const char* pfilename,
+            const game::CTerrainMap& Terrain,
+            const game::CCollisionMap& Collision,
+            const game::CObjectiveMap& Objectives,
+            const unsigned long long source_key);
+        static unsigned long long HashSources(const std::string& name);
+
+        const Header& GetHeader() const;
+        const char* GetTextureName(const u_int index) const;
+        const unsigned short* GetTerrain() const;
+        const unsigned char* GetCollision() const;
+        const Objective* GetObjectives() const;
+
+        bool IsWall(const u_int x, const u_int y) const;
+
+    private:
+        CLevelFile(const CLevelFile&);
+        CLevelFile& operator= (const CLevelFile&);
+
+        bool Validate() const;
+
+        const char* mp_Data;
+        size_t      m_size;
+    };
+}
+
+#endif // WORLD__LEVELS__LEVEL_FILE_HPP
+
+/// @}
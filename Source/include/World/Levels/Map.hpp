@@ -3,7 +3,7 @@
  *  Declarations of the CMap class.
  *
  * @author      George Kudrayvtsev (switch1440)
- * @version     1.1.3
+ * @version     1.2.0
  * @copyright   Apache License v2.0
  *  Licensed under the Apache License, Version 2.0 (the "License").\n
  *  You may not use this file except in compliance with the License.\n
@@ -31,11 +31,17 @@
 
 #include "Math/Math.hpp"
 #include "Graphics/Graphics.hpp"
+#include "Graphics/LineBatch.hpp"
 #include "Assets/AssetManager.hpp"
 #include "World/Objects/GameObject.hpp"
 
 namespace game
 {
+    class CLevelFile;
+
+    /// Edge length of a single map tile (and of a spatial index cell).
+    static const int TILE_SIZE = 32;
+
     /**
      * The base class for the map layers.
      *  Throughout @a Collapse, there are three layers to every map.
@@ -46,10 +52,28 @@ namespace game
      *  Then finally, at the highest level, is the objective map, which
      *  specifies spawn points, player objectives, AI points-of-interest,
      *  etc.
+     *
+     *  Tiles live in world coordinates and never move once placed; the
+     *  view is scrolled by the level's game::CCamera instead. Every layer
+     *  keeps its tiles in a uniform grid of TILE_SIZE cells, so tile
+     *  lookups only ever touch the cells they overlap.
+     *
+     *  Layers that are only there for their data (the collision and
+     *  objective maps, in game) can be hidden. Hidden layers do no
+     *  OpenGL work at all, and can be shown as an overlay of tile
+     *  outlines for debugging.
      **/
     class CMap
     {
     public:
+        /// How a layer is drawn.
+        enum DisplayMode
+        {
+            e_DISPLAY_TILES,    // Tile textures, by Render()
+            e_DISPLAY_OVERLAY,  // Tile outlines, by DrawOverlay()
+            e_DISPLAY_HIDDEN    // Nothing
+        };
+
         CMap(bool edit_mode = false);
         virtual ~CMap();
 
@@ -60,26 +84,66 @@ namespace game
         obj::CGameObject* FindTile(const math::CVector2& Position) const;
         obj::CGameObject* FindTile(const math::CRect& Area) const;
 
+        obj::CGameObject* CastRay(const math::CRay2& Ray,
+            math::CVector2* p_Hit = NULL, float* p_Time = NULL) const;
+        void CastRays(std::vector<math::CRay2>& Rays,
+            std::vector<obj::CGameObject*>* p_Hits = NULL) const;
+
         virtual void PlaceTile(int x, int y) = 0;
         void RemoveTile(int x, int y);
         void RemoveTile(const math::CVector2& Position);
         void RemoveTile(const obj::CGameObject* p_Tile);
 
-        bool Pan(const math::CVector2& Position);
+        virtual void Render(bool show_active) = 0;
+        void DrawOverlay(gfx::CLineBatch& Batch, const gfx::Color& Color,
+            const math::CRect& View) const;
 
-        virtual void Update(bool show_active) = 0;
+        void SetDisplayMode(const DisplayMode mode);
+        DisplayMode GetDisplayMode() const;
 
-        void SetPanRate(const int rate);
-        const math::CVector2& GetPanRate() const;
         const std::vector<obj::CGameObject*>& GetTiles() const;
+
+        obj::CGameObject* GetTileAt(const int cx, const int cy) const;
+        void GetTileCell(const obj::CGameObject* pTile, int& cx, int& cy) const;
+        const math::CRect& GetIndexBounds() const;
+        u_int GetRevision() const;
         
     protected:
+        typedef std::vector<obj::CGameObject*> TileCell;
+
+        void AddTile(obj::CGameObject* pTile);
+        obj::CGameObject* CreateTiles(const u_int count);
+        void ClearTiles();
+        void RebuildIndex();
+        const TileCell* GetCell(const int cx, const int cy) const;
+
+        /**
+         * Called whenever a single tile is added or removed.
+         *  The tile is still in the map (and the index) when it's
+         *  being removed.
+         *
+         * @param obj::CGameObject* The tile
+         **/
+        virtual void OnTileChanged(const obj::CGameObject* /*pTile*/) {}
+
         obj::CGameObject*   mp_CurrentTile;
-        math::CVector2      m_PanRate;
 
         std::vector<obj::CGameObject*> mp_allTiles;
+        gfx::CSpriteBatch m_Batch;
+        DisplayMode m_display;
         bool m_can_edit;
-        int m_pan_adjustment_rate;
+
+    private:
+        void IndexTile(obj::CGameObject* pTile);
+        void UnindexTile(const obj::CGameObject* pTile);
+        void GetPointCell(float x, float y, int& cx, int& cy) const;
+        obj::CGameObject* FindInCell(const int cx, const int cy,
+            const float x, const float y) const;
+
+        std::vector<TileCell>   m_TileIndex;
+        std::vector<obj::CGameObject>   m_TileBlock;    // From CreateTiles()
+        math::CRect             m_IndexBounds;
+        u_int                   m_revision;
     };
 }
 
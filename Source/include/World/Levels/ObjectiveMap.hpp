@@ -36,28 +36,33 @@ namespace game
     class CObjectiveMap : public CMap
     {
     public:
+        enum TileAttributes {e_POI, e_ENEMY_SPAWN, e_PLAYER_SPAWN, e_LIGHT};
+
         CObjectiveMap(bool can_edit = false);
         ~CObjectiveMap();
 
         bool Load(const char* pfilename);
+        bool Load(const game::CLevelFile& Level);
         bool Save(const char* pfilename);
 
         void NextTile();
         void PlaceTile(int x, int y);
-        bool Pan(const math::CVector2& Position);
-        void Update(bool show_active);
+        void Render(bool show_active);
 
         obj::CGameObject* GetNearestPOI(const math::CVector2& Position) const;
         obj::CGameObject* GetAvailableEnemySpawn(
             const std::vector<const obj::CGameObject*>& p_allEnemies) const;
         obj::CGameObject* GetPlayerSpawn() const;
         std::vector<gfx::CLight*>& GetLights();
+        TileAttributes GetAttribute(const size_t index) const;
 
     private:
-        enum TileAttributes {e_POI, e_ENEMY_SPAWN, e_PLAYER_SPAWN, e_LIGHT};
         std::vector<TileAttributes> m_allTileAttributes;
         std::vector<gfx::CLight*> mp_allLights;
         SDL_Surface* mp_Overlay;
+
+        // One per attribute, shared by compiled tiles.
+        asset::CTexture m_TypeTextures[4];
     };
 }
 
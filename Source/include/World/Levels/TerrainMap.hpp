@@ -36,7 +36,17 @@ namespace game
     /// Extension for terrain maps (@a Collapse Terrain Map)
     static const char TERRAIN_MAP_EXT[] = {".ctm"};
 
-    /// The terrain tile map.
+    /// Edge length of a terrain mesh chunk, in tiles.
+    static const int CHUNK_SIZE = 16;
+
+    /**
+     * The terrain tile map.
+     *  Terrain never moves, so rather than drawing every tile each
+     *  frame, the map is split into chunks of CHUNK_SIZE x CHUNK_SIZE
+     *  tiles that are each built into a gfx::CSpriteBatch once. Only
+     *  chunks in view are drawn, and a chunk is only rebuilt when a
+     *  tile in it is placed or removed.
+     **/
     class CTerrainMap : public CMap
     {
     public:
@@ -44,16 +54,36 @@ namespace game
         ~CTerrainMap();
 
         bool Load(const char* pfilename);
+        bool Load(const game::CLevelFile& Level);
         bool Save(const char* pfilename);
 
         void NextTile();
         void PlaceTile(int x, int y);
-        void Update(bool show_active);
+        void Render(bool show_active);
+
+        void SetView(const math::CRect& View);
         
+    protected:
+        void OnTileChanged(const obj::CGameObject* pTile);
+
     private:
+        struct Chunk
+        {
+            gfx::CSpriteBatch   Mesh;
+            bool                dirty;
+        };
+
         bool IsValidTextureName(const char* ptexture_name);
 
+        void ClearChunks();
+        void LayoutChunks();
+        void BuildChunk(const int x, const int y);
+
         std::vector<std::string> m_textureNames;
+
+        std::vector<Chunk*> mp_allChunks;
+        math::CRect         m_ChunkBounds;  // Index bounds the chunks cover
+        math::CRect         m_View;         // Empty to draw everything
     };
 }
 
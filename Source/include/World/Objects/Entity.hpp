@@ -28,6 +28,7 @@
 
 #include "Math/Math.hpp"
 #include "Graphics/Graphics.hpp"
+#include "Graphics/SpriteBatch.hpp"
 #include "Assets/Texture.hpp"
 
 namespace obj
@@ -56,6 +57,10 @@ namespace obj
         void ResizeTexture(const u_int w, const u_int h);
         void ResizeTexture(const math::CRect& NewSize);
 
+        virtual void Tick();
+        virtual void Render(gfx::CSpriteBatch& Batch,
+            const float alpha = 1.0f) const;
+        void Draw() const;
         void Update();
 
         // Modifiers
@@ -82,11 +87,13 @@ namespace obj
         // Member variables
         asset::CTexture m_Texture;
         math::CVector2  m_Position;
+        math::CVector2  m_LastPosition;
         math::CVector2  m_MovementRate;
         math::CRectf    m_RenderDimensions;
         float           m_vertices[4];
         float           m_rotation_angle;
         bool            m_useblending;
+        bool            m_snap;         // Don't interpolate the next move
     };
 }
 
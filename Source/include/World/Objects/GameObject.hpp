@@ -58,7 +58,7 @@ namespace obj
         void Damage(const u_int dmg);
 
         // Updating
-        virtual void Update();
+        virtual void Tick();
 
         // Modifiers
         void SetCollisionBox(const math::CRect& Collision_Box);
@@ -36,7 +36,6 @@ namespace obj
         void IncreaseKillCount();
         void IncreaseSurvivorCount();
         void IncreaseDayCount();
-        int  Update();
 
         void SetSpawn(const math::CVector2& Pos);
         u_int GetKills() const;
@@ -37,7 +37,9 @@ namespace obj
         void Launch(const math::CVector2& Start,
             const math::CVector2& Target);
 
-        virtual void Update();
+        virtual void Tick();
+        virtual void Render(gfx::CSpriteBatch& Batch,
+            const float alpha = 1.0f) const;
 
         void  SetLifetime(const float lifetime);
         void  SetDamage(const u_int dmg);
@@ -0,0 +1,108 @@
+/**
+ * @file
+ *  Declarations for the CProjectilePool class.
+ *
+ * @author      George Kudrayvtsev (switch1440)
+ * @version     1.0
+ * @copyright   Apache License v2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License").\n
+ *  You may not use this file except in compliance with the License.\n
+ *  You may obtain a copy of the License at:
+ *  http://www.apache.org/licenses/LICENSE-2.0 \n
+ *  Unless required by applicable law or agreed to in writing, software\n
+ *  distributed under the License is distributed on an "AS IS" BASIS,\n
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.\n
+ *  See the License for the specific language governing permissions and\n
+ *  limitations under the License.
+ *
+ * @addtogroup Objects
+ **/
+/// @{
+
+#ifndef WORLD__OBJECTS__PROJECTILE_POOL_HPP
+#define WORLD__OBJECTS__PROJECTILE_POOL_HPP
+
+#include <vector>
+
+#include "Math/Math.hpp"
+#include "Graphics/SpriteBatch.hpp"
+#include "Assets/Texture.hpp"
+
+namespace obj
+{
+    /// Who fired a projectile.
+    enum ProjectileOwner
+    {
+        e_PLAYER_SHOT,
+        e_ENEMY_SHOT
+    };
+
+    /// Most projectiles that can be in flight at once.
+    static const u_int MAX_PROJECTILES = 512;
+
+    /// Frames a projectile flies for before it's removed.
+    static const float PROJECTILE_LIFETIME  = 60.0f;
+
+    /// Default distance a projectile moves every frame, in pixels.
+    static const float PROJECTILE_SPEED     = 16.0f;
+
+    /**
+     * Every projectile in flight, stored as parallel arrays.
+     *  All of the storage is allocated up front, so firing and
+     *  removing projectiles never touches the heap. Removal swaps
+     *  the last projectile into the freed slot, so indices are only
+     *  stable until the next Remove() or Integrate().
+     *
+     *  A projectile that hits something can be turned into a spark
+     *  with Explode(); it's drawn once more, then removed by the next
+     *  Integrate().
+     **/
+    class CProjectilePool
+    {
+    public:
+        CProjectilePool(const u_int capacity = MAX_PROJECTILES);
+        ~CProjectilePool();
+
+        bool Fire(const asset::CTexture* pTexture,
+            const math::CVector2& Start, const math::CVector2& Target,
+            const float angle, const u_int damage,
+            const ProjectileOwner owner,
+            const float speed = PROJECTILE_SPEED);
+
+        void Integrate();
+        void Explode(const u_int index, const asset::CTexture* pSpark);
+        void Explode(const u_int index, const asset::CTexture* pSpark,
+            const math::CVector2& Position);
+        void Remove(const u_int index);
+        void Clear();
+        void Render(const float alpha = 1.0f);
+
+        u_int GetCount() const;
+        bool  IsLive(const u_int index) const;
+        math::CVector2  GetPosition(const u_int index) const;
+        math::CRay2     GetMotion(const u_int index) const;
+        math::CRect     GetBounds(const u_int index) const;
+        u_int           GetDamage(const u_int index) const;
+        ProjectileOwner GetOwner(const u_int index) const;
+
+    private:
+        CProjectilePool(const CProjectilePool&);
+        CProjectilePool& operator= (const CProjectilePool&);
+
+        std::vector<float>  m_x, m_y;
+        std::vector<float>  m_vx, m_vy;
+        std::vector<float>  m_lifetime;
+        std::vector<float>  m_angle;
+        std::vector<u_int>  m_damage;
+        std::vector<ProjectileOwner>        m_owner;
+        std::vector<const asset::CTexture*> mp_allTextures;
+
+        gfx::CSpriteBatch   m_Batch;
+        u_int               m_count;
+        u_int               m_capacity;
+    };
+}
+
+#endif // WORLD__OBJECTS__PROJECTILE_POOL_HPP
+
+/// @}
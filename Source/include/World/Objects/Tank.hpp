@@ -43,7 +43,6 @@ namespace obj
 
         void Turn(const float deg);
         void Drive(const float speed);
-        void Adjust(const math::CVector2& Rate);
         void Aim(const float x, const float y);
         void Aim(const math::CVector2& Target);
         void RotateTower(const float degrees);
@@ -55,7 +54,9 @@ namespace obj
         bool IsAlive()  const;
         bool IsMoving() const;
 
-        virtual int Update();
+        virtual int  Tick();
+        virtual void Render(gfx::CSpriteBatch& Batch,
+            const float alpha = 1.0f) const;
 
         const math::CVector2& GetBarrelPosition() const;
         const math::CVector2& GetPosition() const;
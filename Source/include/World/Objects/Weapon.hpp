@@ -43,7 +43,8 @@ namespace obj
 
         bool Fire();
         void Reload();
-        void Update();
+        void Tick();
+        void Render(gfx::CSpriteBatch& Batch, const float alpha = 1.0f) const;
 
         // Modifiers
         void SetClipCount(const u_int count);
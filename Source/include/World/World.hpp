@@ -23,16 +23,21 @@
 #define WORLD__WORLD_HPP
 
 #include "CollapseDef.hpp"
+#include "JobSystem.hpp"
 #include "SystemEvents.hpp"
 #include "GameEvents.hpp"
 
 #include "Math/Math.hpp"
+#include "Math/BroadPhase.hpp"
 
 #include "Graphics/Shader.hpp"
+#include "Graphics/Compositor.hpp"
 #include "Graphics/Light.hpp"
+#include "Graphics/LightGrid.hpp"
+#include "Graphics/Lightmap.hpp"
 
 #include "World/Levels/Level.hpp"
-#include "World/Objects/Bullet.hpp"
+#include "World/Objects/ProjectilePool.hpp"
 #include "World/Objects/Player.hpp"
 #include "World/AI/EnemyTank.hpp"
 
@@ -54,29 +59,58 @@ namespace game
 
         void Init();
         void HandleEvent(SDL_Event& Evt);
-        void Update();
+        void Tick();
+        void Render(const float alpha = 1.0f);
 
         void HandleSystemEvent(const SDL_Event& Evt);
         void HandleGameEvent(const game::GameEvent* pEvt);
 
         obj::CPlayer& GetPlayer();
+        const math::CBroadPhase& GetBroadPhase() const;
+        const gfx::CCompositor&  GetCompositor() const;
 
     private:
+        /// Broad phase layers, one bit each.
+        enum CollisionLayer
+        {
+            e_LAYER_PLAYER      = 1 << 0,
+            e_LAYER_ENEMY       = 1 << 1,
+            e_LAYER_PLAYER_SHOT = 1 << 2,
+            e_LAYER_ENEMY_SHOT  = 1 << 3
+        };
+
         void HandleCollisions();
         void HandleWorldEvents();
         bool SpawnEnemy();
 
+        static void ThinkEnemies(void* pData, const u_int begin,
+            const u_int end);
+
         math::CVector2  m_PlayerRate;
         game::CLevel*   mp_ActiveLevel;
         obj::CEntity    m_Background;
         obj::CPlayer    m_Player;
         gfx::CShader    m_Lighting;
+        gfx::CCompositor m_Compositor;
+
+        gfx::UniformHandle  m_ViewOffset;
+        gfx::CLightGrid     m_LightGrid;
+        gfx::CLightmap      m_Lightmap;     // Level lights, baked
 
         std::vector<game::CLevel*>  mp_Levels;
-        //std::vector<gfx::CLight*>   mp_Lights;
+        std::vector<gfx::CLight*>   mp_Lights;  // Lights that move
         std::list<ai::CEnemyTank*>  mp_Enemies;
-        obj::pBulletCollection      mp_enemyBullets;
-        obj::pBulletCollection      mp_playerBullets;
+        obj::CProjectilePool        m_Projectiles;
+        const asset::CTexture*      mp_Spark;
+        gfx::CSpriteBatch           m_Batch;    // Tanks
+
+        // Reused every tick by Tick(), for the enemies to think over.
+        std::vector<ai::CEnemyTank*>    mp_allThinking;
+
+        // Reused every frame by HandleCollisions().
+        math::CBroadPhase               m_BroadPhase;
+        std::vector<ai::CEnemyTank*>    mp_allTargets;
+        std::vector<u_int>              m_spent;
 
         game::GameState&    m_engine_state;
 
@@ -1,3 +1,120 @@
+/**
+ * @file
+ *  Definitions for the CAssetManager class.
+ *
+ * @author George Kudrayvtsev
+ * @version 1.0
+ **/
+
 #include "Assets/AssetManager.hpp"
 
-std::vector<asset::CAsset*> asset::CAssetManager::mp_allAssets;
\ No newline at end of file
+using asset::CAssetManager;
+
+std::vector<asset::CAsset*> CAssetManager::mp_allAssets;
+CAssetManager::AssetMap     CAssetManager::m_ByFilename;
+CAssetManager::IDMap        CAssetManager::m_ByID;
+
+/**
+ * Looks up an asset by filename.
+ *
+ * @param char* Asset filename, in any form HashFilename() accepts
+ * @return The asset, NULL if it hasn't been loaded.
+ **/
+asset::CAsset* CAssetManager::Find(const char* pfilename)
+{
+    AssetMap::iterator i = m_ByFilename.find(
+        CAssetManager::HashFilename(pfilename));
+
+    return (i == m_ByFilename.end()) ? NULL : i->second;
+}
+
+/**
+ * Looks up an asset by ID.
+ *
+ * @param asset_id Asset ID
+ * @return The asset, NULL if there is none with the ID.
+ *
+ * @see CAsset::GetID()
+ **/
+asset::CAsset* CAssetManager::Find(const asset::asset_id uid)
+{
+    IDMap::iterator i = m_ByID.find(uid);
+    return (i == m_ByID.end()) ? NULL : i->second;
+}
+
+/**
+ * Adds an asset that was loaded elsewhere.
+ *
+ * @param CAsset* The asset, owned by the manager from now on
+ * @return TRUE if added, FALSE if the filename is already taken.
+ **/
+bool CAssetManager::Register(CAsset* pAsset)
+{
+    path_hash key = CAssetManager::HashFilename(pAsset->GetFilename());
+    if(m_ByFilename.find(key) != m_ByFilename.end())
+        return false;
+
+    CAssetManager::Add(key, pAsset);
+    return true;
+}
+
+/**
+ * Hashes a filename after normalising it.
+ *  Case is ignored, back-slashes count as forward-slashes,
+ *  repeated slashes are merged, and "./" path segments are skipped,
+ *  so every spelling of a path gets the same hash. The hash is
+ *  64-bit FNV-1a, computed on the fly without copying the string.
+ *
+ * @param char* Filename
+ * @return The filename hash.
+ **/
+asset::path_hash CAssetManager::HashFilename(const char* pfilename)
+{
+    path_hash hash = 14695981039346656037ULL;
+    bool segment_start = true;
+
+    for(const char* p = pfilename; *p != '\0'; ++p)
+    {
+        char c = *p;
+        if(c == '\\') c = '/';
+
+        if(segment_start)
+        {
+            // Skip "//" and "./" (or a trailing ".").
+            if(c == '/' && p != pfilename)
+                continue;
+
+            if(c == '.' && (p[1] == '/' || p[1] == '\\' || p[1] == '\0'))
+            {
+                ++p;
+                if(*p == '\0') break;
+                continue;
+            }
+        }
+
+        if(c >= 'A' && c <= 'Z')
+            c += 'a' - 'A';
+
+        hash ^= (unsigned char)c;
+        hash *= 1099511628211ULL;
+        segment_start = (c == '/');
+    }
+
+    return hash;
+}
+
+/**
+ * Starts tracking an asset.
+ *
+ * @param path_hash Filename hash
+ * @param CAsset* The asset
+ **/
+void CAssetManager::Add(const path_hash key, CAsset* pAsset)
+{
+    mp_allAssets.push_back(pAsset);
+    m_ByFilename[key] = pAsset;
+
+    // IDs aren't guaranteed to be unique, first one wins.
+    if(m_ByID.find(pAsset->GetID()) == m_ByID.end())
+        m_ByID[pAsset->GetID()] = pAsset;
+}
@@ -17,6 +17,12 @@ using asset::CFont;
 CFont::~CFont()
 {    
     TTF_CloseFont(mp_Data);
+
+    for(std::map<u_int, CGlyphAtlas*>::iterator i = mp_allGlyphs.begin();
+        i != mp_allGlyphs.end(); ++i)
+    {
+        delete i->second;
+    }
 }
 
 /**
@@ -94,6 +100,33 @@ bool CFont::Resize(const u_int new_size)
     return this->LoadFromFile(m_filename.c_str(), new_size);
 }
 
+/**
+ * Retrieves the glyph atlas for a certain size, creating it if needed.
+ *  This doesn't touch the current font size, so text of several
+ *  sizes can be drawn without calling Resize() in between.
+ *
+ * @param u_int Font size
+ * @return The glyph atlas, NULL if it couldn't be created.
+ *
+ * @see gfx::CText
+ **/
+const asset::CGlyphAtlas* CFont::GetGlyphs(const u_int size)
+{
+    std::map<u_int, CGlyphAtlas*>::iterator i = mp_allGlyphs.find(size);
+    if(i != mp_allGlyphs.end())
+        return i->second;
+
+    CGlyphAtlas* pGlyphs = new CGlyphAtlas;
+    if(!pGlyphs->Create(m_filename.c_str(), size))
+    {
+        delete pGlyphs;
+        return NULL;
+    }
+
+    mp_allGlyphs[size] = pGlyphs;
+    return pGlyphs;
+}
+
 /**
  * Render some text with some color.
  *
@@ -0,0 +1,164 @@
+/**
+ * @file
+ *  Definitions for the CGlyphAtlas class.
+ *
+ * @author George Kudrayvtsev
+ * @version 1.0
+ **/
+
+#include "Assets/GlyphAtlas.hpp"
+
+using asset::CGlyphAtlas;
+
+/// Width of the atlas texture, it grows downwards as needed.
+static const int GLYPH_ATLAS_WIDTH = 256;
+
+CGlyphAtlas::CGlyphAtlas() : m_texture(0), m_line_skip(0),
+    m_height(0), m_size(0)
+{
+    for(size_t i = 0; i < sizeof m_Glyphs / sizeof m_Glyphs[0]; ++i)
+        m_Glyphs[i] = Glyph();
+}
+
+CGlyphAtlas::~CGlyphAtlas()
+{
+    if(m_texture != 0)
+        glDeleteTextures(1, &m_texture);
+}
+
+/**
+ * Rasterises every glyph of a font into the atlas.
+ *  The font is opened on its own and closed again afterwards,
+ *  everything needed to lay out text is kept in the atlas.
+ *
+ * @param char* Font filename
+ * @param u_int Font size
+ *
+ * @return TRUE if the atlas was created, FALSE otherwise.
+ **/
+bool CGlyphAtlas::Create(const char* pfilename, const u_int size)
+{
+    TTF_Font* pFont = TTF_OpenFont(pfilename, size);
+    if(pFont == NULL)
+        return false;
+
+    const int count = LAST_GLYPH - FIRST_GLYPH + 1;
+    const int ascent = TTF_FontAscent(pFont);
+    SDL_Surface* pAllGlyphs[count];
+
+    m_size      = size;
+    m_line_skip = TTF_FontLineSkip(pFont);
+    m_height    = TTF_FontHeight(pFont);
+
+    // Render and place every glyph, with a pixel of space between them.
+    int x = 1, y = 1, row_h = 0;
+    for(int i = 0; i < count; ++i)
+    {
+        const Uint16 c = (Uint16)(FIRST_GLYPH + i);
+        Glyph& Current = m_Glyphs[i];
+        int minx, maxx, miny, maxy;
+
+        TTF_GlyphMetrics(pFont, c, &minx, &maxx, &miny, &maxy,
+            &Current.advance);
+
+        pAllGlyphs[i] = TTF_RenderGlyph_Blended(pFont, c, gfx::WHITE);
+        if(pAllGlyphs[i] == NULL)
+            continue;
+
+        Current.x = minx;
+        Current.y = ascent - maxy;
+        Current.w = pAllGlyphs[i]->w;
+        Current.h = pAllGlyphs[i]->h;
+
+        if(x + Current.w + 1 > GLYPH_ATLAS_WIDTH)
+        {
+            x  = 1;
+            y += row_h + 1;
+            row_h = 0;
+        }
+
+        // Pixel position for now, normalized once the height is known.
+        Current.TexCoords = math::CRectf(x, y, Current.w, Current.h);
+        x += Current.w + 1;
+        row_h = max(row_h, Current.h);
+    }
+
+    TTF_CloseFont(pFont);
+
+    int height = 1;
+    while(height < y + row_h + 1)
+        height <<= 1;
+
+    SDL_Surface* pPage = gfx::create_surface_alpha(GLYPH_ATLAS_WIDTH, height);
+
+    for(int i = 0; i < count; ++i)
+    {
+        if(pAllGlyphs[i] == NULL)
+            continue;
+
+        Glyph& Current = m_Glyphs[i];
+
+        // Copy the alpha channel as-is rather than blending it.
+        SDL_SetAlpha(pAllGlyphs[i], 0, SDL_ALPHA_TRANSPARENT);
+        SDL_Rect Dest = {(Sint16)Current.TexCoords.x,
+            (Sint16)Current.TexCoords.y, 0, 0};
+        SDL_BlitSurface(pAllGlyphs[i], NULL, pPage, &Dest);
+        SDL_FreeSurface(pAllGlyphs[i]);
+
+        Current.TexCoords = math::CRectf(
+            Current.TexCoords.x / GLYPH_ATLAS_WIDTH,
+            Current.TexCoords.y / height,
+            Current.TexCoords.w / GLYPH_ATLAS_WIDTH,
+            Current.TexCoords.h / height);
+    }
+
+    if(m_texture != 0)
+        glDeleteTextures(1, &m_texture);
+
+    m_texture = gfx::SDL_Surface_to_texture(pPage);
+    SDL_FreeSurface(pPage);
+
+    return (m_texture != 0);
+}
+
+/**
+ * Retrieves a glyph.
+ *
+ * @param char Character
+ * @return The glyph, NULL if it isn't in the atlas.
+ **/
+const CGlyphAtlas::Glyph* CGlyphAtlas::GetGlyph(const char c) const
+{
+    if(c < FIRST_GLYPH || c > LAST_GLYPH)
+        return NULL;
+
+    return &m_Glyphs[c - FIRST_GLYPH];
+}
+
+GLuint CGlyphAtlas::GetTexture() const
+{
+    return m_texture;
+}
+
+/**
+ * Retrieves the distance between two lines of text.
+ * @return The line skip, in pixels.
+ **/
+int CGlyphAtlas::GetLineSkip() const
+{
+    return m_line_skip;
+}
+
+/**
+ * Retrieves the height of a single line of text.
+ * @return The line height, in pixels.
+ **/
+int CGlyphAtlas::GetHeight() const
+{
+    return m_height;
+}
+
+u_int CGlyphAtlas::GetSize() const
+{
+    return m_size;
+}
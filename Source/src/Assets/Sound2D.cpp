@@ -12,13 +12,17 @@ using asset::CSound2D;
 using game::g_Log;
 
 std::vector<CSound2D*> CSound2D::mp_allSounds;
+bool CSound2D::s_null_device = false;
 
 CSound2D::CSound2D() : m_buffer(0), m_source(-1),
     m_lasterror(AL_NO_ERROR) { CSound2D::mp_allSounds.push_back(this); }
 
 CSound2D::~CSound2D()
 {
-    if(s_sources[m_source] != 0)
+    if(s_null_device)
+        return;
+
+    if(m_source != -1 && s_sources[m_source] != 0)
     {
         alDeleteSources(1, &s_sources[m_source]);
         s_sources[m_source] = 0;
@@ -27,10 +31,25 @@ CSound2D::~CSound2D()
     alDeleteBuffers(1, &m_buffer);
 }
 
-bool CSound2D::InitializeOpenAL()
+/**
+ * Initializes OpenAL and ALUT.
+ *  The null device skips OpenAL entirely, for running without any
+ *  audio hardware: sounds "load" without reading their files, and
+ *  playing them does nothing.
+ *
+ * @param bool Use the null device instead of OpenAL (optional)
+ * @return TRUE if audio is ready, FALSE if ALUT failed.
+ **/
+bool CSound2D::InitializeOpenAL(const bool null_device)
 {
     static bool once = false;
 
+    if(null_device)
+    {
+        s_null_device = true;
+        return true;
+    }
+
     if(!once)
     {
         memset(s_sources, 0, sizeof s_sources);
@@ -44,6 +63,15 @@ bool CSound2D::InitializeOpenAL()
     return true;
 }
 
+/**
+ * Checks if sounds are silently ignored.
+ * @return TRUE if the null device is in use, FALSE otherwise.
+ **/
+bool CSound2D::IsNullDevice()
+{
+    return s_null_device;
+}
+
 void CSound2D::GetAvailableSource()
 {
     // First, check if the current available source is
@@ -129,6 +157,13 @@ bool CSound2D::LoadFromFile(const char* p_filename)
 
     m_lasterror = AL_NO_ERROR;
 
+    if(s_null_device && p_filename != NULL)
+    {
+        m_filename  = p_filename;
+        m_loaded    = true;
+        return true;
+    }
+
     // Check if there's already something loaded.
     if(m_buffer != 0)
     {
@@ -218,6 +253,9 @@ bool CSound2D::LoadFromFile(const char* p_filename)
  **/
 bool CSound2D::Play()
 {
+    if(s_null_device)
+        return true;
+
     if(this->GetAudioState() == AL_PLAYING)
     {
         alSourcePlay(s_sources[m_source]);
@@ -4,6 +4,23 @@ using asset::CTexture;
 
 bool CTexture::LoadFromFile(const char* pfilename)
 {
+    // Only the size matters with the null renderer.
+    if(gfx::is_headless())
+    {
+        SDL_Surface* pImage = gfx::load_image(pfilename);
+        if(pImage == NULL)
+            return false;
+
+        m_Size.Resize(pImage->w, pImage->h);
+        SDL_FreeSurface(pImage);
+
+        m_texture   = 0;
+        m_filename  = pfilename;
+        m_loaded    = true;
+        m_owner     = false;
+        return true;
+    }
+
     if((m_texture = gfx::load_texture(pfilename)) <= 0)
         return false;
     else
@@ -20,10 +37,35 @@ bool CTexture::LoadFromFile(const char* pfilename)
         m_Size.Resize(w, h);
         m_filename  = pfilename;
         m_loaded    = true;
+        m_owner     = true;
         return true;
     }
 }
 
+/**
+ * Sets up the texture as part of an atlas page.
+ *
+ * @param char* Filename of the original image
+ * @param GLuint Atlas page texture, which isn't owned by this texture
+ * @param u_int Image width
+ * @param u_int Image height
+ * @param math::CRectf& UV window on the page
+ *
+ * @return TRUE.
+ * @see asset::CTextureAtlas::Upload()
+ **/
+bool CTexture::LoadFromAtlas(const char* pfilename, const GLuint page,
+    const u_int w, const u_int h, const math::CRectf& UV)
+{
+    m_texture   = page;
+    m_UV        = UV;
+    m_filename  = pfilename;
+    m_loaded    = true;
+    m_owner     = false;
+    m_Size.Resize(w, h);
+    return true;
+}
+
 GLuint CTexture::GetTexture() const
 {
     return m_texture;
@@ -39,10 +81,28 @@ GLint CTexture::GetH() const
     return m_Size.h;
 }
 
+/**
+ * Retrieves the part of the GL texture this texture covers.
+ * @return The UV window, (0, 0, 1, 1) unless it's on an atlas page.
+ **/
+const math::CRectf& CTexture::GetUV() const
+{
+    return m_UV;
+}
+
 bool CTexture::LoadFromSurface(SDL_Surface* pSurface)
 {
     if(pSurface == NULL) return false;
 
+    if(gfx::is_headless())
+    {
+        m_texture = 0;
+        m_Size.Resize(pSurface->w, pSurface->h);
+        m_loaded  = true;
+        m_owner   = false;
+        return true;
+    }
+
     if((m_texture = gfx::SDL_Surface_to_texture(pSurface)) < 0)
         return false;
     else
@@ -58,6 +118,7 @@ bool CTexture::LoadFromSurface(SDL_Surface* pSurface)
 
         m_Size.Resize(w, h);
         m_loaded = true;
+        m_owner  = true;
         return true;
     }
 }
@@ -0,0 +1,471 @@
+/**
+ * @file
+ *  Definitions for the CTextureAtlas class.
+ *
+ * @author George Kudrayvtsev
+ * @version 1.0
+ **/
+
+#include "Assets/TextureAtlas.hpp"
+
+using asset::CTextureAtlas;
+
+CTextureAtlas::CTextureAtlas() : m_page_size(0) {}
+
+CTextureAtlas::~CTextureAtlas()
+{
+    this->ClearPages();
+
+    if(!m_textures.empty() && !gfx::is_headless())
+        glDeleteTextures(m_textures.size(), &m_textures[0]);
+}
+
+/**
+ * Adds an image to be packed.
+ *
+ * @param char* Image filename
+ * @return TRUE if the image exists, FALSE otherwise.
+ **/
+bool CTextureAtlas::AddFile(const char* pfilename)
+{
+    for(size_t i = 0; i < m_Entries.size(); ++i)
+        if(m_Entries[i].filename == pfilename)
+            return true;
+
+    Entry Image;
+    Image.filename  = pfilename;
+    Image.file_size = CTextureAtlas::GetFileSize(pfilename);
+    Image.page      = -1;
+
+    if(Image.file_size == 0)
+    {
+        g_Log.Flush();
+        g_Log << "[ERROR] Can't add " << pfilename << " to atlas.\n";
+        return false;
+    }
+
+    m_Entries.push_back(Image);
+    return true;
+}
+
+/**
+ * Adds every image in a list file.
+ *  The list has one filename per line, with lines starting
+ *  with '/' treated as comments (same as Data/Levels/ValidNames.dat).
+ *
+ * @param char* List filename
+ * @return TRUE if the list was read, FALSE otherwise.
+ **/
+bool CTextureAtlas::AddList(const char* plistname)
+{
+    std::ifstream list(plistname);
+    std::string line;
+
+    if(!list.is_open())
+    {
+        g_Log.Flush();
+        g_Log << "[ERROR] Failed to open atlas list: " << plistname << ".\n";
+        return false;
+    }
+
+    while(std::getline(list, line))
+    {
+        if(line.empty() || line[0] == '/')
+            continue;
+
+        this->AddFile(line.c_str());
+    }
+
+    list.close();
+    return true;
+}
+
+/**
+ * Loads every added image and packs them onto pages.
+ *  Images are placed on shelves, tallest first, starting a new
+ *  page whenever one fills up.
+ *
+ * @param u_int Page width and height, in pixels (optional)
+ * @param u_int Padding around each image, in pixels (optional)
+ *
+ * @return TRUE if everything was packed, FALSE if an image
+ *  failed to load.
+ **/
+bool CTextureAtlas::Pack(const u_int page_size, const u_int padding)
+{
+    this->ClearPages();
+    m_page_size = page_size;
+
+    // Get everything into the page format first.
+    SDL_Surface* pFormat = SDL_CreateRGBSurface(SDL_SWSURFACE, 1, 1, 32,
+        rmask, gmask, bmask, amask);
+
+    std::vector<std::pair<int, SDL_Surface*> > Images;
+    bool success = true;
+
+    for(size_t i = 0; i < m_Entries.size(); ++i)
+    {
+        m_Entries[i].page = -1;
+
+        SDL_Surface* pImage = IMG_Load(m_Entries[i].filename.c_str());
+        if(pImage == NULL)
+        {
+            g_Log.Flush();
+            g_Log << "[ERROR] Failed to load " << m_Entries[i].filename;
+            g_Log << " for atlas.\n";
+            success = false;
+            continue;
+        }
+
+        SDL_Surface* pConverted = SDL_ConvertSurface(pImage,
+            pFormat->format, SDL_SWSURFACE);
+        SDL_FreeSurface(pImage);
+
+        if(pConverted != NULL)
+            Images.push_back(std::make_pair((int)i, pConverted));
+    }
+
+    SDL_FreeSurface(pFormat);
+    std::stable_sort(Images.begin(), Images.end(),
+        &CTextureAtlas::CompareHeight);
+
+    // Current shelf on the current page.
+    int shelf_x = 0, shelf_y = 0, shelf_h = 0;
+
+    for(size_t i = 0; i < Images.size(); ++i)
+    {
+        Entry& Image = m_Entries[Images[i].first];
+        SDL_Surface* pImage = Images[i].second;
+
+        int w = pImage->w + 2 * padding;
+        int h = pImage->h + 2 * padding;
+
+        if(w > (int)page_size || h > (int)page_size)
+        {
+            SDL_FreeSurface(pImage);
+            continue;
+        }
+
+        // Doesn't fit on this shelf, start another.
+        if(shelf_x + w > (int)page_size)
+        {
+            shelf_y += shelf_h;
+            shelf_x = shelf_h = 0;
+        }
+
+        // Doesn't fit on this page, start another.
+        if(mp_allPages.empty() || shelf_y + h > (int)page_size)
+        {
+            mp_allPages.push_back(SDL_CreateRGBSurface(SDL_SWSURFACE,
+                page_size, page_size, 32, rmask, gmask, bmask, amask));
+            shelf_x = shelf_y = shelf_h = 0;
+        }
+
+        Image.page = mp_allPages.size() - 1;
+        Image.Region = math::CRect(shelf_x + padding, shelf_y + padding,
+            pImage->w, pImage->h);
+
+        CTextureAtlas::CopyImage(pImage, mp_allPages.back(),
+            Image.Region.x, Image.Region.y, padding);
+        SDL_FreeSurface(pImage);
+
+        shelf_x += w;
+        shelf_h  = max(shelf_h, h);
+    }
+
+    g_Log.Flush();
+    g_Log << "[INFO] Packed " << Images.size() << " images onto ";
+    g_Log << mp_allPages.size() << " atlas page(s).\n";
+    g_Log.ShowLastLog();
+
+    return success;
+}
+
+/**
+ * Writes the packed atlas to disk.
+ *  The index goes to <prefix>.cai, and every page to <prefix>.<n>.cap.
+ *
+ * @param char* Path and name to save under, without an extension
+ * @return TRUE on success, FALSE otherwise.
+ *
+ * @pre Pack() has been called.
+ **/
+bool CTextureAtlas::Save(const char* pprefix) const
+{
+    std::string index_name = std::string(pprefix) + ATLAS_INDEX_EXT;
+    std::ofstream index(index_name.c_str());
+
+    if(!index.is_open())
+    {
+        g_Log.Flush();
+        g_Log << "[ERROR] Failed to save atlas index: " << index_name << ".\n";
+        return false;
+    }
+
+    index << "// This atlas has been automatically generated, ";
+    index << "delete it to repack.\n";
+    index << "size=" << m_page_size << "\n";
+
+    for(size_t i = 0; i < mp_allPages.size(); ++i)
+    {
+        std::stringstream page_name;
+        page_name << pprefix << "." << i << ATLAS_PAGE_EXT;
+
+        std::ofstream page(page_name.str().c_str(), std::ios::binary);
+        if(!page.is_open())
+        {
+            g_Log.Flush();
+            g_Log << "[ERROR] Failed to save atlas page: ";
+            g_Log << page_name.str() << ".\n";
+            return false;
+        }
+
+        // Raw RGBA, row by row.
+        SDL_Surface* pPage = mp_allPages[i];
+        for(int y = 0; y < pPage->h; ++y)
+        {
+            page.write((char*)pPage->pixels + y * pPage->pitch,
+                pPage->w * 4);
+        }
+
+        page.close();
+        index << "page=" << page_name.str() << "\n";
+    }
+
+    // Format is filename:page,x,y,w,h,file size
+    for(size_t i = 0; i < m_Entries.size(); ++i)
+    {
+        const Entry& Image = m_Entries[i];
+        index << Image.filename << ":" << Image.page << ",";
+        index << Image.Region.x << "," << Image.Region.y << ",";
+        index << Image.Region.w << "," << Image.Region.h << ",";
+        index << Image.file_size << "\n";
+    }
+
+    index.close();
+    return true;
+}
+
+/**
+ * Loads an atlas saved by a previous run.
+ *  The saved atlas is only used if it has every added image in it,
+ *  and none of the images changed size on disk since.
+ *
+ * @param char* Path and name the atlas was saved under
+ * @return TRUE if the saved atlas can be used, FALSE if it has
+ *  to be packed again.
+ *
+ * @see CTextureAtlas::Save()
+ **/
+bool CTextureAtlas::Load(const char* pprefix)
+{
+    this->ClearPages();
+
+    std::string index_name = std::string(pprefix) + ATLAS_INDEX_EXT;
+    std::ifstream index(index_name.c_str());
+    std::vector<std::string> page_names;
+    std::vector<Entry> Saved;
+    std::string line;
+
+    if(!index.is_open())
+        return false;
+
+    while(std::getline(index, line))
+    {
+        if(line.empty() || line[0] == '/')
+            continue;
+
+        if(line.find("size=") == 0)
+        {
+            m_page_size = atoi(line.c_str() + 5);
+            continue;
+        }
+
+        if(line.find("page=") == 0)
+        {
+            page_names.push_back(line.substr(5));
+            continue;
+        }
+
+        std::vector<std::string> parts = gk::split(line, ':');
+        if(parts.size() != 2)
+            continue;
+
+        std::vector<std::string> values = gk::split(parts[1], ',');
+        if(values.size() != 6)
+            continue;
+
+        Entry Image;
+        Image.filename  = parts[0];
+        Image.page      = atoi(values[0].c_str());
+        Image.Region    = math::CRect(atoi(values[1].c_str()),
+            atoi(values[2].c_str()), atoi(values[3].c_str()),
+            atoi(values[4].c_str()));
+        Image.file_size = atoi(values[5].c_str());
+        Saved.push_back(Image);
+    }
+
+    index.close();
+
+    // Match up every added image.
+    for(size_t i = 0; i < m_Entries.size(); ++i)
+    {
+        size_t j = 0;
+        while(j < Saved.size() && Saved[j].filename != m_Entries[i].filename)
+            ++j;
+
+        if(j == Saved.size() || Saved[j].file_size != m_Entries[i].file_size ||
+           Saved[j].page >= (int)page_names.size())
+            return false;
+
+        m_Entries[i] = Saved[j];
+    }
+
+    for(size_t i = 0; i < page_names.size(); ++i)
+    {
+        std::ifstream page(page_names[i].c_str(), std::ios::binary);
+        if(!page.is_open() || m_page_size == 0)
+        {
+            this->ClearPages();
+            return false;
+        }
+
+        SDL_Surface* pPage = SDL_CreateRGBSurface(SDL_SWSURFACE,
+            m_page_size, m_page_size, 32, rmask, gmask, bmask, amask);
+        mp_allPages.push_back(pPage);
+
+        for(int y = 0; y < pPage->h; ++y)
+        {
+            page.read((char*)pPage->pixels + y * pPage->pitch,
+                pPage->w * 4);
+        }
+
+        if(!page)
+        {
+            this->ClearPages();
+            return false;
+        }
+    }
+
+    g_Log.Flush();
+    g_Log << "[INFO] Loaded " << mp_allPages.size() << " atlas page(s) from ";
+    g_Log << index_name << ".\n";
+    g_Log.ShowLastLog();
+
+    return true;
+}
+
+/**
+ * Creates the page textures and registers all of the packed images.
+ *  The pages are freed from system memory afterwards. The null
+ *  renderer numbers the pages instead, so sprites are still batched
+ *  by page.
+ *
+ * @return TRUE on success, FALSE otherwise.
+ * @pre Pack() or Load() has been called.
+ **/
+bool CTextureAtlas::Upload()
+{
+    for(size_t i = 0; i < mp_allPages.size(); ++i)
+    {
+        GLuint texture = gfx::is_headless() ? (GLuint)(i + 1) :
+            gfx::SDL_Surface_to_texture(mp_allPages[i]);
+        if(texture == 0)
+            return false;
+
+        m_textures.push_back(texture);
+    }
+
+    const float size = (float)m_page_size;
+    for(size_t i = 0; i < m_Entries.size(); ++i)
+    {
+        const Entry& Image = m_Entries[i];
+        if(Image.page < 0)
+            continue;
+
+        asset::CTexture* pTexture = new asset::CTexture;
+        pTexture->LoadFromAtlas(Image.filename.c_str(),
+            m_textures[Image.page], Image.Region.w, Image.Region.h,
+            math::CRectf(Image.Region.x / size, Image.Region.y / size,
+                Image.Region.w / size, Image.Region.h / size));
+
+        if(!CAssetManager::Register(pTexture))
+            delete pTexture;
+    }
+
+    this->ClearPages();
+    return true;
+}
+
+/**
+ * Retrieves the number of atlas pages.
+ * @return The page count.
+ **/
+u_int CTextureAtlas::GetPageCount() const
+{
+    return max(mp_allPages.size(), m_textures.size());
+}
+
+/// Frees the system memory copies of the pages.
+void CTextureAtlas::ClearPages()
+{
+    for(size_t i = 0; i < mp_allPages.size(); ++i)
+        SDL_FreeSurface(mp_allPages[i]);
+
+    mp_allPages.clear();
+}
+
+/**
+ * Retrieves the size of a file.
+ *
+ * @param char* Filename
+ * @return The size in bytes, 0 if the file can't be opened.
+ **/
+u_int CTextureAtlas::GetFileSize(const char* pfilename)
+{
+    std::ifstream file(pfilename, std::ios::binary | std::ios::ate);
+    if(!file.is_open())
+        return 0;
+
+    return (u_int)file.tellg();
+}
+
+/**
+ * Copies an image onto a page, extending its edges into the padding.
+ *
+ * @param SDL_Surface* Image, in the page format
+ * @param SDL_Surface* Page
+ * @param int Image x-coordinate on the page
+ * @param int Image y-coordinate on the page
+ * @param int Padding around the image
+ **/
+void CTextureAtlas::CopyImage(SDL_Surface* pSrc, SDL_Surface* pPage,
+    const int x, const int y, const int padding)
+{
+    SDL_LockSurface(pSrc);
+    SDL_LockSurface(pPage);
+
+    for(int dy = -padding; dy < pSrc->h + padding; ++dy)
+    {
+        int sy = min(max(dy, 0), pSrc->h - 1);
+        Uint32* pSrcRow = (Uint32*)((Uint8*)pSrc->pixels + sy * pSrc->pitch);
+        Uint32* pDstRow = (Uint32*)((Uint8*)pPage->pixels +
+            (y + dy) * pPage->pitch);
+
+        for(int dx = -padding; dx < pSrc->w + padding; ++dx)
+        {
+            int sx = min(max(dx, 0), pSrc->w - 1);
+            pDstRow[x + dx] = pSrcRow[sx];
+        }
+    }
+
+    SDL_UnlockSurface(pPage);
+    SDL_UnlockSurface(pSrc);
+}
+
+/// Sorts images tallest-first, which packs shelves much tighter.
+bool CTextureAtlas::CompareHeight(const std::pair<int, SDL_Surface*>& One,
+    const std::pair<int, SDL_Surface*>& Two)
+{
+    return One.second->h > Two.second->h;
+}
@@ -67,6 +67,7 @@
  **/
 
 #include "Engine.hpp"
+#include "Tools/Bench.hpp"
 
 // Link OpenGL and GLEW libraries.
 // These are located in the system path
@@ -89,14 +90,25 @@
 using game::g_Log;
 
 // Function headers
-bool init();
-void quit();
+bool init(const bool headless);
+void quit(const bool headless);
 
 /**
  * Executes the program.
+ *  Running "Collapse -headless N" simulates N ticks of the game world
+ *  with no window or audio and reports how fast it went, instead of
+ *  starting the game. "Collapse -compile N" compiles the text maps of
+ *  level N, and "Collapse -benchload N" times loading a generated
+ *  N x N tile level from text and compiled maps. "Collapse -batchcheck N"
+ *  checks that level N's terrain takes one draw call per atlas page.
+ *  "Collapse -benchgrid N" times tile lookups on a generated N x N
+ *  tile map against a linear scan, and "Collapse -benchpath N" times
+ *  N random paths on level 1 and on a generated maze. All of them run
+ *  headless.
+ *
  * @param int Argument count
  * @param char* Arguments
- * @return Zero, no matter what.
+ * @return Zero, unless a headless run failed.
  **/
 int main(int argc, char* argv[])
 {
@@ -117,12 +129,34 @@ int main(int argc, char* argv[])
     return 0;
     **/
 
-    // Seed rng.
-    srand(time(NULL));
+    u_int ticks = 0;
+    int compile = 0, bench = 0, batch = 0, grid = 0, paths = 0;
+    for(int i = 1; i + 1 < argc; ++i)
+    {
+        if(strcmp(argv[i], "-headless") == 0)
+            ticks = atoi(argv[i + 1]);
+        else if(strcmp(argv[i], "-compile") == 0)
+            compile = atoi(argv[i + 1]);
+        else if(strcmp(argv[i], "-benchload") == 0)
+            bench = atoi(argv[i + 1]);
+        else if(strcmp(argv[i], "-batchcheck") == 0)
+            batch = atoi(argv[i + 1]);
+        else if(strcmp(argv[i], "-benchgrid") == 0)
+            grid = atoi(argv[i + 1]);
+        else if(strcmp(argv[i], "-benchpath") == 0)
+            paths = atoi(argv[i + 1]);
+    }
+
+    const bool headless = (ticks > 0 || compile > 0 || bench > 0 ||
+        batch > 0 || grid > 0 || paths > 0);
+
+    // Seed rng, the same way every time for headless runs so they
+    // can be compared with each other.
+    srand(headless ? 1 : time(NULL));
 
     // Initialize all libraries.
     // If initialization fails, log the error and shut down.
-    if(!init())
+    if(!init(headless))
     {
         char* error = SDL_GetError();
         g_Log.Flush();
@@ -138,45 +172,90 @@ int main(int argc, char* argv[])
     g_Log << "false.\n";
 #endif _DEBUG
 
-    g_Log.Flush();
-    g_Log << "[INFO] Initializing game engine.\n";
+    int result = 0;
 
-    game::CEngine Collapse;
-    Collapse.Init();
-    Collapse.GameLoop();
+    if(compile > 0)
+    {
+        result = tools::compile_level(compile);
+    }
+    else if(bench > 0)
+    {
+        result = tools::benchmark_load(bench);
+    }
+    else if(batch > 0)
+    {
+        result = tools::check_batching(batch);
+    }
+    else if(grid > 0)
+    {
+        result = tools::benchmark_grid(grid);
+    }
+    else if(paths > 0)
+    {
+        result = tools::benchmark_paths(paths);
+    }
+    else if(headless)
+    {
+        result = tools::simulate(ticks);
+    }
+    else
+    {
+        g_Log.Flush();
+        g_Log << "[INFO] Initializing game engine.\n";
+
+        game::CEngine Collapse;
+        Collapse.Init();
+        Collapse.GameLoop();
+    }
+
+    // Linked programs are shared, so they outlive every shader.
+    gfx::CShader::ClearCache();
     
     // Log data and shut down libraries.
     g_Log.Flush();
     g_Log << "[INFO] Quitting library sub-systems.\n";
     g_Log.Close();
 
-    quit();
+    quit(headless);
 
-    return 0;
+    return result;
 }
 
 /**
  * Initialize SDL and all SDL dependent libraries.
+ *  Headless runs don't open a window, so they get the null
+ *  renderer and the null audio device instead.
+ *
+ * @param bool Skip video and audio
  * @return TRUE on successful initialization of ALL systems, FALSE otherwise.
  **/
-bool init()
+bool init(const bool headless)
 {
-    if(SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_TIMER) == -1)
+    Uint32 flags = headless ? SDL_INIT_TIMER :
+        (SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_TIMER);
+
+    if(SDL_Init(flags) == -1)
         return false;
     if(IMG_Init(IMG_INIT_PNG) != IMG_INIT_PNG)
         return false;
     if(TTF_Init() == -1)
         return false;
 
-    asset::CSound2D::InitializeOpenAL();
+    gfx::set_headless(headless);
+    asset::CSound2D::InitializeOpenAL(headless);
 
     return true;
 }
 
-/// Quit all SDL subsystems.
-void quit()
+/**
+ * Quit all SDL subsystems.
+ * @param bool Was it a headless run?
+ **/
+void quit(const bool headless)
 {
-    alutExit();
+    if(!headless)
+        alutExit();
+
     TTF_Quit();
     IMG_Quit();
     SDL_Quit();
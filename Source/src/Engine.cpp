@@ -62,6 +62,22 @@ bool CEngine::Init()
         gk::handle_error(g_Log.GetLastLog().c_str());
     }
 
+    // The simulation runs at game::SIM_RATE, whatever the frame rate is.
+    m_Timer.SetMaxSteps(g_Settings.GetInt("MaxSimSteps",
+        game::DEFAULT_MAX_STEPS));
+
+    // Pack level tiles and sprites onto shared pages, so CAssetManager
+    // hands out atlas textures for them instead of loading each one.
+    m_Atlas.AddList("Data/Levels/ValidNames.dat");
+    m_Atlas.AddList("Data/Textures/Atlas.dat");
+    if(!m_Atlas.Load("Data/Textures/Atlas"))
+    {
+        m_Atlas.Pack();
+        m_Atlas.Save("Data/Textures/Atlas");
+    }
+
+    m_Atlas.Upload();
+
     // Load the intro song.
     mp_IntroSong = CAssetManager::Create<asset::CSound2D>(
         "Data/Audio/Music/Intro.ogg");
@@ -125,6 +141,23 @@ bool CEngine::GameLoop()
         this->HandleGameEvents();
         this->HandleSystemEvents();
 
+#ifdef _DEBUG
+        // Pick up edits to the settings file without restarting.
+        if(g_Settings.CheckForChanges())
+        {
+            g_Log.Flush();
+            g_Log << "[INFO] Reloaded Data/Settings.ini.\n";
+            g_Log.ShowLastLog();
+        }
+#endif // _DEBUG
+
+        // Every frame is drawn, even when no tick is due, since the
+        // world is drawn part way between ticks. The frame rate is
+        // only capped by DelayFPS() (or vsync) at the end.
+        u_int steps = 0;
+        if(m_state == game::e_GAME)
+            steps = m_Timer.Advance();
+
         // Rendering
         m_GameWindow.Clear();
         switch(m_state)
@@ -217,8 +250,11 @@ bool CEngine::GameLoop()
                 m_IngameCursor.Move(game::GetMousePosition());
                 m_IngameCursor.Move_Rate(-16, -16);
 
+                for(u_int step = 0; step < steps; ++step)
+                    m_World.Tick();
+
                 // Rendering
-                m_World.Update();
+                m_World.Render(m_Timer.GetAlpha());
                 m_IngameCursor.Update();
                 break;
             }
@@ -261,8 +297,18 @@ bool CEngine::GameLoop()
         // Show frame-rate in debug builds
         Uint32 elapsed = SDL_GetTicks() - start_time;
         double fps = frame / (elapsed / 1000.0);
-        printf("Frame Rate: %0.2f\r", fps);
+        const gfx::CCompositor& Passes = m_World.GetCompositor();
+        printf("Frame Rate: %0.2f, draw calls: %u, pairs: %u/%u, "
+            "GPU ms: %0.2f/%0.2f/%0.2f\r", fps,
+            gfx::CSpriteBatch::GetTotalDrawCalls(),
+            m_World.GetBroadPhase().GetPairCount(),
+            m_World.GetBroadPhase().GetTestCount(),
+            Passes.GetPassTime(gfx::CCompositor::e_PASS_SCENE),
+            Passes.GetPassTime(gfx::CCompositor::e_PASS_LIGHTING),
+            Passes.GetPassTime(gfx::CCompositor::e_PASS_POST));
 #endif // REGULATE_FPS
+
+        gfx::CSpriteBatch::ResetTotalDrawCalls();
     }
 
     return (m_state == game::e_QUIT);
@@ -309,6 +355,8 @@ void CEngine::HandleGameEvents()
 
             if(m_state == game::e_GAME)
             {
+                // Don't catch up on time spent outside of the game.
+                m_Timer.ResetClock();
                 SDL_ShowCursor(0);
                 m_MusicPlayer.Stop();
                 m_World.HandleGameEvent(pLatest);
@@ -0,0 +1,121 @@
+/**
+ * @file
+ *  Definitions for the CCompositor class.
+ *
+ * @author George Kudrayvtsev
+ * @version 1.0
+ **/
+
+#include "Graphics/Compositor.hpp"
+
+using gfx::CCompositor;
+
+CCompositor::CCompositor() : m_current(0) {}
+
+CCompositor::~CCompositor()
+{}
+
+/**
+ * Creates the offscreen targets.
+ *
+ * @param u_int Screen width, in pixels
+ * @param u_int Screen height, in pixels
+ *
+ * @return TRUE if every target was created, FALSE otherwise.
+ **/
+bool CCompositor::Init(const u_int w, const u_int h)
+{
+    return m_Scene.Create(w, h) &&
+           m_Post[0].Create(w, h) &&
+           m_Post[1].Create(w, h);
+}
+
+/**
+ * Adds a post effect, run after the ones already added.
+ *  The effect's shader reads the frame so far from its first
+ *  texture unit, and is run over every pixel.
+ *
+ * @param gfx::CShader* Effect shader, must outlive the compositor
+ **/
+void CCompositor::AddEffect(gfx::CShader* pEffect)
+{
+    mp_allEffects.push_back(pEffect);
+}
+
+/// Starts drawing the (unlit) scene.
+void CCompositor::BeginScene()
+{
+    if(gfx::is_headless())
+        return;
+
+    m_Timers[e_PASS_SCENE].Begin();
+    m_Scene.Bind();
+    glClear(GL_COLOR_BUFFER_BIT);
+}
+
+/**
+ * Lights the scene, once per pixel.
+ *  Anything drawn after this goes on top of the lit scene.
+ *
+ * @param gfx::CShader& Lighting shader, reading the scene from its
+ *  first texture unit
+ *
+ * @pre BeginScene() has been called.
+ **/
+void CCompositor::Light(gfx::CShader& Lighting)
+{
+    if(gfx::is_headless())
+        return;
+
+    m_Timers[e_PASS_SCENE].End();
+    m_Timers[e_PASS_LIGHTING].Begin();
+
+    m_current = 0;
+    m_Post[m_current].Bind();
+
+    Lighting.Link();
+    m_Scene.Draw();
+    Lighting.Unlink();
+
+    m_Timers[e_PASS_LIGHTING].End();
+}
+
+/**
+ * Runs the post effects, and draws the result to the screen.
+ * @pre Light() has been called.
+ **/
+void CCompositor::Present()
+{
+    if(gfx::is_headless())
+        return;
+
+    m_Timers[e_PASS_POST].Begin();
+
+    for(size_t i = 0; i < mp_allEffects.size(); ++i)
+    {
+        const u_int next = 1 - m_current;
+        m_Post[next].Bind();
+
+        mp_allEffects[i]->Link();
+        m_Post[m_current].Draw();
+        mp_allEffects[i]->Unlink();
+
+        m_current = next;
+    }
+
+    gfx::CRenderTarget::BindScreen();
+    m_Post[m_current].Draw();
+
+    m_Timers[e_PASS_POST].End();
+}
+
+/**
+ * Retrieves how long the GPU spent on a pass, a few frames ago.
+ *
+ * @param Pass Which pass
+ * @return GPU time, in milliseconds.
+ **/
+float CCompositor::GetPassTime(const Pass pass) const
+{
+    return m_Timers[pass].GetTime();
+}
@@ -0,0 +1,87 @@
+/**
+ * @file
+ *  Definitions for the CGPUTimer class.
+ *
+ * @author George Kudrayvtsev
+ * @version 1.0
+ **/
+
+#include "Graphics/GPUTimer.hpp"
+
+using gfx::CGPUTimer;
+
+CGPUTimer::CGPUTimer() : m_current(0), m_time(0.0f)
+{
+    memset(m_queries, 0, sizeof m_queries);
+    memset(m_pending, 0, sizeof m_pending);
+}
+
+CGPUTimer::~CGPUTimer()
+{
+    if(m_queries[0] != 0)
+        glDeleteQueries(GPU_TIMER_FRAMES, m_queries);
+}
+
+/**
+ * Starts timing everything drawn until End().
+ *  The query used the most frames ago is reused, after its
+ *  result is read if it's ready.
+ **/
+void CGPUTimer::Begin()
+{
+    if(gfx::is_headless() || !GLEW_ARB_timer_query)
+        return;
+
+    if(m_queries[0] == 0)
+        glGenQueries(GPU_TIMER_FRAMES, m_queries);
+
+    this->Collect();
+
+    m_current = (m_current + 1) % GPU_TIMER_FRAMES;
+
+    // Still not done after all this time, so its result is dropped.
+    m_pending[m_current] = false;
+    glBeginQuery(GL_TIME_ELAPSED, m_queries[m_current]);
+}
+
+/// Stops timing.
+void CGPUTimer::End()
+{
+    if(gfx::is_headless() || m_queries[0] == 0)
+        return;
+
+    glEndQuery(GL_TIME_ELAPSED);
+    m_pending[m_current] = true;
+}
+
+/**
+ * Retrieves the latest time measured.
+ * @return GPU time, in milliseconds.
+ **/
+float CGPUTimer::GetTime() const
+{
+    return m_time;
+}
+
+/// Reads the results of every finished query, oldest first.
+void CGPUTimer::Collect()
+{
+    for(u_int i = 1; i <= GPU_TIMER_FRAMES; ++i)
+    {
+        const u_int index = (m_current + i) % GPU_TIMER_FRAMES;
+        if(!m_pending[index])
+            continue;
+
+        GLint ready = GL_FALSE;
+        glGetQueryObjectiv(m_queries[index], GL_QUERY_RESULT_AVAILABLE,
+            &ready);
+        if(ready == GL_FALSE)
+            continue;
+
+        GLuint64 elapsed = 0;
+        glGetQueryObjectui64v(m_queries[index], GL_QUERY_RESULT, &elapsed);
+
+        m_pending[index] = false;
+        m_time = elapsed / 1000000.0f;
+    }
+}
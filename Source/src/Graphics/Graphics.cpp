@@ -10,14 +10,44 @@
 
 using game::g_Log;
 
+/// Set when running without a window, see gfx::set_headless().
+static bool s_headless = false;
+
+/**
+ * Switches to (or from) the null renderer.
+ *  With no window there's no OpenGL context to use: textures still
+ *  load their images (for their sizes) but are never uploaded,
+ *  shaders aren't compiled, and sprite batches draw nothing.
+ *
+ * @param bool TRUE to stop using OpenGL
+ * @pre No OpenGL resources have been created yet.
+ **/
+void gfx::set_headless(const bool headless)
+{
+    s_headless = headless;
+}
+
+/**
+ * Checks if the null renderer is in use.
+ * @return TRUE if OpenGL mustn't be used, FALSE otherwise.
+ * @see gfx::set_headless()
+ **/
+bool gfx::is_headless()
+{
+    return s_headless;
+}
+
 /**
  * Convert an SDL_Surface* to an OpenGL-compatible texture.
  * @param SDL_Surface* Source
- * @return Converted texture.
+ * @return Converted texture, 0 with the null renderer.
  **/
 u_int gfx::SDL_Surface_to_texture(SDL_Surface* pSrc)
 {
     u_int texture;
+
+    if(s_headless)
+        return 0;
     
     glGenTextures(1, &texture);
     glBindTexture(GL_TEXTURE_2D, texture);
@@ -84,4 +84,31 @@ float* CLight::GetColor()
 float CLight::GetBrightness()
 {
     return m_brightness;
-}
\ No newline at end of file
+}
+
+/**
+ * Finds how far the light reaches.
+ *  This is the distance at which the brightest color channel
+ *  falls to LIGHT_CUTOFF. The lighting shader fades the light out
+ *  smoothly towards it, so nothing past it is lit at all.
+ *
+ * @return The radius, in pixels.
+ **/
+float CLight::GetRadius() const
+{
+    float color = max(m_color[0], max(m_color[1], m_color[2]));
+
+    // Solve c + l*d + q*d^2 = color * brightness / cutoff for d.
+    float c = m_attenuation[0] - color * m_brightness / LIGHT_CUTOFF;
+    float l = m_attenuation[1];
+    float q = m_attenuation[2];
+
+    if(c >= 0.0f)
+        return 0.0f;
+    else if(q > 0.0f)
+        return (-l + sqrt(l * l - 4.0f * q * c)) / (2.0f * q);
+    else if(l > 0.0f)
+        return -c / l;
+
+    return LIGHT_INFINITE_RADIUS;
+}
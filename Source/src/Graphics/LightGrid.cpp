@@ -0,0 +1,225 @@
+/**
+ * @file
+ *  Definitions for the CLightGrid class.
+ *
+ * @author George Kudrayvtsev
+ * @version 1.0
+ **/
+
+#include "Graphics/LightGrid.hpp"
+
+using gfx::CLightGrid;
+
+CLightGrid::CLightGrid() : m_LightPos(gfx::INVALID_UNIFORM),
+    m_LightCol(gfx::INVALID_UNIFORM), m_LightAtt(gfx::INVALID_UNIFORM),
+    m_LightBrt(gfx::INVALID_UNIFORM), m_LightRad(gfx::INVALID_UNIFORM),
+    m_texture(0), m_tiles_x(0), m_tiles_y(0),
+    m_screen_w(0), m_screen_h(0) {}
+
+CLightGrid::~CLightGrid()
+{
+    if(m_texture != 0)
+        glDeleteTextures(1, &m_texture);
+}
+
+/**
+ * Sets up the tiles and the lighting shader to use them.
+ *  The shader is rebuilt with the tile layout, so it doesn't
+ *  depend on how many lights the level has.
+ *
+ * @param gfx::CShader& Lighting shader
+ * @param u_int Screen width, in pixels
+ * @param u_int Screen height, in pixels
+ *
+ * @return TRUE if everything was set up, FALSE if the shader
+ *  failed to build.
+ **/
+bool CLightGrid::Init(gfx::CShader& Shader, const u_int screen_w,
+    const u_int screen_h)
+{
+    m_screen_w = screen_w;
+    m_screen_h = screen_h;
+    m_tiles_x  = (screen_w + LIGHT_TILE_SIZE - 1) / LIGHT_TILE_SIZE;
+    m_tiles_y  = (screen_h + LIGHT_TILE_SIZE - 1) / LIGHT_TILE_SIZE;
+
+    m_Tiles.assign(m_tiles_x * m_tiles_y * MAX_TILE_LIGHTS, 0);
+    m_Uploaded.assign(m_Tiles.size(), 0);
+    m_TileCounts.assign(m_tiles_x * m_tiles_y, 0);
+
+    if(!Shader.SetMacro("MAX_LIGHTS", MAX_VISIBLE_LIGHTS) ||
+       !Shader.SetMacro("TILE_SIZE", LIGHT_TILE_SIZE) ||
+       !Shader.SetMacro("TILE_LIGHTS", MAX_TILE_LIGHTS))
+    {
+        return false;
+    }
+
+    m_LightPos = Shader.Find("light_pos");
+    m_LightCol = Shader.Find("light_col");
+    m_LightAtt = Shader.Find("light_att");
+    m_LightBrt = Shader.Find("light_brt");
+    m_LightRad = Shader.Find("light_rad");
+
+    int   unit[1]  = {1};
+    float tiles[2] = {(float)m_tiles_x, (float)m_tiles_y};
+    Shader.PassVariableiv("light_tiles", unit, 1, 1);
+    Shader.PassVariablefv("tile_count", tiles, 2, 1);
+
+    if(gfx::is_headless())
+        return true;
+
+    if(m_texture == 0)
+        glGenTextures(1, &m_texture);
+
+    // The tile lists live on the second texture unit, so sprites
+    // can keep binding theirs to the first.
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, m_texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE8,
+        m_tiles_x * MAX_TILE_LIGHTS, m_tiles_y, 0,
+        GL_LUMINANCE, GL_UNSIGNED_BYTE, &m_Uploaded[0]);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    glActiveTexture(GL_TEXTURE0);
+
+    return true;
+}
+
+/**
+ * Finds the lights on the screen and sorts them into tiles.
+ *  The visible lights are passed to the shader, which only uploads
+ *  them if they changed, and so is the tile texture.
+ *
+ * @param std::vector<gfx::CLight*>& Every light in the level
+ * @param math::CVector2& Camera offset (screen = world + offset)
+ * @param gfx::CShader& Lighting shader, as given to Init()
+ *
+ * @pre Init() has been called.
+ **/
+void CLightGrid::Update(const std::vector<gfx::CLight*>& allLights,
+    const math::CVector2& Offset, gfx::CShader& Shader)
+{
+    m_Positions.clear();
+    m_Colors.clear();
+    m_Attenuations.clear();
+    m_Brightnesses.clear();
+    m_Radii.clear();
+
+    std::fill(m_Tiles.begin(), m_Tiles.end(), 0);
+    std::fill(m_TileCounts.begin(), m_TileCounts.end(), 0);
+
+    for(size_t i = 0; i < allLights.size() &&
+        m_Brightnesses.size() < MAX_VISIBLE_LIGHTS; ++i)
+    {
+        gfx::CLight* pLight = allLights[i];
+
+        const float radius = pLight->GetRadius();
+        const float x = pLight->GetPosition()[0] + Offset.x;
+        const float y = pLight->GetPosition()[1] + Offset.y;
+
+        if(radius <= 0.0f || x + radius < 0.0f || y + radius < 0.0f ||
+           x - radius > m_screen_w || y - radius > m_screen_h)
+        {
+            continue;
+        }
+
+        const u_int index = m_Brightnesses.size();
+
+        // The shader wants them in world coordinates.
+        m_Positions.insert(m_Positions.end(),
+            pLight->GetPosition(), pLight->GetPosition() + 2);
+        m_Colors.insert(m_Colors.end(),
+            pLight->GetColor(), pLight->GetColor() + 3);
+        m_Attenuations.insert(m_Attenuations.end(),
+            pLight->GetAttenuation(), pLight->GetAttenuation() + 3);
+        m_Brightnesses.push_back(pLight->GetBrightness());
+        m_Radii.push_back(radius);
+
+        this->AddToTiles(index, x, y, radius);
+    }
+
+    const u_int count = m_Brightnesses.size();
+    if(count > 0)
+    {
+        Shader.SetUniform(m_LightPos, &m_Positions[0],    2, count);
+        Shader.SetUniform(m_LightCol, &m_Colors[0],       3, count);
+        Shader.SetUniform(m_LightAtt, &m_Attenuations[0], 3, count);
+        Shader.SetUniform(m_LightBrt, &m_Brightnesses[0], 1, count);
+        Shader.SetUniform(m_LightRad, &m_Radii[0],        1, count);
+    }
+
+    if(gfx::is_headless() || m_texture == 0)
+        return;
+
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, m_texture);
+
+    if(m_Tiles != m_Uploaded)
+    {
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0,
+            m_tiles_x * MAX_TILE_LIGHTS, m_tiles_y,
+            GL_LUMINANCE, GL_UNSIGNED_BYTE, &m_Tiles[0]);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+        m_Uploaded.swap(m_Tiles);
+    }
+
+    glActiveTexture(GL_TEXTURE0);
+}
+
+/**
+ * Retrieves the number of lights found on the screen by Update().
+ * @return The visible light count.
+ **/
+u_int CLightGrid::GetVisibleCount() const
+{
+    return m_Brightnesses.size();
+}
+
+/**
+ * Adds a light to every tile its circle overlaps.
+ *
+ * @param u_int Index of the light in the visible lights
+ * @param float Light x-coordinate, on the screen
+ * @param float Light y-coordinate, on the screen
+ * @param float Light radius
+ **/
+void CLightGrid::AddToTiles(const u_int index, const float x, const float y,
+    const float radius)
+{
+    const float size = (float)LIGHT_TILE_SIZE;
+
+    int x0 = (int)floor((x - radius) / size);
+    int y0 = (int)floor((y - radius) / size);
+    int x1 = (int)floor((x + radius) / size);
+    int y1 = (int)floor((y + radius) / size);
+
+    x0 = max(x0, 0); x1 = min(x1, (int)m_tiles_x - 1);
+    y0 = max(y0, 0); y1 = min(y1, (int)m_tiles_y - 1);
+
+    for(int ty = y0; ty <= y1; ++ty)
+    {
+        for(int tx = x0; tx <= x1; ++tx)
+        {
+            // Distance from the light to the nearest point of the tile.
+            float dx = max(tx * size - x, max(0.0f, x - (tx + 1) * size));
+            float dy = max(ty * size - y, max(0.0f, y - (ty + 1) * size));
+            if(dx * dx + dy * dy > radius * radius)
+                continue;
+
+            u_int tile = ty * m_tiles_x + tx;
+            if(m_TileCounts[tile] == MAX_TILE_LIGHTS)
+                continue;
+
+            m_Tiles[tile * MAX_TILE_LIGHTS + m_TileCounts[tile]] =
+                (unsigned char)(index + 1);
+            ++m_TileCounts[tile];
+        }
+    }
+}
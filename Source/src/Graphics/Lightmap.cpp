@@ -0,0 +1,327 @@
+/**
+ * @file
+ *  Definitions for the CLightmap class.
+ *
+ * @author George Kudrayvtsev
+ * @version 1.0
+ **/
+
+#include <fstream>
+
+#include "Graphics/Lightmap.hpp"
+
+using gfx::CLightmap;
+
+/// Identifies a lightmap file, and which version of the format it is.
+static const char LIGHTMAP_MAGIC[4] = {'C', 'L', 'M', '1'};
+
+/// Rows of texels given to a job thread at a time while baking.
+static const u_int LIGHTMAP_BAKE_GRAIN = 16;
+
+CLightmap::CLightmap() : m_Rect(gfx::INVALID_UNIFORM), m_texture(0),
+    m_w(0), m_h(0), m_texel(LIGHTMAP_TEXEL), m_key(0) {}
+
+CLightmap::~CLightmap()
+{
+    if(m_texture != 0)
+        glDeleteTextures(1, &m_texture);
+}
+
+/**
+ * Bakes lights into the lightmap.
+ *  Texels are lit as if by the lighting shader, so baked and
+ *  per-pixel lights look the same.
+ *
+ * @param std::vector<gfx::CLight*>& Lights that never move
+ * @param math::CRect& Area to cover, in world pixels
+ * @param unsigned long long Hash of the level's maps
+ **/
+void CLightmap::Bake(const std::vector<gfx::CLight*>& allLights,
+    const math::CRect& Bounds, const unsigned long long level_key)
+{
+    this->Prepare(allLights, Bounds, level_key);
+
+    m_texels.assign(m_w * m_h * 3, 0);
+    game::CJobSystem::GetInstance().ParallelFor(m_h, LIGHTMAP_BAKE_GRAIN,
+        &CLightmap::BakeRows, this);
+
+    this->Upload();
+}
+
+/**
+ * Loads a lightmap baked on an earlier run (or offline).
+ *  It's only used if it was baked from the same lights over the
+ *  same area of the same level maps, so a level whose lights or
+ *  walls changed is never lit wrong.
+ *
+ * @param char* Lightmap filename
+ * @param std::vector<gfx::CLight*>& Lights that never move
+ * @param math::CRect& Area to cover, in world pixels
+ * @param unsigned long long Hash of the level's maps
+ *
+ * @return TRUE if the lightmap was loaded, FALSE if it's missing
+ *  or out of date and needs to be baked.
+ **/
+bool CLightmap::LoadFromFile(const char* pfilename,
+    const std::vector<gfx::CLight*>& allLights,
+    const math::CRect& Bounds, const unsigned long long level_key)
+{
+    this->Prepare(allLights, Bounds, level_key);
+
+    std::ifstream file(pfilename, std::ios::in | std::ios::binary);
+
+    char magic[4];
+    unsigned long long key = 0;
+    u_int w = 0, h = 0;
+
+    if(!file.read(magic, sizeof magic) ||
+       !file.read((char*)&key, sizeof key) ||
+       !file.read((char*)&w, sizeof w) ||
+       !file.read((char*)&h, sizeof h))
+    {
+        return false;
+    }
+
+    if(memcmp(magic, LIGHTMAP_MAGIC, sizeof magic) != 0 ||
+       key != m_key || w != m_w || h != m_h)
+    {
+        return false;
+    }
+
+    m_texels.resize(m_w * m_h * 3);
+    if(!file.read((char*)&m_texels[0], m_texels.size()))
+    {
+        m_texels.clear();
+        return false;
+    }
+
+    this->Upload();
+    return true;
+}
+
+/**
+ * Saves the lightmap, to be loaded instead of baked next time.
+ *
+ * @param char* Lightmap filename
+ * @return TRUE if it was saved, FALSE otherwise.
+ **/
+bool CLightmap::SaveToFile(const char* pfilename) const
+{
+    if(m_texels.empty())
+        return false;
+
+    std::ofstream file(pfilename,
+        std::ios::out | std::ios::binary | std::ios::trunc);
+
+    file.write(LIGHTMAP_MAGIC, sizeof LIGHTMAP_MAGIC);
+    file.write((const char*)&m_key, sizeof m_key);
+    file.write((const char*)&m_w, sizeof m_w);
+    file.write((const char*)&m_h, sizeof m_h);
+    file.write((const char*)&m_texels[0], m_texels.size());
+
+    return file.good();
+}
+
+/**
+ * Tells the lighting shader where to find the lightmap.
+ *  The lightmap lives on the third texture unit, after the
+ *  sprites and the light tiles.
+ *
+ * @param gfx::CShader& Lighting shader
+ **/
+void CLightmap::Init(gfx::CShader& Shader)
+{
+    int   unit[1]  = {2};
+    float range[1] = {LIGHTMAP_RANGE};
+    Shader.PassVariableiv("lightmap", unit, 1, 1);
+    Shader.PassVariablefv("lightmap_range", range, 1, 1);
+
+    m_Rect = Shader.Find("lightmap_rect");
+}
+
+/**
+ * Binds the lightmap for the lighting shader to sample.
+ *
+ * @param gfx::CShader& Lighting shader, as given to Init()
+ * @pre Init() has been called.
+ **/
+void CLightmap::Update(gfx::CShader& Shader)
+{
+    // World origin, and what a world pixel is in texture coordinates.
+    float rect[4] = {(float)m_Bounds.x, (float)m_Bounds.y,
+        1.0f / (m_w * m_texel), 1.0f / (m_h * m_texel)};
+    Shader.SetUniform(m_Rect, rect, 4, 1);
+
+    if(gfx::is_headless() || m_texture == 0)
+        return;
+
+    glActiveTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_2D, m_texture);
+    glActiveTexture(GL_TEXTURE0);
+}
+
+/**
+ * Retrieves the width of the lightmap.
+ * @return The width, in texels.
+ **/
+u_int CLightmap::GetW() const
+{
+    return m_w;
+}
+
+/**
+ * Retrieves the height of the lightmap.
+ * @return The height, in texels.
+ **/
+u_int CLightmap::GetH() const
+{
+    return m_h;
+}
+
+/**
+ * Sizes the lightmap, and works out what's needed to bake it.
+ *  Texels grow past LIGHTMAP_TEXEL on levels too large to
+ *  fit in MAX_LIGHTMAP_SIZE otherwise.
+ *
+ * @param std::vector<gfx::CLight*>& Lights that never move
+ * @param math::CRect& Area to cover, in world pixels
+ * @param unsigned long long Hash of the level's maps
+ **/
+void CLightmap::Prepare(const std::vector<gfx::CLight*>& allLights,
+    const math::CRect& Bounds, const unsigned long long level_key)
+{
+    m_Bounds = Bounds;
+    m_texel  = LIGHTMAP_TEXEL;
+
+    while((Bounds.w + m_texel - 1) / m_texel > MAX_LIGHTMAP_SIZE ||
+          (Bounds.h + m_texel - 1) / m_texel > MAX_LIGHTMAP_SIZE)
+    {
+        m_texel *= 2;
+    }
+
+    m_w = max((Bounds.w + m_texel - 1) / m_texel, 1u);
+    m_h = max((Bounds.h + m_texel - 1) / m_texel, 1u);
+
+    m_Lights.clear();
+    for(size_t i = 0; i < allLights.size(); ++i)
+    {
+        gfx::CLight* pLight = allLights[i];
+        const float brightness = pLight->GetBrightness();
+
+        BakedLight Light;
+        Light.x      = pLight->GetPosition()[0];
+        Light.y      = pLight->GetPosition()[1];
+        Light.radius = pLight->GetRadius();
+
+        for(u_int j = 0; j < 3; ++j)
+        {
+            Light.color[j]       = pLight->GetColor()[j] * brightness;
+            Light.attenuation[j] = pLight->GetAttenuation()[j];
+        }
+
+        if(Light.radius > 0.0f)
+            m_Lights.push_back(Light);
+    }
+
+    // Anything that changes the texels changes the key.
+    int layout[5] = {m_Bounds.x, m_Bounds.y, (int)m_w, (int)m_h,
+        (int)m_texel};
+    m_key = gk::hash(layout, sizeof layout, level_key);
+    m_key = gk::hash(&LIGHTMAP_RANGE, sizeof LIGHTMAP_RANGE, m_key);
+    if(!m_Lights.empty())
+    {
+        m_key = gk::hash(&m_Lights[0],
+            m_Lights.size() * sizeof(BakedLight), m_key);
+    }
+}
+
+/// Creates the texture from the texels, unless there's no window.
+void CLightmap::Upload()
+{
+    if(gfx::is_headless())
+        return;
+
+    if(m_texture == 0)
+        glGenTextures(1, &m_texture);
+
+    glActiveTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_2D, m_texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, m_w, m_h, 0,
+        GL_RGB, GL_UNSIGNED_BYTE, &m_texels[0]);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    glActiveTexture(GL_TEXTURE0);
+}
+
+/**
+ * Bakes a range of rows, on a job thread.
+ *  Each light is only looked at across the texels within its
+ *  radius on the row.
+ *
+ * @param void* The CLightmap being baked
+ * @param u_int First row
+ * @param u_int One past the last row
+ **/
+void CLightmap::BakeRows(void* pData, const u_int begin, const u_int end)
+{
+    CLightmap* pMap = static_cast<CLightmap*>(pData);
+    const float size = (float)pMap->m_texel;
+    const float left = (float)pMap->m_Bounds.x;
+    const int   last = (int)pMap->m_w - 1;
+
+    std::vector<float> row(pMap->m_w * 3);
+
+    for(u_int ty = begin; ty < end; ++ty)
+    {
+        std::fill(row.begin(), row.end(), 0.0f);
+
+        // Texels are lit at their centers.
+        const float y = pMap->m_Bounds.y + (ty + 0.5f) * size;
+
+        for(size_t i = 0; i < pMap->m_Lights.size(); ++i)
+        {
+            const BakedLight& Light = pMap->m_Lights[i];
+            const float dy = y - Light.y;
+            if(fabs(dy) >= Light.radius)
+                continue;
+
+            const float reach = sqrt(Light.radius * Light.radius - dy * dy);
+            int x0 = (int)ceil((Light.x - reach - left) / size - 0.5f);
+            int x1 = (int)floor((Light.x + reach - left) / size - 0.5f);
+            x0 = max(x0, 0); x1 = min(x1, last);
+
+            for(int tx = x0; tx <= x1; ++tx)
+            {
+                const float dx   = left + (tx + 0.5f) * size - Light.x;
+                const float dist = sqrt(dx * dx + dy * dy);
+
+                // Same falloff as the lighting shader.
+                float att  = 1.0f / (Light.attenuation[0] +
+                                     Light.attenuation[1] * dist +
+                                     Light.attenuation[2] * dist * dist);
+                float fade = dist / Light.radius;
+                fade = 1.0f - fade * fade * fade * fade;
+                if(fade <= 0.0f)
+                    continue;
+
+                att *= fade * fade;
+                row[tx * 3 + 0] += Light.color[0] * att;
+                row[tx * 3 + 1] += Light.color[1] * att;
+                row[tx * 3 + 2] += Light.color[2] * att;
+            }
+        }
+
+        unsigned char* ptexels = &pMap->m_texels[ty * pMap->m_w * 3];
+        for(size_t i = 0; i < row.size(); ++i)
+        {
+            float value = row[i] / LIGHTMAP_RANGE * 255.0f + 0.5f;
+            ptexels[i] = (unsigned char)min(max(value, 0.0f), 255.0f);
+        }
+    }
+}
@@ -0,0 +1,93 @@
+/**
+ * @file
+ *  Definitions for the CLineBatch class.
+ *
+ * @author George Kudrayvtsev
+ * @version 1.0
+ **/
+
+#include "Graphics/LineBatch.hpp"
+
+using gfx::CLineBatch;
+
+CLineBatch::CLineBatch()
+{}
+
+CLineBatch::~CLineBatch()
+{}
+
+/// Starts collecting lines, dropping any from the last batch.
+void CLineBatch::Begin()
+{
+    m_Vertices.clear();
+}
+
+/**
+ * Queues up a line.
+ *
+ * @param float Start x-coordinate
+ * @param float Start y-coordinate
+ * @param float End x-coordinate
+ * @param float End y-coordinate
+ * @param gfx::Color& Line color, drawn opaque
+ **/
+void CLineBatch::DrawLine(const float x1, const float y1,
+    const float x2, const float y2, const gfx::Color& Color)
+{
+    Vertex Start = {x1, y1, Color.r, Color.g, Color.b, 255};
+    Vertex End   = {x2, y2, Color.r, Color.g, Color.b, 255};
+
+    m_Vertices.push_back(Start);
+    m_Vertices.push_back(End);
+}
+
+/**
+ * Queues up the outline of a rectangle.
+ *
+ * @param math::CRect& Rectangle
+ * @param gfx::Color& Outline color, drawn opaque
+ **/
+void CLineBatch::DrawRect(const math::CRect& Rect, const gfx::Color& Color)
+{
+    // Offset by half a pixel, so lines land on pixel centers.
+    const float left    = Rect.x + 0.5f;
+    const float top     = Rect.y + 0.5f;
+    const float right   = Rect.x + Rect.w - 0.5f;
+    const float bottom  = Rect.y + Rect.h - 0.5f;
+
+    this->DrawLine(left,  top,    right, top,    Color);
+    this->DrawLine(right, top,    right, bottom, Color);
+    this->DrawLine(right, bottom, left,  bottom, Color);
+    this->DrawLine(left,  bottom, left,  top,    Color);
+}
+
+/// Draws every line queued since Begin().
+void CLineBatch::End()
+{
+    if(m_Vertices.empty() || gfx::is_headless())
+        return;
+
+    glPushAttrib(GL_ENABLE_BIT | GL_CURRENT_BIT);
+    glDisable(GL_TEXTURE_2D);
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(2, GL_FLOAT, sizeof(Vertex), &m_Vertices[0].x);
+    glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), &m_Vertices[0].r);
+
+    glDrawArrays(GL_LINES, 0, m_Vertices.size());
+
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+
+    glPopAttrib();
+}
+
+/**
+ * Retrieves the number of lines in the batch.
+ * @return Lines queued since Begin().
+ **/
+u_int CLineBatch::GetLineCount() const
+{
+    return m_Vertices.size() / 2;
+}
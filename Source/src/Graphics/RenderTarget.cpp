@@ -0,0 +1,151 @@
+/**
+ * @file
+ *  Definitions for the CRenderTarget class.
+ *
+ * @author George Kudrayvtsev
+ * @version 1.0
+ **/
+
+#include "Graphics/RenderTarget.hpp"
+
+using gfx::CRenderTarget;
+using game::g_Log;
+
+CRenderTarget::CRenderTarget() : m_framebuffer(0), m_texture(0),
+    m_w(0), m_h(0) {}
+
+CRenderTarget::~CRenderTarget()
+{
+    this->Release();
+}
+
+/**
+ * Creates the framebuffer and the texture it draws into.
+ *
+ * @param u_int Width, in pixels
+ * @param u_int Height, in pixels
+ *
+ * @return TRUE if the target can be drawn into, FALSE otherwise.
+ **/
+bool CRenderTarget::Create(const u_int w, const u_int h)
+{
+    this->Release();
+
+    m_w = w;
+    m_h = h;
+
+    if(gfx::is_headless())
+        return true;
+
+    if(!GLEW_ARB_framebuffer_object && !GLEW_VERSION_3_0)
+    {
+        g_Log.Flush();
+        g_Log << "[ERROR] Framebuffer objects are not supported.\n";
+        return false;
+    }
+
+    glGenTextures(1, &m_texture);
+    glBindTexture(GL_TEXTURE_2D, m_texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, w, h, 0,
+        GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glGenFramebuffers(1, &m_framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+        GL_TEXTURE_2D, m_texture, 0);
+
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    if(status != GL_FRAMEBUFFER_COMPLETE)
+    {
+        g_Log.Flush();
+        g_Log << "[ERROR] Incomplete framebuffer (" << w << "x" << h;
+        g_Log << "), status " << status << ".\n";
+        this->Release();
+        return false;
+    }
+
+    return true;
+}
+
+/// Sends everything drawn from now on into the target.
+void CRenderTarget::Bind() const
+{
+    if(m_framebuffer != 0)
+        glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+}
+
+/// Sends everything drawn from now on to the window again.
+void CRenderTarget::BindScreen()
+{
+    if(!gfx::is_headless())
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+/**
+ * Draws the target's texture over the whole screen.
+ *  What's there is replaced rather than blended with, and any
+ *  shader that's linked is run over every pixel once.
+ *
+ * @pre The projection is the window's, with no camera enabled.
+ **/
+void CRenderTarget::Draw() const
+{
+    if(m_texture == 0)
+        return;
+
+    glPushAttrib(GL_ENABLE_BIT);
+    glDisable(GL_BLEND);
+
+    const float w = (float)m_w, h = (float)m_h;
+    const GLfloat vertices[8] = {0.0f, 0.0f, w, 0.0f, w, h, 0.0f, h};
+
+    // The texture's first row is the bottom of the screen.
+    static const GLfloat tex_coords[8] = {0, 1, 1, 1, 1, 0, 0, 0};
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, m_texture);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glVertexPointer(2, GL_FLOAT, 0, vertices);
+    glTexCoordPointer(2, GL_FLOAT, 0, tex_coords);
+
+    glDrawArrays(GL_QUADS, 0, 4);
+
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+
+    glPopAttrib();
+}
+
+GLuint CRenderTarget::GetTexture() const
+{
+    return m_texture;
+}
+
+u_int CRenderTarget::GetW() const
+{
+    return m_w;
+}
+
+u_int CRenderTarget::GetH() const
+{
+    return m_h;
+}
+
+/// Deletes the framebuffer and its texture.
+void CRenderTarget::Release()
+{
+    if(m_framebuffer != 0)
+        glDeleteFramebuffers(1, &m_framebuffer);
+    if(m_texture != 0)
+        glDeleteTextures(1, &m_texture);
+
+    m_framebuffer = m_texture = 0;
+}
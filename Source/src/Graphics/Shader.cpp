@@ -1,210 +1,232 @@
+/**
+ * @file
+ *  Definitions for the CShader class.
+ *
+ * @author George Kudrayvtsev
+ * @version 1.0
+ **/
+
 #include "Graphics/Shader.hpp"
 
+#ifdef _WIN32
+  #include <direct.h>
+#else
+  #include <sys/stat.h>
+#endif // _WIN32
+
 using gfx::CShader;
 using game::g_Log;
 
-CShader::CShader() : m_vshader(0), m_fshader(0), m_program(0),
-    m_last_error(GL_NO_ERROR), mp_error_str(NULL) {}
+CShader::ProgramCache CShader::m_Programs;
 
-CShader::~CShader()
+/// Deepest #include nesting allowed, to catch files including each other.
+static const u_int MAX_INCLUDE_DEPTH = 8;
+
+/// Hashes a string, chaining on from an earlier hash.
+static unsigned long long hash_text(const std::string& text,
+    unsigned long long seed = gk::HASH_SEED)
 {
-    if(m_vshader > 0) glDeleteShader(m_vshader);
-    if(m_fshader > 0) glDeleteShader(m_fshader);
-    if(m_program > 0) glDeleteProgram(m_program);
+    return gk::hash(text.data(), text.length(), seed);
+}
 
-    ShaderI_It i;
-    for(i = m_iParams.begin();
-        i != m_iParams.end();)
-    {
-        delete[] i->second->m_pparams;
-        delete i->second;
+CShader::CShader() : mp_Program(NULL), m_program(0),
+    m_last_error(GL_NO_ERROR) {}
 
-        i = m_iParams.erase(i);
-    }
+CShader::~CShader()
+{
+    // The program belongs to the cache, it might still be shared.
+    if(mp_Program != NULL && mp_Program->pUser == this)
+        mp_Program->pUser = NULL;
+}
 
-    ShaderF_It j;
-    for(j = m_fParams.begin();
-        j != m_fParams.end();)
+/**
+ * Deletes every linked program.
+ * @pre No shader is used afterwards.
+ **/
+void CShader::ClearCache()
+{
+    for(ProgramCache::iterator i = m_Programs.begin();
+        i != m_Programs.end(); ++i)
     {
-        delete[] j->second->m_pparams;
-        delete j->second;
-        
-        j = m_fParams.erase(j);
+        glDeleteProgram(i->second.program);
     }
+
+    m_Programs.clear();
 }
 
+/**
+ * Loads a vertex and fragment shader and builds a program from them.
+ *
+ * @param char* Vertex shader filename
+ * @param char* Fragment shader filename
+ *
+ * @return TRUE if the program was built, FALSE otherwise.
+ **/
 bool CShader::LoadFromFile(const char* pvs_filename, 
     const char* pfs_filename)
 {
-    int length = 0;
+    std::string vs_src, fs_src;
 
-    m_vshader = this->LoadShaderFile(pvs_filename, GL_VERTEX_SHADER);
-    m_fshader = this->LoadShaderFile(pfs_filename, GL_FRAGMENT_SHADER);
-    
-    if(m_vshader <= 0 || m_fshader <= 0) return false;
-
-    // Create program object and attach shader.
-    m_program = glCreateProgram();
-    glAttachShader(m_program, m_vshader);
-    glAttachShader(m_program, m_fshader);
-
-    // Link program
-    glLinkProgram(m_program);
-    glGetProgramiv(m_program, GL_LINK_STATUS, &m_last_error);
-
-    if(m_last_error == GL_FALSE)
+    if(!this->ReadSource(pvs_filename, vs_src) ||
+       !this->ReadSource(pfs_filename, fs_src))
     {
-        // Get log length.
-        glGetProgramiv(m_program, GL_INFO_LOG_LENGTH, &length);
-
-        // Get log details.
-        if(mp_error_str != NULL)
-            delete[] mp_error_str;
-
-        mp_error_str = new char[length];
-        glGetProgramInfoLog(m_program, length, &length, mp_error_str);
-        glDeleteProgram(m_program);
-
-        g_Log.Flush();
-        g_Log << "[ERROR] Failed to link '" << pvs_filename << "'.\n";
-        g_Log << "[Error] OpenGL error: " << mp_error_str;
         return false;
     }
 
-    m_vsfn = pvs_filename;
-    m_fsfn = pfs_filename;
+    m_vsfn   = pvs_filename;
+    m_fsfn   = pfs_filename;
+    m_vs_src = vs_src;
+    m_fs_src = fs_src;
 
-    return true;
+    return this->Build();
 }
 
+/**
+ * Builds a program from shader source code.
+ *  #include lines can't be resolved without a file to be
+ *  relative to, so they're left alone.
+ *
+ * @param char* Vertex shader source
+ * @param char* Fragment shader source
+ *
+ * @return TRUE if the program was built, FALSE otherwise.
+ **/
 bool CShader::LoadFromSource(const char* pvs_src, const char* pfs_src)
 {
-    return (this->LoadShaderSource(pvs_src, GL_VERTEX_SHADER) &&
-        this->LoadShaderSource(pfs_src, GL_FRAGMENT_SHADER));
+    m_vsfn   = m_fsfn = "";
+    m_vs_src = pvs_src;
+    m_fs_src = pfs_src;
+
+    return this->Build();
 }
 
-void CShader::PassVariableiv(const char* pvar_name, int pvalues[],
-    u_int array_size, u_int array_count)
+/**
+ * Looks up a uniform, adding it to the table if it's new.
+ *  The handle stays valid for the life of the shader, even if
+ *  the program is reloaded.
+ *
+ * @param char* Uniform name, as in the shader source
+ * @return A handle to set the uniform with.
+ **/
+gfx::UniformHandle CShader::Find(const char* pvar_name)
 {
-    ShaderI_It ifinder = m_iParams.find((char* const)pvar_name);
-    
-    if(ifinder != m_iParams.end())
+    for(size_t i = 0; i < m_Uniforms.size(); ++i)
     {
-        delete[] ifinder->second->m_pparams;
-        ifinder->second->m_pparams      = new int[array_size * array_count];
-        ifinder->second->m_array_size   = array_size;
-        ifinder->second->m_array_count  = array_count;
-
-        for(u_int i = 0; i < array_size * array_count; ++i)
-            ifinder->second->m_pparams[i] = pvalues[i];
+        if(m_Uniforms[i].name == pvar_name)
+            return (UniformHandle)i;
     }
-    
-    gfx::ShaderParam<int>* pParam = new gfx::ShaderParam<int>;
-
-    pParam->m_pparams       = new int[array_count * array_size];
-    pParam->m_array_size    = array_size;
-    pParam->m_array_count   = array_count;
-
-    for(u_int i = 0; i < array_size * array_count; ++i)
-        pParam->m_pparams[i] = pvalues[i];
 
-    m_iParams[(char*)pvar_name] = pParam;
+    Uniform Fresh;
+    Fresh.name          = pvar_name;
+    Fresh.location      = -1;
+    Fresh.type          = GL_FLOAT;
+    Fresh.array_size    = 0;
+    Fresh.array_count   = 0;
+    Fresh.offset        = 0;
+    Fresh.capacity      = 0;
+    Fresh.dirty         = false;
+
+    if(m_program > 0 && !gfx::is_headless())
+        Fresh.location = glGetUniformLocation(m_program, pvar_name);
+
+    m_Uniforms.push_back(Fresh);
+    return (UniformHandle)(m_Uniforms.size() - 1);
 }
 
-void CShader::PassVariablefv(const char* pvar_name, float pvalues[],
-    u_int array_size, u_int array_count)
+/**
+ * Sets an integer uniform, or an array of them.
+ *  It's only uploaded by the next Link() if the values changed.
+ *
+ * @param UniformHandle Uniform from Find()
+ * @param int[] Values to pass to the shader
+ * @param u_int Components in each value, [1, 4]
+ * @param u_int Number of values, more than 1 for arrays
+ **/
+void CShader::SetUniform(const UniformHandle handle, const int pvalues[],
+    const u_int array_size, const u_int array_count)
 {
-    ShaderF_It ffinder = m_fParams.find((char* const)pvar_name);
+    UniformValue* pValues = this->Reserve(handle, GL_INT,
+        array_size, array_count);
 
-    if(ffinder != m_fParams.end())
-    {
-        delete[] ffinder->second->m_pparams;
-        ffinder->second->m_pparams      = new float[array_size * array_count];
-        ffinder->second->m_array_size   = array_size;
-        ffinder->second->m_array_count  = array_count;
+    if(pValues == NULL)
+        return;
 
-        for(u_int i = 0; i < array_size * array_count; ++i)
-            ffinder->second->m_pparams[i] = pvalues[i];
+    for(u_int i = 0; i < array_size * array_count; ++i)
+    {
+        if(pValues[i].i != pvalues[i])
+        {
+            pValues[i].i = pvalues[i];
+            m_Uniforms[handle].dirty = true;
+        }
     }
-    
-    gfx::ShaderParam<float>* pParam = new gfx::ShaderParam<float>;
+}
+
+/// @overload CShader::SetUniform(const UniformHandle, const int[], const u_int, const u_int)
+void CShader::SetUniform(const UniformHandle handle, const float pvalues[],
+    const u_int array_size, const u_int array_count)
+{
+    UniformValue* pValues = this->Reserve(handle, GL_FLOAT,
+        array_size, array_count);
 
-    pParam->m_pparams       = new float[array_count * array_size];
-    pParam->m_array_size    = array_size;
-    pParam->m_array_count   = array_count;
+    if(pValues == NULL)
+        return;
 
     for(u_int i = 0; i < array_size * array_count; ++i)
-        pParam->m_pparams[i] = pvalues[i];
+    {
+        if(pValues[i].f != pvalues[i])
+        {
+            pValues[i].f = pvalues[i];
+            m_Uniforms[handle].dirty = true;
+        }
+    }
+}
 
-    m_fParams[(char*)pvar_name] = pParam;
+/**
+ * Sets an integer uniform by name.
+ * @see CShader::SetUniform()
+ **/
+void CShader::PassVariableiv(const char* pvar_name, const int pvalues[],
+    u_int array_size, u_int array_count)
+{
+    this->SetUniform(this->Find(pvar_name), pvalues,
+        array_size, array_count);
 }
 
+/**
+ * Sets a float uniform by name.
+ * @see CShader::SetUniform()
+ **/
+void CShader::PassVariablefv(const char* pvar_name, const float pvalues[],
+    u_int array_size, u_int array_count)
+{
+    this->SetUniform(this->Find(pvar_name), pvalues,
+        array_size, array_count);
+}
+
+/**
+ * Starts using the shader.
+ *  Any uniforms that changed since the last call are uploaded, or
+ *  all of them if another shader used the same program since then.
+ *
+ * @return TRUE if there were no OpenGL errors, FALSE otherwise.
+ **/
 bool CShader::Link()
 {
     if(!this->IsLoaded()) return false;
-
-    // Iterators for passing parameters.
-    ShaderI_It i;
-    ShaderF_It f;
+    if(gfx::is_headless()) return true;
 
     glUseProgram(m_program);
 
-    // Pass integer parameters to the shader.
-    for(i = m_iParams.begin(); i != m_iParams.end(); ++i)
-    {
-        int loc = this->GetLocation(i->first);
-
-        switch(i->second->m_array_size)
-        {
-        case 1:
-            glUniform1iv(loc,
-                i->second->m_array_count,
-                i->second->m_pparams); break;
-
-        case 2:
-            glUniform2iv(loc,
-                i->second->m_array_count,
-                i->second->m_pparams); break;
-
-        case 3:
-            glUniform3iv(loc,
-                i->second->m_array_count,
-                i->second->m_pparams); break;
-
-        case 4:
-            glUniform4iv(loc,
-                i->second->m_array_count,
-                i->second->m_pparams); break;
-        }
-    }
+    const bool shared = (mp_Program->pUser != this);
+    mp_Program->pUser = this;
 
-    // Pass float parameters to the shader.
-    for(f = m_fParams.begin(); f != m_fParams.end(); ++f)
+    for(size_t i = 0; i < m_Uniforms.size(); ++i)
     {
-        int loc = this->GetLocation(f->first);
+        if(!m_Uniforms[i].dirty && !shared)
+            continue;
 
-        switch(f->second->m_array_size)
-        {
-        case 1:
-            glUniform1fv(loc,
-                f->second->m_array_count,
-                f->second->m_pparams); break;
-
-        case 2:
-            glUniform2fv(loc,
-                f->second->m_array_count,
-                f->second->m_pparams); break;
-
-        case 3:
-            glUniform3fv(loc,
-                f->second->m_array_count,
-                f->second->m_pparams); break;
-
-        case 4:
-            glUniform4fv(loc,
-                f->second->m_array_count,
-                f->second->m_pparams); break;
-        }
+        this->UploadUniform(m_Uniforms[i]);
+        m_Uniforms[i].dirty = false;
     }
 
     return ((m_last_error = glGetError()) == GL_NO_ERROR);
@@ -212,13 +234,18 @@ bool CShader::Link()
 
 bool CShader::Unlink()
 {
+    if(gfx::is_headless()) return true;
+
     glUseProgram(0);
     return ((m_last_error = glGetError()) == GL_NO_ERROR);
 }
 
 bool CShader::IsLoaded() const
 {
-    return (m_program > 0 && m_vshader > 0 && m_fshader > 0);
+    if(gfx::is_headless())
+        return !(m_vs_src.empty() || m_fs_src.empty());
+
+    return (m_program > 0);
 }
 
 int CShader::GetLocation(const char* pvar_name) const
@@ -226,41 +253,305 @@ int CShader::GetLocation(const char* pvar_name) const
     return glGetUniformLocation(m_program, pvar_name);
 }
 
-char* CShader::GetError() const
+const char* CShader::GetError() const
 {
-    return mp_error_str;
+    return m_error.c_str();
 }
 
-GLuint CShader::LoadShaderFile(const char* pfilename, const int shader_type)
+/**
+ * Makes room for a uniform's values.
+ *  If the values don't fit where they were, they're moved to the
+ *  end of the value table. Changing the layout marks the uniform
+ *  as changed.
+ *
+ * @param UniformHandle Uniform from Find()
+ * @param GLenum GL_INT or GL_FLOAT
+ * @param u_int Components in each value
+ * @param u_int Number of values
+ *
+ * @return The uniform's values, NULL if the handle is invalid.
+ **/
+CShader::UniformValue* CShader::Reserve(const UniformHandle handle,
+    const GLenum type, const u_int array_size, const u_int array_count)
 {
-    g_Log.Flush();
-    g_Log << "[INFO] Loading shader: " << pfilename << ".\n";
+    const u_int total = array_size * array_count;
+    if(handle < 0 || handle >= (int)m_Uniforms.size() || total == 0)
+        return NULL;
 
-    std::string source, line;
-    GLint length;
+    Uniform& Current = m_Uniforms[handle];
 
-    // Load shader file.
-    std::ifstream file;
-    file.open(pfilename);
+    if(total > Current.capacity)
+    {
+        Current.offset   = m_Values.size();
+        Current.capacity = total;
+        m_Values.resize(m_Values.size() + total);
+        Current.dirty    = true;
+    }
 
-    if(!file.is_open())
+    if(Current.type != type || Current.array_size != array_size ||
+       Current.array_count != array_count)
     {
-        mp_error_str = "File does not exist";
-        return 0;
+        Current.type        = type;
+        Current.array_size  = array_size;
+        Current.array_count = array_count;
+        Current.dirty       = true;
+    }
+
+    return &m_Values[Current.offset];
+}
+
+/**
+ * Looks up the location of every uniform in the current program.
+ *  Everything is marked as changed, since a new program starts off
+ *  with its uniforms cleared.
+ **/
+void CShader::ResolveUniforms()
+{
+    for(size_t i = 0; i < m_Uniforms.size(); ++i)
+    {
+        m_Uniforms[i].location = glGetUniformLocation(m_program,
+            m_Uniforms[i].name.c_str());
+        m_Uniforms[i].dirty = (m_Uniforms[i].capacity > 0);
+    }
+}
+
+/**
+ * Passes a uniform's values to the program.
+ * @pre The program is in use.
+ **/
+void CShader::UploadUniform(const Uniform& Current) const
+{
+    if(Current.location < 0 || Current.capacity == 0)
+        return;
+
+    const UniformValue* pValues = &m_Values[Current.offset];
+
+    // Both members of the union sit at its start, so the values
+    // can be handed over as a plain array.
+    if(Current.type == GL_INT)
+    {
+        const GLint* pints = &pValues->i;
+        switch(Current.array_size)
+        {
+        case 1: glUniform1iv(Current.location, Current.array_count, pints); break;
+        case 2: glUniform2iv(Current.location, Current.array_count, pints); break;
+        case 3: glUniform3iv(Current.location, Current.array_count, pints); break;
+        case 4: glUniform4iv(Current.location, Current.array_count, pints); break;
+        }
+    }
+    else
+    {
+        const GLfloat* pfloats = &pValues->f;
+        switch(Current.array_size)
+        {
+        case 1: glUniform1fv(Current.location, Current.array_count, pfloats); break;
+        case 2: glUniform2fv(Current.location, Current.array_count, pfloats); break;
+        case 3: glUniform3fv(Current.location, Current.array_count, pfloats); break;
+        case 4: glUniform4fv(Current.location, Current.array_count, pfloats); break;
+        }
+    }
+}
+
+/**
+ * Sets a macro and rebuilds the program if it changed.
+ *
+ * @param std::string& Macro name
+ * @param std::string& Macro value
+ *
+ * @return TRUE if the program is built, FALSE otherwise.
+ * @see CShader::SetMacro()
+ **/
+bool CShader::SetDefine(const std::string& name, const std::string& value)
+{
+    if(m_vs_src.empty() || m_fs_src.empty())
+        return false;
+
+    std::map<std::string, std::string>::iterator i = m_Defines.find(name);
+    if(i != m_Defines.end() && i->second == value && this->IsLoaded())
+        return true;
+
+    m_Defines[name] = value;
+    return this->Build();
+}
+
+/**
+ * Preprocesses the sources and switches over to their program.
+ *  If the same sources were built with the same macros before, the
+ *  linked program is reused. Otherwise, a saved binary of it is
+ *  tried before compiling from scratch.
+ *
+ * @return TRUE if the program is ready, FALSE otherwise.
+ **/
+bool CShader::Build()
+{
+    if(m_vs_src.empty() || m_fs_src.empty())
+        return false;
+
+    // Nothing to compile for the null renderer.
+    if(gfx::is_headless())
+        return true;
+
+    std::string vs_src = this->Preprocess(m_vs_src);
+    std::string fs_src = this->Preprocess(m_fs_src);
+
+    // Shaders can't see each other's source, so the split matters.
+    program_key key = hash_text(fs_src, hash_text(std::string(1, '\0'),
+        hash_text(vs_src)));
+
+    ProgramCache::iterator i = m_Programs.find(key);
+    if(i == m_Programs.end())
+    {
+        GLuint program = CShader::LoadProgramBinary(key);
+        if(program == 0)
+        {
+            program = this->LinkProgram(vs_src, fs_src);
+            if(program == 0)
+                return false;
+
+            CShader::SaveProgramBinary(key, program);
+        }
+
+        Program Fresh = {program, NULL};
+        i = m_Programs.insert(std::make_pair(key, Fresh)).first;
+    }
+
+    if(mp_Program != NULL && mp_Program->pUser == this)
+        mp_Program->pUser = NULL;
+
+    mp_Program = &i->second;
+    m_program  = mp_Program->program;
+
+    this->ResolveUniforms();
+    return true;
+}
+
+/**
+ * Reads a shader file, pulling in any files it #include's.
+ *  Included filenames are relative to the file including them.
+ *
+ * @param std::string& Shader filename
+ * @param std::string& Output source, appended to
+ * @param u_int How deep in #include's this file is (optional)
+ *
+ * @return TRUE if every file was read, FALSE otherwise.
+ **/
+bool CShader::ReadSource(const std::string& filename, std::string& source,
+    const u_int depth)
+{
+    if(depth == 0)
+    {
+        g_Log.Flush();
+        g_Log << "[INFO] Loading shader: " << filename << ".\n";
     }
 
+    std::ifstream file(filename.c_str(), std::ios::in);
+    if(!file.is_open() || depth > MAX_INCLUDE_DEPTH)
+    {
+        m_error = "Failed to read '" + filename + "'";
+
+        g_Log.Flush();
+        g_Log << "[ERROR] " << m_error << ".\n";
+        return false;
+    }
+
+    std::string directory, line;
+    size_t slash = filename.find_last_of("/\\");
+    if(slash != std::string::npos)
+        directory = filename.substr(0, slash + 1);
+
     while(std::getline(file, line))
     {
+        size_t start = line.find_first_not_of(" \t");
+        if(start != std::string::npos &&
+           line.compare(start, 8, "#include") == 0)
+        {
+            size_t open  = line.find('"', start);
+            size_t close = line.find('"', open + 1);
+            if(open != std::string::npos && close != std::string::npos)
+            {
+                if(!this->ReadSource(directory +
+                    line.substr(open + 1, close - open - 1),
+                    source, depth + 1))
+                {
+                    return false;
+                }
+
+                continue;
+            }
+        }
+
         source += line;
         source += '\n';
     }
-    file.close();
 
+    return true;
+}
+
+/**
+ * Writes the macros from SetMacro() into a source.
+ *  They go right after the #version line if there is one, and any
+ *  #define of the same macros already in the source is dropped.
+ *
+ * @param std::string& Shader source
+ * @return The source to compile.
+ **/
+std::string CShader::Preprocess(const std::string& source) const
+{
+    if(m_Defines.empty())
+        return source;
+
+    std::string defines, result, line;
+    for(std::map<std::string, std::string>::const_iterator i =
+        m_Defines.begin(); i != m_Defines.end(); ++i)
+    {
+        defines += "#define " + i->first + " " + i->second + "\n";
+    }
+
+    std::istringstream input(source);
+    bool placed = false;
+
+    while(std::getline(input, line))
+    {
+        std::istringstream words(line);
+        std::string directive, name;
+        words >> directive >> name;
+
+        if(directive == "#define" && m_Defines.count(name) > 0)
+            continue;
+
+        if(!placed && directive != "#version")
+        {
+            result += defines;
+            placed = true;
+        }
+
+        result += line;
+        result += '\n';
+    }
+
+    if(!placed)
+        result += defines;
+
+    return result;
+}
+
+/**
+ * Compiles a single shader.
+ *
+ * @param std::string& Preprocessed source
+ * @param int GL_VERTEX_SHADER or GL_FRAGMENT_SHADER
+ * @param std::string& Name to report errors with
+ *
+ * @return The shader, 0 on failure.
+ **/
+GLuint CShader::CompileShader(const std::string& source,
+    const int shader_type, const std::string& name)
+{
     const char* p_src = source.c_str();
+    GLint length = source.length();
 
     // Create and compile shader.
     GLuint shader = glCreateShader(shader_type);
-    length = source.length();
     glShaderSource(shader, 1, &p_src, &length);
     glCompileShader(shader);
 
@@ -269,60 +560,172 @@ GLuint CShader::LoadShaderFile(const char* pfilename, const int shader_type)
 
     if(m_last_error == GL_FALSE)
     {
-        // Get log length.
-        glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &length);
-
         // Get log details.
-        if(mp_error_str != NULL)
-            delete[] mp_error_str;
+        glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &length);
 
-        mp_error_str = new char[length];
-        glGetShaderInfoLog(shader, length, &length, mp_error_str);
+        std::vector<GLchar> log(length + 1, '\0');
+        glGetShaderInfoLog(shader, length, &length, &log[0]);
         glDeleteShader(shader);
+        m_error = &log[0];
 
         g_Log.Flush();
-        g_Log << "[ERROR] Failed to compile '" << pfilename << "'.\n";
-        g_Log << "[Error] OpenGL error: " << mp_error_str;
+        g_Log << "[ERROR] Failed to compile '" << name << "'.\n";
+        g_Log << "[Error] OpenGL error: " << m_error;
         return 0;
     }
 
     return shader;
 }
 
-GLuint CShader::LoadShaderSource(const char* psrc, const int shader_type)
+/**
+ * Compiles and links a program.
+ *  The shaders aren't needed once it's linked, so they're deleted.
+ *
+ * @param std::string& Preprocessed vertex shader source
+ * @param std::string& Preprocessed fragment shader source
+ *
+ * @return The program, 0 on failure.
+ **/
+GLuint CShader::LinkProgram(const std::string& vs_src,
+    const std::string& fs_src)
 {
-    g_Log.Flush();
-    g_Log << "[INFO] Loading shader from source.\n";
+    std::string vs_name = m_vsfn.empty() ? "vertex shader"   : m_vsfn;
+    std::string fs_name = m_fsfn.empty() ? "fragment shader" : m_fsfn;
 
-    GLint length;
+    GLuint vshader = this->CompileShader(vs_src, GL_VERTEX_SHADER, vs_name);
+    GLuint fshader = this->CompileShader(fs_src, GL_FRAGMENT_SHADER, fs_name);
 
-    // Create and compile shader.
-    GLuint shader = glCreateShader(shader_type);
-    length = strlen(psrc);
-    glShaderSource(shader, 1, &psrc, &length);
-    glCompileShader(shader);
+    if(vshader == 0 || fshader == 0)
+    {
+        if(vshader != 0) glDeleteShader(vshader);
+        if(fshader != 0) glDeleteShader(fshader);
+        return 0;
+    }
 
-    // Check for errors.
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &m_last_error);
+    // Create program object and attach shader.
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vshader);
+    glAttachShader(program, fshader);
+
+    if(GLEW_ARB_get_program_binary)
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
+    // Link program
+    glLinkProgram(program);
+    glGetProgramiv(program, GL_LINK_STATUS, &m_last_error);
+
+    glDetachShader(program, vshader);
+    glDetachShader(program, fshader);
+    glDeleteShader(vshader);
+    glDeleteShader(fshader);
 
     if(m_last_error == GL_FALSE)
     {
-        // Get log length.
-        glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &length);
-
         // Get log details.
-        if(mp_error_str != NULL)
-            delete[] mp_error_str;
+        GLint length = 0;
+        glGetProgramiv(program, GL_INFO_LOG_LENGTH, &length);
 
-        mp_error_str = new char[length];
-        glGetShaderInfoLog(shader, length, &length, mp_error_str);
-        glDeleteShader(shader);
+        std::vector<GLchar> log(length + 1, '\0');
+        glGetProgramInfoLog(program, length, &length, &log[0]);
+        glDeleteProgram(program);
+        m_error = &log[0];
 
         g_Log.Flush();
-        g_Log << "[ERROR] Failed to compile shader from source.\n";
-        g_Log << "[Error] OpenGL error: " << mp_error_str;
+        g_Log << "[ERROR] Failed to link '" << vs_name << "'.\n";
+        g_Log << "[Error] OpenGL error: " << m_error;
         return 0;
     }
 
-    return shader;
+    return program;
+}
+
+/**
+ * Builds the filename a program binary is saved under.
+ *
+ * @param unsigned long long Program key
+ * @return The filename.
+ **/
+static std::string binary_filename(const unsigned long long key)
+{
+    std::stringstream filename;
+    filename << gfx::SHADER_CACHE_DIR << "/" << std::hex << key << ".bin";
+    return filename.str();
+}
+
+/**
+ * Loads a program that was linked on an earlier run.
+ *  Binaries are tied to the driver that made them, so they're
+ *  allowed to fail, and the program is then compiled as usual.
+ *
+ * @param program_key Program key
+ * @return The program, 0 if there's no usable binary.
+ **/
+GLuint CShader::LoadProgramBinary(const program_key key)
+{
+    if(!GLEW_ARB_get_program_binary)
+        return 0;
+
+    std::ifstream file(binary_filename(key).c_str(),
+        std::ios::in | std::ios::binary);
+
+    GLenum format = 0;
+    GLint  length = 0;
+    if(!file.read((char*)&format, sizeof format) ||
+       !file.read((char*)&length, sizeof length) || length <= 0)
+    {
+        return 0;
+    }
+
+    std::vector<char> binary(length);
+    if(!file.read(&binary[0], length))
+        return 0;
+
+    GLuint program = glCreateProgram();
+    glProgramBinary(program, format, &binary[0], length);
+
+    GLint status = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+    if(status == GL_FALSE)
+    {
+        glDeleteProgram(program);
+        return 0;
+    }
+
+    return program;
+}
+
+/**
+ * Saves a linked program for the next run.
+ *  Failing to save it (on a read-only install, for example)
+ *  only means it's compiled again next time.
+ *
+ * @param program_key Program key
+ * @param GLuint Linked program
+ **/
+void CShader::SaveProgramBinary(const program_key key, const GLuint program)
+{
+    if(!GLEW_ARB_get_program_binary)
+        return;
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if(length <= 0)
+        return;
+
+    GLenum format = 0;
+    std::vector<char> binary(length);
+    glGetProgramBinary(program, length, &length, &format, &binary[0]);
+
+#ifdef _WIN32
+    _mkdir(gfx::SHADER_CACHE_DIR);
+#else
+    mkdir(gfx::SHADER_CACHE_DIR, 0755);
+#endif // _WIN32
+
+    std::ofstream file(binary_filename(key).c_str(),
+        std::ios::out | std::ios::binary | std::ios::trunc);
+
+    file.write((const char*)&format, sizeof format);
+    file.write((const char*)&length, sizeof length);
+    file.write(&binary[0], length);
 }
@@ -0,0 +1,238 @@
+/**
+ * @file
+ *  Definitions for the CSpriteBatch class.
+ *
+ * @author George Kudrayvtsev
+ * @version 1.0
+ **/
+
+#include "Graphics/SpriteBatch.hpp"
+
+using gfx::CSpriteBatch;
+
+CSpriteBatch* CSpriteBatch::mp_Active = NULL;
+u_int CSpriteBatch::m_total_draw_calls = 0;
+
+CSpriteBatch::CSpriteBatch() : mp_Previous(NULL), m_mode(e_SORT_TEXTURE),
+    m_active(false), m_draw_calls(0), m_sprite_count(0) {}
+
+CSpriteBatch::~CSpriteBatch()
+{
+    if(m_active)
+        this->End();
+}
+
+/**
+ * Starts collecting sprites.
+ *  The batch becomes the active batch until End() is called,
+ *  after which the previously active one (if any) takes over again.
+ *
+ * @param SortMode How to order the sprites (optional)
+ **/
+void CSpriteBatch::Begin(const SortMode mode)
+{
+    if(m_active)
+        this->End();
+
+    m_Sprites.clear();
+    m_Vertices.clear();
+    m_Runs.clear();
+    m_mode          = mode;
+    m_active        = true;
+    m_draw_calls    = 0;
+    m_sprite_count  = 0;
+
+    mp_Previous = mp_Active;
+    mp_Active   = this;
+}
+
+/**
+ * Queues a textured quad.
+ *
+ * @param u_int OpenGL texture
+ * @param math::CRectf& Where to draw, in the current coordinate system
+ * @param math::CRectf& Texture coordinates
+ * @param float Rotation around the quad center, in degrees (optional)
+ *
+ * @pre Begin() has been called.
+ **/
+void CSpriteBatch::Draw(const u_int texture, const math::CRectf& Dest,
+    const math::CRectf& TexCoords, const float angle)
+{
+    Sprite Quad;
+    Quad.texture = texture;
+
+    // Top left, top right, bottom right, bottom left
+    const float x[4] = {Dest.x, Dest.x + Dest.w, Dest.x + Dest.w, Dest.x};
+    const float y[4] = {Dest.y, Dest.y, Dest.y + Dest.h, Dest.y + Dest.h};
+    const float u[4] = {TexCoords.x, TexCoords.x + TexCoords.w,
+                        TexCoords.x + TexCoords.w, TexCoords.x};
+    const float v[4] = {TexCoords.y, TexCoords.y,
+                        TexCoords.y + TexCoords.h, TexCoords.y + TexCoords.h};
+
+    if(angle == 0.0f)
+    {
+        for(int i = 0; i < 4; ++i)
+        {
+            Quad.corners[i].x = x[i];
+            Quad.corners[i].y = y[i];
+        }
+    }
+    else
+    {
+        // Same as glRotatef() around the center.
+        float center_x = Dest.x + Dest.w / 2;
+        float center_y = Dest.y + Dest.h / 2;
+        float c = cos(math::rad(angle));
+        float s = sin(math::rad(angle));
+
+        for(int i = 0; i < 4; ++i)
+        {
+            float dx = x[i] - center_x, dy = y[i] - center_y;
+            Quad.corners[i].x = center_x + dx * c - dy * s;
+            Quad.corners[i].y = center_y + dx * s + dy * c;
+        }
+    }
+
+    for(int i = 0; i < 4; ++i)
+    {
+        Quad.corners[i].u = u[i];
+        Quad.corners[i].v = v[i];
+    }
+
+    m_Sprites.push_back(Quad);
+}
+
+/**
+ * Finishes collecting sprites.
+ *  The sprites are (optionally) sorted and written to the vertex
+ *  array, which is kept around until the next Begin().
+ *
+ * @param bool Draw right away, or wait for Render() (optional)
+ **/
+void CSpriteBatch::End(const bool draw)
+{
+    if(!m_active)
+        return;
+
+    m_active  = false;
+    mp_Active = mp_Previous;
+    mp_Previous = NULL;
+
+    // Stable, so sprites sharing a texture keep their order.
+    if(m_mode == e_SORT_TEXTURE)
+    {
+        std::stable_sort(m_Sprites.begin(), m_Sprites.end(),
+            &CSpriteBatch::CompareTexture);
+    }
+
+    m_sprite_count = m_Sprites.size();
+    m_Vertices.resize(m_Sprites.size() * 4);
+    m_Runs.clear();
+
+    for(size_t i = 0; i < m_Sprites.size(); ++i)
+    {
+        for(int j = 0; j < 4; ++j)
+            m_Vertices[i * 4 + j] = m_Sprites[i].corners[j];
+
+        if(m_Runs.empty() || m_Runs.back().texture != m_Sprites[i].texture)
+        {
+            Run Next = {m_Sprites[i].texture, (u_int)i, 0};
+            m_Runs.push_back(Next);
+        }
+
+        ++m_Runs.back().count;
+    }
+
+    m_Sprites.clear();
+
+    if(draw)
+        this->Render();
+}
+
+/**
+ * Draws everything collected between the last Begin() and End().
+ *  One draw call is made per run of sprites sharing a texture. The
+ *  null renderer draws nothing, but still counts the calls.
+ *
+ * @pre End() has been called.
+ **/
+void CSpriteBatch::Render()
+{
+    m_draw_calls = m_Runs.size();
+    m_total_draw_calls += m_draw_calls;
+
+    if(m_Runs.empty() || gfx::is_headless())
+        return;
+
+    glActiveTexture(GL_TEXTURE0);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glVertexPointer(2, GL_FLOAT, sizeof(Vertex), &m_Vertices[0].x);
+    glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), &m_Vertices[0].u);
+
+    for(size_t i = 0; i < m_Runs.size(); ++i)
+    {
+        glBindTexture(GL_TEXTURE_2D, m_Runs[i].texture);
+        glDrawArrays(GL_QUADS, m_Runs[i].first * 4, m_Runs[i].count * 4);
+    }
+
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+}
+
+/**
+ * Checks if the batch is between Begin() and End().
+ * @return TRUE if collecting sprites, FALSE otherwise.
+ **/
+bool CSpriteBatch::IsActive() const
+{
+    return m_active;
+}
+
+/**
+ * Retrieves the number of draw calls made by the last Render().
+ * @return The draw call count.
+ **/
+u_int CSpriteBatch::GetDrawCallCount() const
+{
+    return m_draw_calls;
+}
+
+/**
+ * Retrieves the number of sprites collected by the last End().
+ * @return The sprite count.
+ **/
+u_int CSpriteBatch::GetSpriteCount() const
+{
+    return m_sprite_count;
+}
+
+/**
+ * Retrieves the batch that's currently collecting sprites.
+ * @return The active batch, NULL if there is none.
+ **/
+CSpriteBatch* CSpriteBatch::GetActive()
+{
+    return mp_Active;
+}
+
+/**
+ * Retrieves the number of draw calls made by all batches.
+ * @return The draw call count since the last ResetTotalDrawCalls().
+ **/
+u_int CSpriteBatch::GetTotalDrawCalls()
+{
+    return m_total_draw_calls;
+}
+
+/// Resets the draw call count, usually at the start of a frame.
+void CSpriteBatch::ResetTotalDrawCalls()
+{
+    m_total_draw_calls = 0;
+}
+
+bool CSpriteBatch::CompareTexture(const Sprite& One, const Sprite& Two)
+{
+    return One.texture < Two.texture;
+}
@@ -0,0 +1,156 @@
+/**
+ * @file
+ *  Definitions for the CText class.
+ *
+ * @author George Kudrayvtsev
+ * @version 1.0
+ **/
+
+#include "Graphics/Text.hpp"
+
+using gfx::CText;
+
+CText::CText() : mp_Glyphs(NULL), m_Color(gfx::WHITE),
+    m_width(0), m_height(0), m_dirty(false) {}
+
+CText::~CText()
+{}
+
+/**
+ * Sets the font to draw the text with.
+ *
+ * @param asset::CFont* Font
+ * @param u_int Font size
+ *
+ * @return TRUE if the font has a glyph atlas at that size, FALSE otherwise.
+ **/
+bool CText::SetFont(asset::CFont* pFont, const u_int size)
+{
+    const asset::CGlyphAtlas* pGlyphs = pFont->GetGlyphs(size);
+    if(pGlyphs != mp_Glyphs)
+    {
+        mp_Glyphs = pGlyphs;
+        m_dirty   = true;
+    }
+
+    return (mp_Glyphs != NULL);
+}
+
+/**
+ * Changes the text.
+ *  Nothing happens if it's the same as the current text.
+ *
+ * @param std::string& Text, may contain '\n'
+ **/
+void CText::SetText(const std::string& text)
+{
+    if(text == m_text)
+        return;
+
+    m_text  = text;
+    m_dirty = true;
+}
+
+void CText::SetColor(const gfx::Color& Text_Color)
+{
+    m_Color = Text_Color;
+}
+
+/**
+ * Moves the top-left corner of the text.
+ *  The text is drawn relative to this, so moving it never
+ *  causes it to be laid out again.
+ *
+ * @param float x-coordinate
+ * @param float y-coordinate
+ **/
+void CText::Move(const float x, const float y)
+{
+    m_Position.Move(x, y);
+}
+
+/// Draws the text, laying it out first if it changed.
+void CText::Update()
+{
+    if(m_dirty)
+        this->Layout();
+
+    if(mp_Glyphs == NULL || m_text.empty())
+        return;
+
+    glPushMatrix();
+    glTranslatef(m_Position.x, m_Position.y, 0.0f);
+    glColor4ub(m_Color.r, m_Color.g, m_Color.b, 255);
+
+    m_Mesh.Render();
+
+    glColor4f(1, 1, 1, 1);
+    glPopMatrix();
+}
+
+const std::string& CText::GetText() const
+{
+    return m_text;
+}
+
+/**
+ * Retrieves the width of the laid out text.
+ * @return Width of the longest line, in pixels.
+ **/
+int CText::GetW() const
+{
+    return m_width;
+}
+
+/**
+ * Retrieves the height of the laid out text.
+ * @return Height of all of the lines, in pixels.
+ **/
+int CText::GetH() const
+{
+    return m_height;
+}
+
+/// Builds a quad for every character, relative to (0, 0).
+void CText::Layout()
+{
+    m_dirty  = false;
+    m_width  = m_height = 0;
+
+    m_Mesh.Begin(gfx::CSpriteBatch::e_SORT_NONE);
+
+    if(mp_Glyphs == NULL)
+    {
+        m_Mesh.End(false);
+        return;
+    }
+
+    int pen_x = 0, pen_y = 0;
+    for(size_t i = 0; i < m_text.length(); ++i)
+    {
+        if(m_text[i] == '\n')
+        {
+            pen_x  = 0;
+            pen_y += mp_Glyphs->GetLineSkip();
+            continue;
+        }
+
+        const asset::CGlyphAtlas::Glyph* pGlyph = mp_Glyphs->GetGlyph(m_text[i]);
+        if(pGlyph == NULL)
+            pGlyph = mp_Glyphs->GetGlyph('?');
+
+        if(pGlyph->w > 0 && pGlyph->h > 0)
+        {
+            m_Mesh.Draw(mp_Glyphs->GetTexture(),
+                math::CRectf(pen_x + pGlyph->x, pen_y + pGlyph->y,
+                    pGlyph->w, pGlyph->h),
+                pGlyph->TexCoords);
+        }
+
+        pen_x  += pGlyph->advance;
+        m_width = max(m_width, pen_x);
+    }
+
+    m_height = pen_y + mp_Glyphs->GetHeight();
+    m_Mesh.End(false);
+}
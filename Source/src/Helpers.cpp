@@ -110,3 +110,27 @@ std::vector<std::string> gk::split(const std::string& str, char token)
 
     return results;
 }
+
+/**
+ * Hashes a block of memory with 64-bit FNV-1a.
+ *  Hashes can be chained by passing the last one as the seed.
+ *
+ * @param void* Data to hash
+ * @param size_t Size of the data, in bytes
+ * @param unsigned long long Hash so far (optional)
+ * @return The new hash.
+ **/
+unsigned long long gk::hash(const void* pdata, const size_t size,
+    const unsigned long long seed)
+{
+    const unsigned char* pbytes = static_cast<const unsigned char*>(pdata);
+    unsigned long long hash = seed;
+
+    for(size_t i = 0; i < size; ++i)
+    {
+        hash ^= pbytes[i];
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
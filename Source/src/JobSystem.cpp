@@ -0,0 +1,300 @@
+/**
+ * @file
+ *  Definitions for the CJobSystem class.
+ *
+ * @author George Kudrayvtsev
+ * @version 1.0
+ **/
+
+#include "JobSystem.hpp"
+#include "Logging.hpp"
+
+#ifdef _WIN32
+  #include <windows.h>
+#else
+  #include <unistd.h>
+#endif // _WIN32
+
+using game::CJobSystem;
+using game::g_Log;
+
+CJobSystem::CJobSystem() : mp_Lock(NULL), mp_WorkReady(NULL),
+    mp_AllDone(NULL), m_queued(0), m_unfinished(0), m_running(false) {}
+
+CJobSystem::~CJobSystem()
+{
+    this->Shutdown();
+}
+
+CJobSystem& CJobSystem::GetInstance()
+{
+    static CJobSystem Jobs;
+    return Jobs;
+}
+
+/**
+ * Finds out how many cores there are to run threads on.
+ * @return The number of cores, at least 1.
+ **/
+u_int CJobSystem::GetCoreCount()
+{
+#ifdef _WIN32
+    SYSTEM_INFO Info;
+    GetSystemInfo(&Info);
+    return (Info.dwNumberOfProcessors > 0) ? Info.dwNumberOfProcessors : 1;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return (count > 0) ? (u_int)count : 1;
+#endif // _WIN32
+}
+
+/**
+ * Starts up the worker threads.
+ *  The thread calling ParallelFor() works through loops as well,
+ *  so one less thread than there are cores is usually right.
+ *
+ * @param u_int Number of worker threads, 0 runs loops inline
+ * @return TRUE if everything started, FALSE if a thread failed to
+ *  start. Loops are still shared with the threads that did.
+ **/
+bool CJobSystem::Init(const u_int thread_count)
+{
+    if(mp_Lock != NULL)
+        return true;
+
+    mp_Lock      = SDL_CreateMutex();
+    mp_WorkReady = SDL_CreateCond();
+    mp_AllDone   = SDL_CreateCond();
+    m_running    = true;
+
+    // Workers hold on to their entry, so it can't move around later.
+    m_Workers.resize(thread_count);
+    for(u_int i = 0; i <= thread_count; ++i)
+    {
+        JobQueue* pQueue = new JobQueue;
+        pQueue->pLock = SDL_CreateMutex();
+        mp_allQueues.push_back(pQueue);
+    }
+
+    for(u_int i = 0; i < thread_count; ++i)
+    {
+        m_Workers[i].pSystem = this;
+        m_Workers[i].index   = i + 1;
+
+        SDL_Thread* pThread = SDL_CreateThread(
+            &CJobSystem::WorkerThread, &m_Workers[i]);
+
+        if(pThread == NULL)
+        {
+            g_Log.Flush();
+            g_Log << "[ERROR] Failed to start job thread: ";
+            g_Log << SDL_GetError() << "\n";
+            return false;
+        }
+
+        mp_allThreads.push_back(pThread);
+    }
+
+    g_Log.Flush();
+    g_Log << "[INFO] Started " << mp_allThreads.size();
+    g_Log << " job thread(s).\n";
+
+    return true;
+}
+
+/**
+ * Stops the worker threads.
+ * @pre No ParallelFor() is running.
+ **/
+void CJobSystem::Shutdown()
+{
+    if(mp_Lock == NULL)
+        return;
+
+    SDL_mutexP(mp_Lock);
+    m_running = false;
+    SDL_CondBroadcast(mp_WorkReady);
+    SDL_mutexV(mp_Lock);
+
+    for(size_t i = 0; i < mp_allThreads.size(); ++i)
+        SDL_WaitThread(mp_allThreads[i], NULL);
+
+    mp_allThreads.clear();
+    m_Workers.clear();
+
+    for(size_t i = 0; i < mp_allQueues.size(); ++i)
+    {
+        SDL_DestroyMutex(mp_allQueues[i]->pLock);
+        delete mp_allQueues[i];
+    }
+
+    mp_allQueues.clear();
+
+    SDL_DestroyCond(mp_AllDone);
+    SDL_DestroyCond(mp_WorkReady);
+    SDL_DestroyMutex(mp_Lock);
+    mp_AllDone = mp_WorkReady = NULL;
+    mp_Lock = NULL;
+
+    m_queued = m_unfinished = 0;
+}
+
+/**
+ * Runs a function over every index in [0, count), in parallel.
+ *  The range is cut into jobs of @a grain indices, which are dealt
+ *  out to every thread's queue in turn. The calling thread works
+ *  through jobs too, and only returns once all of them are done.
+ *
+ * @param u_int Number of indices
+ * @param u_int Indices per job, larger means less overhead but
+ *  worse balancing
+ * @param JobFunc Function to run on each job
+ * @param void* User data passed to the function
+ *
+ * @pre Called from a single thread, and not from inside a job.
+ **/
+void CJobSystem::ParallelFor(const u_int count, const u_int grain,
+    JobFunc func, void* pData)
+{
+    if(count == 0)
+        return;
+
+    if(mp_allThreads.empty())
+    {
+        func(pData, 0, count);
+        return;
+    }
+
+    const u_int step   = (grain > 0) ? grain : 1;
+    const u_int queues = mp_allThreads.size() + 1;
+    int jobs = 0;
+
+    for(u_int begin = 0; begin < count; begin += step, ++jobs)
+    {
+        Job Next;
+        Next.func   = func;
+        Next.pData  = pData;
+        Next.begin  = begin;
+        Next.end    = (count - begin > step) ? begin + step : count;
+
+        JobQueue* pQueue = mp_allQueues[jobs % queues];
+        SDL_mutexP(pQueue->pLock);
+        pQueue->Jobs.push_back(Next);
+        SDL_mutexV(pQueue->pLock);
+    }
+
+    SDL_mutexP(mp_Lock);
+    m_queued     += jobs;
+    m_unfinished += jobs;
+    SDL_CondBroadcast(mp_WorkReady);
+    SDL_mutexV(mp_Lock);
+
+    // Help out until there's nothing left to take.
+    Job Next;
+    while(this->TakeJob(0, Next))
+        this->RunJob(Next);
+
+    SDL_mutexP(mp_Lock);
+    while(m_unfinished > 0)
+        SDL_CondWait(mp_AllDone, mp_Lock);
+    SDL_mutexV(mp_Lock);
+}
+
+u_int CJobSystem::GetWorkerCount() const
+{
+    return mp_allThreads.size();
+}
+
+/**
+ * Works through jobs until the system is shut down.
+ *
+ * @param void* The worker's CJobSystem::Worker entry
+ * @return Always 0.
+ **/
+int CJobSystem::WorkerThread(void* pData)
+{
+    Worker* pWorker = static_cast<Worker*>(pData);
+    CJobSystem* pSystem = pWorker->pSystem;
+    Job Next;
+
+    while(true)
+    {
+        SDL_mutexP(pSystem->mp_Lock);
+        while(pSystem->m_running && pSystem->m_queued <= 0)
+            SDL_CondWait(pSystem->mp_WorkReady, pSystem->mp_Lock);
+
+        if(!pSystem->m_running)
+        {
+            SDL_mutexV(pSystem->mp_Lock);
+            break;
+        }
+
+        SDL_mutexV(pSystem->mp_Lock);
+
+        if(pSystem->TakeJob(pWorker->index, Next))
+            pSystem->RunJob(Next);
+    }
+
+    return 0;
+}
+
+/**
+ * Finds a job to run.
+ *  The newest job in the thread's own queue is taken first, which
+ *  is the one most likely to still be in its cache. Failing that,
+ *  the oldest job is stolen from another thread's queue.
+ *
+ * @param u_int Index of the thread's own queue
+ * @param Job& Output job
+ *
+ * @return TRUE if a job was found, FALSE if every queue is empty.
+ **/
+bool CJobSystem::TakeJob(const u_int index, Job& Next)
+{
+    const u_int queues = mp_allQueues.size();
+
+    for(u_int i = 0; i < queues; ++i)
+    {
+        JobQueue* pQueue = mp_allQueues[(index + i) % queues];
+
+        SDL_mutexP(pQueue->pLock);
+        if(pQueue->Jobs.empty())
+        {
+            SDL_mutexV(pQueue->pLock);
+            continue;
+        }
+
+        if(i == 0)
+        {
+            Next = pQueue->Jobs.back();
+            pQueue->Jobs.pop_back();
+        }
+        else
+        {
+            Next = pQueue->Jobs.front();
+            pQueue->Jobs.pop_front();
+        }
+
+        // Counted while the queue is still locked, so the count never
+        // says there's work when there isn't any for long.
+        SDL_mutexP(mp_Lock);
+        --m_queued;
+        SDL_mutexV(mp_Lock);
+
+        SDL_mutexV(pQueue->pLock);
+        return true;
+    }
+
+    return false;
+}
+
+/// Runs a job, waking up ParallelFor() if it was the last one.
+void CJobSystem::RunJob(const Job& Current)
+{
+    Current.func(Current.pData, Current.begin, Current.end);
+
+    SDL_mutexP(mp_Lock);
+    if(--m_unfinished == 0)
+        SDL_CondBroadcast(mp_AllDone);
+    SDL_mutexV(mp_Lock);
+}
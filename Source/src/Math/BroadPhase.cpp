@@ -0,0 +1,114 @@
+/**
+ * @file
+ *  Definitions for the CBroadPhase class.
+ *
+ * @author George Kudrayvtsev
+ * @version 1.0
+ **/
+
+#include "Math/BroadPhase.hpp"
+
+using math::CBroadPhase;
+
+CBroadPhase::CBroadPhase() : m_test_count(0) {}
+
+/// Removes every box, usually at the start of a frame.
+void CBroadPhase::Clear()
+{
+    m_Bodies.clear();
+    m_Pairs.clear();
+    m_test_count = 0;
+}
+
+/**
+ * Adds a box.
+ *
+ * @param math::CRect& The box
+ * @param u_int Layer the box is on, a single bit
+ * @param u_int Layers the box collides with
+ * @param u_int ID to report the box with
+ **/
+void CBroadPhase::Add(const CRect& Box, const u_int layer,
+    const u_int mask, const u_int id)
+{
+    Body Latest;
+    Latest.left     = Box.x;
+    Latest.right    = Box.x + Box.w;
+    Latest.top      = Box.y;
+    Latest.bottom   = Box.y + Box.h;
+    Latest.layer    = layer;
+    Latest.mask     = mask;
+    Latest.id       = id;
+
+    m_Bodies.push_back(Latest);
+}
+
+/**
+ * Finds every pair of overlapping boxes that care about each other.
+ *  Edges touching counts as overlapping, same as
+ *  math::CRect::CheckCollision().
+ *
+ * @return The pairs, valid until the next Clear().
+ **/
+const std::vector<CBroadPhase::Pair>& CBroadPhase::FindPairs()
+{
+    m_Pairs.clear();
+    m_test_count = 0;
+
+    std::sort(m_Bodies.begin(), m_Bodies.end(), &CBroadPhase::CompareLeft);
+
+    for(size_t i = 0; i < m_Bodies.size(); ++i)
+    {
+        const Body& One = m_Bodies[i];
+
+        // Everything after this starts further right, so stop as soon
+        // as something starts past this box's right edge.
+        for(size_t j = i + 1; j < m_Bodies.size() &&
+            m_Bodies[j].left <= One.right; ++j)
+        {
+            const Body& Two = m_Bodies[j];
+
+            if(!(One.mask & Two.layer) && !(Two.mask & One.layer))
+                continue;
+
+            ++m_test_count;
+            if(One.bottom < Two.top || Two.bottom < One.top)
+                continue;
+
+            Pair Found = {One.layer, One.id, Two.layer, Two.id};
+            m_Pairs.push_back(Found);
+        }
+    }
+
+    return m_Pairs;
+}
+
+u_int CBroadPhase::GetBodyCount() const
+{
+    return m_Bodies.size();
+}
+
+/**
+ * Retrieves the number of pairs found by the last FindPairs().
+ * @return The pair count.
+ **/
+u_int CBroadPhase::GetPairCount() const
+{
+    return m_Pairs.size();
+}
+
+/**
+ * Retrieves the number of box pairs compared by the last FindPairs().
+ *  Without the sweep, this would be every pair of bodies.
+ *
+ * @return The test count.
+ **/
+u_int CBroadPhase::GetTestCount() const
+{
+    return m_test_count;
+}
+
+bool CBroadPhase::CompareLeft(const Body& One, const Body& Two)
+{
+    return One.left < Two.left;
+}
@@ -136,6 +136,58 @@ bool CRay2::CheckCollision(const math::CRect& Other,
         return false;
 }
 
+/**
+ * Finds where the ray first enters a rectangle.
+ *  Unlike CheckCollision(), a ray starting inside of the
+ *  rectangle counts as entering it immediately.
+ *
+ * @param math::CRect& Rectangle
+ * @param float& Output distance along the ray, where 0 is the start
+ *  and 1 is the end.
+ *
+ * @return TRUE if the ray touches the rectangle, FALSE if not.
+ **/
+bool CRay2::Clip(const math::CRect& Other, float& t) const
+{
+    float t_min = 0.0f, t_max = 1.0f;
+
+    // Narrow [t_min, t_max] down to the overlap of both slabs.
+    const float start[2] = {this->Start.x, this->Start.y};
+    const float delta[2] = {this->End.x - this->Start.x,
+                            this->End.y - this->Start.y};
+    const float lo[2]    = {(float)Other.x, (float)Other.y};
+    const float hi[2]    = {(float)Other.x + Other.w,
+                            (float)Other.y + Other.h};
+
+    for(int i = 0; i < 2; ++i)
+    {
+        if(delta[i] == 0.0f)
+        {
+            if(start[i] < lo[i] || start[i] > hi[i])
+                return false;
+
+            continue;
+        }
+
+        float t_lo = (lo[i] - start[i]) / delta[i];
+        float t_hi = (hi[i] - start[i]) / delta[i];
+        if(t_lo > t_hi)
+        {
+            float tmp = t_lo;
+            t_lo = t_hi;
+            t_hi = tmp;
+        }
+
+        t_min = max(t_min, t_lo);
+        t_max = min(t_max, t_hi);
+        if(t_min > t_max)
+            return false;
+    }
+
+    t = t_min;
+    return true;
+}
+
 /**
  * Rotates the line segment by a certain amount of radians.
  *
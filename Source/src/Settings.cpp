@@ -3,111 +3,275 @@
 using game::CSettings;
 
 CSettings::~CSettings()
-{
-    if(m_settingsfile.is_open())
-        m_settingsfile.close();
-}
+{}
 
 /**
  * Loads a settings file.
  *  The settings file should be in the format of an .ini file,
- *  with various headings containing key-value pairs.
+ *  with various headings containing key-value pairs. The whole
+ *  file is read into memory, so it isn't needed afterwards.
  *
  * @param const std::string & filename
  * @return TRUE on a successful load, FALSE otherwise.
- **/       
+ **/
 bool CSettings::Load(const std::string& filename)
 {
-    m_settingsfile.open(filename, std::ios::in);
-    return (m_settingsfile.is_open());
+    m_filename = filename;
+    m_modified = CSettings::GetModifiedTime(filename);
+    return CSettings::Parse(filename, m_Table);
+}
+
+/**
+ * Reads the settings file again.
+ *  The file is parsed into a new table that only replaces the current
+ *  one if the whole file was read, so a half-saved file never leaves
+ *  the settings half-updated.
+ *
+ * @return TRUE if the settings were replaced, FALSE otherwise.
+ * @pre Load() has been called.
+ **/
+bool CSettings::Reload()
+{
+    SettingsTable Fresh;
+    if(m_filename.empty() || !CSettings::Parse(m_filename, Fresh))
+        return false;
+
+    m_Table.swap(Fresh);
+    m_modified = CSettings::GetModifiedTime(m_filename);
+    return true;
+}
+
+/**
+ * Reloads the settings file if it was changed on disk.
+ *  Cheap enough to call every frame, since the file is
+ *  only checked once a second.
+ *
+ * @return TRUE if the settings were reloaded, FALSE otherwise.
+ **/
+bool CSettings::CheckForChanges()
+{
+    time_t now = time(NULL);
+    if(m_filename.empty() || now == m_last_check)
+        return false;
+
+    m_last_check = now;
+
+    time_t modified = CSettings::GetModifiedTime(m_filename);
+    if(modified == 0 || modified == m_modified)
+        return false;
+
+    return this->Reload();
 }
 
 /**
  * Chooses a random value out of a list of values in a key-value pair.
- *  If the settings file contains an item in the form 
- *  "key=value1,value2,value3" this function will return one
+ *  If the settings file contains an item in the form
+ *  "key=value1;value2;value3" this function will return one
  *  of the values at random.
- * 
+ *
  * @param std::string& Key to search for
  * @return The chosen value, or an empty string if the key could not be found.
  * @pre The settings file has been loaded.
  * @see CSettings::Load(const std::string& filename)
- **/        
-std::string CSettings::ChooseValueAt(const std::string& id)
+ **/
+const std::string& CSettings::ChooseValueAt(const std::string& id) const
 {
-    std::string line;
-
-    m_settingsfile.clear();
-    m_settingsfile.seekg(0, std::ios::beg);
+    static const std::string empty;
 
-    while(std::getline(m_settingsfile, line))
-    {
-        if(line.empty() || line[0] == ';' || line[0] == '[')
-            continue;
-
-        else
-        {
-            if(line.find(id) == 0)  // We found the ID at the beginning of the line
-            {
-                std::vector<std::string> tmp;
-                tmp = gk::split(line, '=');
-                if(tmp.size() == 1) // No value after '='
-                    return std::string("");
-                else if(tmp.size() > 1 && tmp[1].find(';') != std::string::npos)
-                {
-                    std::vector<std::string> tmp2 = gk::split(tmp[1], ';');
-                    int index = rand() % (tmp2.size() - 1);
-                    return tmp2[index];
-                }
-                else
-                    return tmp[1];
-            }
-        }
-    }
+    const Value* pValue = this->Find(id);
+    if(pValue == NULL || pValue->choices.empty())
+        return empty;
 
-    return std::string("");
+    return pValue->choices[rand() % pValue->choices.size()];
 }
 
 /**
  * Retrieves the value for a certain key.
- * 
+ *
  * @param std::string& Key to search for
  * @return The value in the key-value pair, or an empty
+ *  string if the value was not found.
  * @pre The settings file has been loaded.
  * @see CSettings::Load(const std::string& filename)
- *  string if the value was not found.
- **/       
-std::string CSettings::GetValueAt(const std::string& id)
+ **/
+const std::string& CSettings::GetValueAt(const std::string& id) const
+{
+    static const std::string empty;
+
+    const Value* pValue = this->Find(id);
+    return (pValue == NULL) ? empty : pValue->text;
+}
+
+/**
+ * Retrieves a value as an integer.
+ *
+ * @param std::string& Key to search for
+ * @param int Value to use if the key is missing or isn't a number
+ * @return The value.
+ **/
+int CSettings::GetInt(const std::string& id, const int default_val) const
+{
+    const Value* pValue = this->Find(id);
+    if(pValue == NULL || pValue->text.empty())
+        return default_val;
+
+    char* pEnd = NULL;
+    long value = strtol(pValue->text.c_str(), &pEnd, 10);
+    return (*pEnd == '\0') ? (int)value : default_val;
+}
+
+/**
+ * Retrieves a value as a decimal number.
+ *
+ * @param std::string& Key to search for
+ * @param float Value to use if the key is missing or isn't a number
+ * @return The value.
+ **/
+float CSettings::GetFloat(const std::string& id, const float default_val) const
+{
+    const Value* pValue = this->Find(id);
+    if(pValue == NULL || pValue->text.empty())
+        return default_val;
+
+    char* pEnd = NULL;
+    double value = strtod(pValue->text.c_str(), &pEnd);
+    return (*pEnd == '\0') ? (float)value : default_val;
+}
+
+/**
+ * Retrieves a value as a boolean.
+ *  "1", "true", "yes" and "on" are TRUE, "0", "false", "no"
+ *  and "off" are FALSE, case ignored.
+ *
+ * @param std::string& Key to search for
+ * @param bool Value to use if the key is missing or unrecognized
+ * @return The value.
+ **/
+bool CSettings::GetBool(const std::string& id, const bool default_val) const
 {
-    std::string line;
+    const Value* pValue = this->Find(id);
+    if(pValue == NULL)
+        return default_val;
 
-    m_settingsfile.clear();
-    m_settingsfile.seekg(0, std::ios::beg);
+    std::string text = gk::toupper_ret(pValue->text);
+    if(text == "1" || text == "TRUE" || text == "YES" || text == "ON")
+        return true;
+    else if(text == "0" || text == "FALSE" || text == "NO" || text == "OFF")
+        return false;
 
-    while(std::getline(m_settingsfile, line))
+    return default_val;
+}
+
+/**
+ * Retrieves every value in a "key=value1;value2;value3" list.
+ *
+ * @param std::string& Key to search for
+ * @return The values, empty if the key could not be found.
+ **/
+const std::vector<std::string>& CSettings::GetList(const std::string& id) const
+{
+    static const std::vector<std::string> empty;
+
+    const Value* pValue = this->Find(id);
+    return (pValue == NULL) ? empty : pValue->choices;
+}
+
+/**
+ * Checks if a key is in the settings file.
+ *
+ * @param std::string& Key to search for
+ * @return TRUE if it is, FALSE otherwise.
+ **/
+bool CSettings::HasValue(const std::string& id) const
+{
+    return (this->Find(id) != NULL);
+}
+
+CSettings& game::CSettings::GetInstance()
+{
+    static CSettings Settings;
+    return Settings;
+}
+
+const CSettings::Value* CSettings::Find(const std::string& id) const
+{
+    SettingsTable::const_iterator i = m_Table.find(id);
+    return (i == m_Table.end()) ? NULL : &i->second;
+}
+
+/**
+ * Reads a settings file into a table.
+ *  Blank lines and lines starting with ';' are skipped,
+ *  "[Section]" lines start a new section.
+ *
+ * @param std::string& Settings filename
+ * @param SettingsTable& Output table
+ *
+ * @return TRUE if the file was read, FALSE otherwise.
+ **/
+bool CSettings::Parse(const std::string& filename, SettingsTable& Table)
+{
+    std::ifstream file(filename.c_str(), std::ios::in);
+    std::string line, section;
+
+    if(!file.is_open())
+        return false;
+
+    Table.clear();
+
+    while(std::getline(file, line))
     {
-        if(line.empty() || line[0] == ';' || line[0] == '[')
+        if(!line.empty() && line[line.length() - 1] == '\r')
+            line.erase(line.length() - 1);
+
+        if(line.empty() || line[0] == ';')
             continue;
 
-        else
+        if(line[0] == '[')
         {
-            if(line.find(id) == 0)  // We found the ID at the beginning of the line
-            {
-                std::vector<std::string> tmp;
-                tmp = gk::split(line, '=');
-                if(tmp.size() == 1) // No value after '='
-                    return std::string("");
-                else
-                    return tmp[1];
-            }
+            section = line.substr(1, line.find(']') - 1);
+            continue;
         }
+
+        size_t split = line.find('=');
+        if(split == std::string::npos)
+            continue;
+
+        Value Entry;
+        std::string key = line.substr(0, split);
+        Entry.text      = line.substr(split + 1);
+
+        // Pre-split lists, dropping the empty part after a trailing ';'.
+        std::vector<std::string> parts = gk::split(Entry.text, ';');
+        for(size_t i = 0; i < parts.size(); ++i)
+        {
+            if(!parts[i].empty())
+                Entry.choices.push_back(parts[i]);
+        }
+
+        if(!section.empty())
+            Table[section + "." + key] = Entry;
+
+        // Bare keys keep their first definition.
+        if(Table.find(key) == Table.end())
+            Table[key] = Entry;
     }
 
-    return std::string("");
+    file.close();
+    return true;
 }
 
-CSettings& game::CSettings::GetInstance()
+/**
+ * Retrieves the last time a file was written to.
+ *
+ * @param std::string& Filename
+ * @return The modification time, 0 if the file doesn't exist.
+ **/
+time_t CSettings::GetModifiedTime(const std::string& filename)
 {
-    static CSettings Settings;
-    return Settings;
+    struct stat info;
+    if(stat(filename.c_str(), &info) != 0)
+        return 0;
+
+    return info.st_mtime;
 }
@@ -8,8 +8,19 @@
  **/
 #include "Timer.hpp"
 
+#ifdef _WIN32
+  #include <windows.h>
+#else
+  #include <time.h>
+  #include <sys/time.h>
+#endif // _WIN32
+
 using game::CTimer;
 
+CTimer::CTimer() : m_FRAMERATE(60), m_ticks(0), m_frame(0),
+    m_max_steps(DEFAULT_MAX_STEPS), m_step(1.0 / SIM_RATE),
+    m_accumulator(0.0), m_last_time(0.0) {}
+
 /**
  * Starts the timer.
  *  This should be called at the beginning of the game loop.
@@ -59,4 +70,116 @@ int CTimer::GetFrame() const
 int CTimer::GetFrameRate() const
 {
     return m_FRAMERATE;
-}
\ No newline at end of file
+}
+
+/**
+ * Sets the most simulation ticks Advance() will ever ask for.
+ * @param u_int Tick limit, 0 is treated as 1
+ **/
+void CTimer::SetMaxSteps(const u_int max_steps)
+{
+    m_max_steps = max(max_steps, 1u);
+}
+
+/**
+ * Restarts the simulation clock from now.
+ *  Call this after anything that kept the simulation from running
+ *  for a while (menus, loading), so that time isn't caught up on.
+ **/
+void CTimer::ResetClock()
+{
+    m_accumulator   = 0.0;
+    m_last_time     = CTimer::GetTime();
+}
+
+/**
+ * Moves the simulation clock up to the current time.
+ *
+ * @return The number of simulation ticks to run this frame,
+ *  never more than the maximum.
+ *
+ * @see CTimer::SetMaxSteps()
+ **/
+u_int CTimer::Advance()
+{
+    double now = CTimer::GetTime();
+    m_accumulator += now - m_last_time;
+    m_last_time = now;
+
+    u_int steps = (u_int)(m_accumulator / m_step);
+    if(steps > m_max_steps)
+    {
+        // Too far behind, give up on the extra time.
+        steps = m_max_steps;
+        m_accumulator = 0.0;
+    }
+    else
+    {
+        m_accumulator -= steps * m_step;
+    }
+
+    return steps;
+}
+
+/**
+ * Retrieves the length of a simulation tick.
+ * @return Tick length, in seconds.
+ **/
+float CTimer::GetStep() const
+{
+    return (float)m_step;
+}
+
+/**
+ * Retrieves how far the clock is between the last tick and the next.
+ * @return Fraction of a tick, in [0, 1).
+ **/
+float CTimer::GetAlpha() const
+{
+    return (float)(m_accumulator / m_step);
+}
+
+u_int CTimer::GetSimRate() const
+{
+    return SIM_RATE;
+}
+
+/**
+ * Retrieves how long until the next simulation tick is due.
+ * @return Time left, in seconds.
+ **/
+double CTimer::GetTimeToNextStep() const
+{
+    double elapsed = m_accumulator + (CTimer::GetTime() - m_last_time);
+    return max(m_step - elapsed, 0.0);
+}
+
+/**
+ * Retrieves the current time from a high-resolution clock.
+ *  Uses the performance counter on Windows, and the monotonic
+ *  clock elsewhere (or the time of day, if there isn't one).
+ *
+ * @return Time since some fixed point, in seconds.
+ **/
+double CTimer::GetTime()
+{
+#ifdef _WIN32
+    static LARGE_INTEGER Frequency = {0};
+    if(Frequency.QuadPart == 0)
+        QueryPerformanceFrequency(&Frequency);
+
+    LARGE_INTEGER Now;
+    QueryPerformanceCounter(&Now);
+    return (double)Now.QuadPart / (double)Frequency.QuadPart;
+#else
+#ifdef CLOCK_MONOTONIC
+    struct timespec Now;
+    if(clock_gettime(CLOCK_MONOTONIC, &Now) == 0)
+        return Now.tv_sec + Now.tv_nsec / 1e9;
+#endif // CLOCK_MONOTONIC
+
+    struct timeval Day;
+    gettimeofday(&Day, NULL);
+    return Day.tv_sec + Day.tv_usec / 1e6;
+#endif // _WIN32
+}
@@ -0,0 +1,829 @@
+/**
+ * @file
+ *  Definitions for the benchmark and tool drivers.
+ *
+ * @author George Kudrayvtsev
+ * @version 1.0
+ **/
+
+#include <fstream>
+
+#include "Engine.hpp"
+#include "World/Levels/LevelFile.hpp"
+#include "World/AI/PathSolver.hpp"
+#include "Tools/Bench.hpp"
+
+using game::g_Log;
+using game::g_Settings;
+
+/// Queries of each kind made by the benchmarks.
+static const u_int BENCH_QUERIES = 10000;
+
+/// Edge length of the maze generated by the path benchmark, in tiles.
+static const int BENCH_MAZE_SIZE = 512;
+
+/**
+ * Runs the game world as fast as possible, without a window.
+ *  Everything in the world is simulated (the player, enemy AI and
+ *  their paths, projectiles and collisions), but nothing is drawn
+ *  and nothing is heard. The tick rate is logged at the end.
+ *
+ * @param u_int Number of ticks to simulate
+ * @return Zero if the world was simulated, non-zero otherwise.
+ **/
+int tools::simulate(const u_int ticks)
+{
+    if(!g_Settings.Load("Data/Settings.ini"))
+    {
+        g_Log.Flush();
+        g_Log << "[ERROR] Failed to load Data/Settings.ini.\n";
+        g_Log.ShowLastLog();
+        return 1;
+    }
+
+    g_Log.Flush();
+    g_Log << "[INFO] Simulating " << ticks << " ticks headless.\n";
+    g_Log.ShowLastLog();
+
+    game::GameState state = game::e_GAME;
+    game::CWorld World(state);
+    World.Init();
+
+    // Only the ticks themselves are timed, not loading.
+    u_int done = 0;
+    double start = game::CTimer::GetTime();
+
+    for( ; done < ticks && state == game::e_GAME; ++done)
+        World.Tick();
+
+    double elapsed = game::CTimer::GetTime() - start;
+    double rate    = (elapsed > 0.0) ? done / elapsed : 0.0;
+
+    g_Log.Flush();
+    g_Log << "[INFO] Simulated " << done << " ticks in " << elapsed;
+    g_Log << "s: " << rate << " ticks/sec (" << rate / game::SIM_RATE;
+    g_Log << "x real time).\n";
+    g_Log.ShowLastLog();
+
+    return 0;
+}
+
+/**
+ * Compiles the text maps of a level into a single level file.
+ *
+ * @param int Level number
+ * @return Zero if compiled, non-zero otherwise.
+ * @see game::CLevelFile
+ **/
+int tools::compile_level(const int level_no)
+{
+    game::CLevel Level;
+    if(!Level.LoadLevel(level_no, false) || !Level.Compile())
+    {
+        g_Log.Flush();
+        g_Log << "[ERROR] Failed to compile level " << level_no << ".\n";
+        g_Log.ShowLastLog();
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * Times loading a large level from text maps and from a compiled
+ * level file.
+ *  A level of size x size tiles is generated from the valid terrain
+ *  textures, with a wall every few tiles and objectives scattered
+ *  around. The generated files are removed afterwards.
+ *
+ * @param int Edge length of the level, in tiles
+ * @return Zero if both loads worked, non-zero otherwise.
+ **/
+int tools::benchmark_load(const int size)
+{
+    const std::string name = "Data/Levels/Bench";
+    const std::string terrain   = name + game::TERRAIN_MAP_EXT;
+    const std::string collision = name + game::COLLISION_MAP_EXT;
+    const std::string objective = name + game::OBJ_MAP_EXT;
+    const std::string compiled  = name + game::LEVEL_FILE_EXT;
+
+    std::ifstream names_file("Data/Levels/ValidNames.dat");
+    std::vector<std::string> names;
+    std::string line;
+
+    while(std::getline(names_file, line))
+    {
+        if(!line.empty() && line[0] != '/')
+            names.push_back(line);
+    }
+
+    if(names.empty())
+    {
+        g_Log.Flush();
+        g_Log << "[ERROR] No terrain textures to generate a level with.\n";
+        g_Log.ShowLastLog();
+        return 1;
+    }
+
+    std::ofstream terrain_file(terrain.c_str());
+    std::ofstream collision_file(collision.c_str());
+    std::ofstream objective_file(objective.c_str());
+
+    for(int y = 0; y < size; ++y)
+    {
+        for(int x = 0; x < size; ++x)
+        {
+            const int px = x * game::TILE_SIZE, py = y * game::TILE_SIZE;
+
+            terrain_file << names[(x + y) % names.size()];
+            terrain_file << ":" << px << "," << py << "\n";
+
+            if(x % 4 == 0 && y % 3 == 0)
+                collision_file << px << "," << py << "\n";
+
+            // POI, enemy spawn, player spawn, light
+            if(x % 8 == 2 && y % 8 == 2)
+            {
+                objective_file << ((x / 8 + y / 8) % 4);
+                objective_file << ":" << px << "," << py << "\n";
+            }
+        }
+    }
+
+    terrain_file.close();
+    collision_file.close();
+    objective_file.close();
+
+    g_Log.Flush();
+    g_Log << "[INFO] Benchmarking loads of a " << size << "x" << size;
+    g_Log << " tile level.\n";
+    g_Log.ShowLastLog();
+
+    int result = 0;
+
+    {
+        game::CTerrainMap   Terrain;
+        game::CCollisionMap Collision;
+        game::CObjectiveMap Objectives;
+
+        double start = game::CTimer::GetTime();
+        bool loaded = Terrain.Load(terrain.c_str()) &&
+            Collision.Load(collision.c_str()) &&
+            Objectives.Load(objective.c_str());
+        double text_time = game::CTimer::GetTime() - start;
+
+        if(!loaded || !game::CLevelFile::Write(compiled.c_str(),
+            Terrain, Collision, Objectives,
+            game::CLevelFile::HashSources(name)))
+        {
+            result = 1;
+        }
+        else
+        {
+            game::CTerrainMap   Compiled_Terrain;
+            game::CCollisionMap Compiled_Collision;
+            game::CObjectiveMap Compiled_Objectives;
+            game::CLevelFile    Level;
+
+            start = game::CTimer::GetTime();
+            loaded = Level.Open(compiled.c_str()) &&
+                Compiled_Terrain.Load(Level) &&
+                Compiled_Collision.Load(Level) &&
+                Compiled_Objectives.Load(Level);
+            double compiled_time = game::CTimer::GetTime() - start;
+            Level.Close();
+
+            g_Log.Flush();
+            g_Log << "[INFO] Text maps: " << text_time * 1000.0 << "ms, ";
+            g_Log << "compiled level: " << compiled_time * 1000.0 << "ms (";
+            g_Log << Compiled_Terrain.GetTiles().size() << " terrain, ";
+            g_Log << Compiled_Collision.GetTiles().size() << " wall, ";
+            g_Log << Compiled_Objectives.GetTiles().size();
+            g_Log << " objective tiles).\n";
+            g_Log.ShowLastLog();
+
+            result = loaded ? 0 : 1;
+        }
+    }
+
+    remove(terrain.c_str());
+    remove(collision.c_str());
+    remove(objective.c_str());
+    remove(compiled.c_str());
+
+    if(result != 0)
+    {
+        g_Log.Flush();
+        g_Log << "[ERROR] Load benchmark failed.\n";
+        g_Log.ShowLastLog();
+    }
+
+    return result;
+}
+
+/**
+ * Checks that a level's terrain is drawn with one call per atlas page.
+ *  The level tiles are packed the same way the engine packs them,
+ *  and every terrain tile is batched by texture. The null renderer
+ *  counts the draw calls it would have made.
+ *
+ * @param int Level number
+ * @return Zero if there are no more draw calls than pages,
+ *  non-zero otherwise.
+ **/
+int tools::check_batching(const int level_no)
+{
+    // Has to be done before the terrain map asks for its textures.
+    asset::CTextureAtlas Atlas;
+    Atlas.AddList("Data/Levels/ValidNames.dat");
+    if((!Atlas.Load("Data/Textures/Atlas") && !Atlas.Pack()) ||
+       !Atlas.Upload())
+    {
+        g_Log.Flush();
+        g_Log << "[ERROR] Failed to pack the level textures.\n";
+        g_Log.ShowLastLog();
+        return 1;
+    }
+
+    std::stringstream filename;
+    filename << "Data/Levels/Level" << level_no << game::TERRAIN_MAP_EXT;
+
+    game::CTerrainMap Terrain;
+    if(!Terrain.Load(filename.str().c_str()))
+        return 1;
+
+    const std::vector<obj::CGameObject*>& Tiles = Terrain.GetTiles();
+    gfx::CSpriteBatch Batch;
+
+    Batch.Begin(gfx::CSpriteBatch::e_SORT_TEXTURE);
+    for(size_t i = 0; i < Tiles.size(); ++i)
+    {
+        if(Tiles[i] != NULL)
+            Tiles[i]->Render(Batch);
+    }
+    Batch.End();
+
+    const u_int calls = Batch.GetDrawCallCount();
+    const u_int pages = Atlas.GetPageCount();
+
+    g_Log.Flush();
+    g_Log << "[INFO] " << filename.str() << ": " << Batch.GetSpriteCount();
+    g_Log << " tiles in " << calls << " draw call(s), " << pages;
+    g_Log << " atlas page(s).\n";
+    g_Log.ShowLastLog();
+
+    if(calls > pages)
+    {
+        g_Log.Flush();
+        g_Log << "[ERROR] Terrain took more draw calls than atlas pages.\n";
+        g_Log.ShowLastLog();
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * Finds a tile the way game::CMap did before it had a grid index.
+ *
+ * @param game::CMap& Map to search
+ * @param math::CVector2& Position to find a tile at
+ * @return The first tile containing the position, NULL if there is none.
+ **/
+static obj::CGameObject* find_tile_linear(const game::CMap& Map,
+    const math::CVector2& Position)
+{
+    const std::vector<obj::CGameObject*>& Tiles = Map.GetTiles();
+    for(size_t i = 0; i < Tiles.size(); ++i)
+        if(Tiles[i]->CheckCollision(Position.x, Position.y))
+            return Tiles[i];
+
+    return NULL;
+}
+
+/**
+ * @overload find_tile_linear(const game::CMap&, const math::CVector2&)
+ * @param math::CRect& Area to find a tile in
+ * @return The first tile touching the area, NULL if there is none.
+ **/
+static obj::CGameObject* find_tile_linear(const game::CMap& Map,
+    const math::CRect& Area)
+{
+    const std::vector<obj::CGameObject*>& Tiles = Map.GetTiles();
+    for(size_t i = 0; i < Tiles.size(); ++i)
+        if(Tiles[i]->CheckCollision(Area))
+            return Tiles[i];
+
+    return NULL;
+}
+
+/**
+ * Casts a segment against every tile of a map, with no grid index.
+ *
+ * @param game::CMap& Map to search
+ * @param math::CRay2& Segment to cast
+ * @param float& Output time of impact
+ *
+ * @return The closest tile hit, NULL if nothing was.
+ **/
+static obj::CGameObject* cast_ray_linear(const game::CMap& Map,
+    const math::CRay2& Ray, float& time)
+{
+    const std::vector<obj::CGameObject*>& Tiles = Map.GetTiles();
+    obj::CGameObject* pClosest = NULL;
+    float t;
+
+    time = 2.0f;
+    for(size_t i = 0; i < Tiles.size(); ++i)
+    {
+        if(Ray.Clip(Tiles[i]->GetCollisionBox(), t) && t < time)
+        {
+            pClosest = Tiles[i];
+            time     = t;
+        }
+    }
+
+    return pClosest;
+}
+
+/**
+ * Times tile lookups through the grid index against a linear scan.
+ *  A size x size tile collision map is generated with walls scattered
+ *  around, and the same random points, areas and segments are looked
+ *  up both ways. Both ways have to agree on what they hit.
+ *
+ * @param int Edge length of the map, in tiles
+ * @return Zero if both ways agreed, non-zero otherwise.
+ **/
+int tools::benchmark_grid(const int size)
+{
+    const std::string filename = std::string("Data/Levels/BenchGrid") +
+        game::COLLISION_MAP_EXT;
+
+    std::ofstream walls(filename.c_str());
+    for(int y = 0; y < size; ++y)
+    {
+        for(int x = 0; x < size; ++x)
+        {
+            if(rand() % 6 == 0)
+            {
+                walls << x * game::TILE_SIZE << ",";
+                walls << y * game::TILE_SIZE << "\n";
+            }
+        }
+    }
+
+    walls.close();
+
+    game::CCollisionMap Map;
+    const bool loaded = Map.Load(filename.c_str());
+    remove(filename.c_str());
+
+    if(!loaded)
+        return 1;
+
+    // The same queries for both ways.
+    const int extent = size * game::TILE_SIZE;
+    std::vector<math::CVector2> Points;
+    std::vector<math::CRect>    Areas;
+    std::vector<math::CRay2>    Rays;
+
+    for(u_int i = 0; i < BENCH_QUERIES; ++i)
+    {
+        const float x = rand() % extent + 0.5f, y = rand() % extent + 0.5f;
+        Points.push_back(math::CVector2(x, y));
+        Areas.push_back(math::CRect(rand() % extent, rand() % extent, 48, 48));
+        // Ends are off the half-pixel, so no ray runs exactly
+        // through a tile corner.
+        Rays.push_back(math::CRay2(x, y,
+            x + rand() % 513 - 255.75f, y + rand() % 513 - 256.25f));
+    }
+
+    std::vector<obj::CGameObject*> Grid_Hits(BENCH_QUERIES * 3);
+    std::vector<obj::CGameObject*> Linear_Hits(BENCH_QUERIES * 3);
+    std::vector<float> grid_times(BENCH_QUERIES), linear_times(BENCH_QUERIES);
+
+    double start = game::CTimer::GetTime();
+    for(u_int i = 0; i < BENCH_QUERIES; ++i)
+        Grid_Hits[i] = Map.FindTile(Points[i]);
+    const double grid_points = game::CTimer::GetTime() - start;
+
+    start = game::CTimer::GetTime();
+    for(u_int i = 0; i < BENCH_QUERIES; ++i)
+        Grid_Hits[BENCH_QUERIES + i] = Map.FindTile(Areas[i]);
+    const double grid_areas = game::CTimer::GetTime() - start;
+
+    start = game::CTimer::GetTime();
+    for(u_int i = 0; i < BENCH_QUERIES; ++i)
+    {
+        Grid_Hits[BENCH_QUERIES * 2 + i] =
+            Map.CastRay(Rays[i], NULL, &grid_times[i]);
+    }
+    const double grid_rays = game::CTimer::GetTime() - start;
+
+    start = game::CTimer::GetTime();
+    for(u_int i = 0; i < BENCH_QUERIES; ++i)
+        Linear_Hits[i] = find_tile_linear(Map, Points[i]);
+    const double linear_points = game::CTimer::GetTime() - start;
+
+    start = game::CTimer::GetTime();
+    for(u_int i = 0; i < BENCH_QUERIES; ++i)
+        Linear_Hits[BENCH_QUERIES + i] = find_tile_linear(Map, Areas[i]);
+    const double linear_areas = game::CTimer::GetTime() - start;
+
+    start = game::CTimer::GetTime();
+    for(u_int i = 0; i < BENCH_QUERIES; ++i)
+    {
+        Linear_Hits[BENCH_QUERIES * 2 + i] =
+            cast_ray_linear(Map, Rays[i], linear_times[i]);
+    }
+    const double linear_rays = game::CTimer::GetTime() - start;
+
+    // Points on a shared edge may pick either tile, so only
+    // whether something was hit (and when, for rays) is compared.
+    u_int mismatches = 0;
+    for(size_t i = 0; i < Grid_Hits.size(); ++i)
+    {
+        if((Grid_Hits[i] == NULL) != (Linear_Hits[i] == NULL))
+            ++mismatches;
+        else if(i >= BENCH_QUERIES * 2 && Grid_Hits[i] != NULL &&
+            fabs(grid_times[i - BENCH_QUERIES * 2] -
+                 linear_times[i - BENCH_QUERIES * 2]) > 1e-4f)
+        {
+            ++mismatches;
+        }
+    }
+
+    g_Log.Flush();
+    g_Log << "[INFO] " << size << "x" << size << " map, ";
+    g_Log << Map.GetTiles().size() << " walls, " << BENCH_QUERIES;
+    g_Log << " queries each. Grid/linear: points " << grid_points * 1000.0;
+    g_Log << "/" << linear_points * 1000.0 << "ms, areas ";
+    g_Log << grid_areas * 1000.0 << "/" << linear_areas * 1000.0;
+    g_Log << "ms, rays " << grid_rays * 1000.0 << "/";
+    g_Log << linear_rays * 1000.0 << "ms.\n";
+    g_Log.ShowLastLog();
+
+    if(mismatches > 0)
+    {
+        g_Log.Flush();
+        g_Log << "[ERROR] Grid and linear lookups disagreed on ";
+        g_Log << mismatches << " queries.\n";
+        g_Log.ShowLastLog();
+        return 1;
+    }
+
+    return 0;
+}
+
+/// A search node of solve_reference().
+struct ReferenceNode
+{
+    int             cell;
+    int             move_count;
+    int             cost;
+    ReferenceNode*  pParent;
+};
+
+/**
+ * Finds a path the way ai::CPathfinder did before ai::CPathSolver.
+ *  Every node is allocated on its own, the cheapest open node is
+ *  found by scanning the open list, and both lists are scanned to
+ *  find a neighbour. The rules are the same as the solver's, so
+ *  the paths have to be too.
+ *
+ * @see ai::CPathSolver::Solve()
+ **/
+static bool solve_reference(const ai::CPathGrid& Grid,
+    const int start_x, const int start_y,
+    const int end_x, const int end_y,
+    std::vector<int>& path)
+{
+    path.clear();
+
+    if(!Grid.IsWalkable(start_x, start_y))
+        return false;
+
+    const math::CRect& Bounds = Grid.GetBounds();
+    const int w = Bounds.w;
+
+    std::vector<ReferenceNode*> openList;
+    std::vector<ReferenceNode*> closedList;
+
+    ReferenceNode* pStart = new ReferenceNode;
+    pStart->cell        = (start_y - Bounds.y) * w + (start_x - Bounds.x);
+    pStart->move_count  = 0;
+    pStart->cost        = 0;
+    pStart->pParent     = NULL;
+    openList.push_back(pStart);
+
+    ReferenceNode* pCurrent = NULL;
+    bool found = false;
+
+    while(!openList.empty())
+    {
+        // The open list is in the order nodes were opened in, so the
+        // first of the cheapest is the one the solver would take.
+        size_t index = 0;
+        for(size_t i = 1; i < openList.size(); ++i)
+            if(openList[i]->cost < openList[index]->cost)
+                index = i;
+
+        pCurrent = openList[index];
+        openList.erase(openList.begin() + index);
+        closedList.push_back(pCurrent);
+
+        const int cx = pCurrent->cell % w + Bounds.x;
+        const int cy = pCurrent->cell / w + Bounds.y;
+
+        if(cx == end_x && cy == end_y)
+        {
+            found = true;
+            break;
+        }
+
+        if(Grid.IsBlocked(cx, cy))
+            continue;
+
+        for(int x = -1; x <= 1; x++)
+        {
+            for(int y = -1; y <= 1; y++)
+            {
+                if(!Grid.IsWalkable(cx + x, cy + y))
+                    continue;
+
+                const int next = pCurrent->cell + (y * w) + x;
+                const int move_count = pCurrent->move_count + 1;
+                bool seen = false;
+
+                for(size_t i = 0; i < closedList.size() && !seen; ++i)
+                    seen = (closedList[i]->cell == next);
+
+                for(size_t i = 0; i < openList.size() && !seen; ++i)
+                {
+                    if(openList[i]->cell != next)
+                        continue;
+
+                    seen = true;
+                    if(move_count < openList[i]->move_count)
+                    {
+                        openList[i]->cost -= openList[i]->move_count -
+                            move_count;
+                        openList[i]->move_count = move_count;
+                        openList[i]->pParent    = pCurrent;
+                    }
+                }
+
+                if(seen)
+                    continue;
+
+                ReferenceNode* pNext = new ReferenceNode;
+                pNext->cell         = next;
+                pNext->move_count   = move_count;
+                pNext->cost         = move_count +
+                    abs(end_x - (cx + x)) + abs(end_y - (cy + y));
+                pNext->pParent      = pCurrent;
+                openList.push_back(pNext);
+            }
+        }
+    }
+
+    for(ReferenceNode* pNode = pCurrent; pNode != NULL; pNode = pNode->pParent)
+        path.push_back(pNode->cell);
+
+    for(size_t i = 0; i < openList.size(); ++i)
+        delete openList[i];
+    for(size_t i = 0; i < closedList.size(); ++i)
+        delete closedList[i];
+
+    return found;
+}
+
+/**
+ * Picks random start and end cells that a path can be found between.
+ *
+ * @param ai::CPathGrid& Grid to pick cells from
+ * @param u_int Number of pairs
+ * @param int Largest distance between the cells, 0 for any
+ * @param std::vector<int>& Output pairs, as start x, y, end x, y
+ **/
+static void pick_path_pairs(const ai::CPathGrid& Grid, const u_int count,
+    const int reach, std::vector<int>& pairs)
+{
+    const math::CRect& Bounds = Grid.GetBounds();
+    std::vector<int> cells;
+
+    for(int y = Bounds.y; y < Bounds.y + (int)Bounds.h; ++y)
+    {
+        for(int x = Bounds.x; x < Bounds.x + (int)Bounds.w; ++x)
+        {
+            if(Grid.IsWalkable(x, y) && !Grid.IsBlocked(x, y))
+            {
+                cells.push_back(x);
+                cells.push_back(y);
+            }
+        }
+    }
+
+    pairs.clear();
+    if(cells.empty())
+        return;
+
+    const int open = cells.size() / 2;
+    while(pairs.size() / 4 < count)
+    {
+        const int start = rand() % open;
+        const int sx = cells[start * 2], sy = cells[start * 2 + 1];
+        int ex = sx, ey = sy;
+
+        if(reach == 0)
+        {
+            const int end = rand() % open;
+            ex = cells[end * 2];
+            ey = cells[end * 2 + 1];
+        }
+        else
+        {
+            // Give up on starts with nowhere open near them.
+            for(int tries = 0; tries < 100; ++tries)
+            {
+                ex = sx + rand() % (reach * 2 + 1) - reach;
+                ey = sy + rand() % (reach * 2 + 1) - reach;
+                if(Grid.IsWalkable(ex, ey) && !Grid.IsBlocked(ex, ey))
+                    break;
+
+                ex = sx; ey = sy;
+            }
+        }
+
+        pairs.push_back(sx); pairs.push_back(sy);
+        pairs.push_back(ex); pairs.push_back(ey);
+    }
+}
+
+/**
+ * Times path queries, and optionally checks them against
+ * solve_reference().
+ *
+ * @param ai::CPathGrid& Grid to search
+ * @param std::vector<int>& Pairs, as from pick_path_pairs()
+ * @param bool Also time the reference search and compare paths
+ * @param char* Name for the log
+ *
+ * @return TRUE if the paths matched (or weren't compared), FALSE
+ *  otherwise.
+ **/
+static bool time_paths(const ai::CPathGrid& Grid,
+    const std::vector<int>& pairs, const bool compare, const char* pname)
+{
+    const size_t count = pairs.size() / 4;
+    std::vector<std::vector<int> > paths(count);
+    std::vector<int> path;
+    ai::CPathSolver Solver;
+    u_int found = 0, mismatches = 0;
+
+    double start = game::CTimer::GetTime();
+    for(size_t i = 0; i < count; ++i)
+    {
+        if(Solver.Solve(Grid, pairs[i * 4], pairs[i * 4 + 1],
+            pairs[i * 4 + 2], pairs[i * 4 + 3], paths[i]))
+        {
+            ++found;
+        }
+    }
+    const double solver_time = game::CTimer::GetTime() - start;
+    double reference_time = 0.0;
+
+    if(compare)
+    {
+        start = game::CTimer::GetTime();
+        for(size_t i = 0; i < count; ++i)
+        {
+            solve_reference(Grid, pairs[i * 4], pairs[i * 4 + 1],
+                pairs[i * 4 + 2], pairs[i * 4 + 3], path);
+            if(path != paths[i])
+                ++mismatches;
+        }
+        reference_time = game::CTimer::GetTime() - start;
+    }
+
+    g_Log.Flush();
+    g_Log << "[INFO] " << pname << ": " << count << " paths, " << found;
+    g_Log << " found. Solver: " << solver_time * 1000.0 << "ms";
+    if(compare)
+        g_Log << ", reference: " << reference_time * 1000.0 << "ms";
+    g_Log << ".\n";
+    g_Log.ShowLastLog();
+
+    if(mismatches > 0)
+    {
+        g_Log.Flush();
+        g_Log << "[ERROR] " << pname << ": " << mismatches;
+        g_Log << " path(s) differ from the reference search.\n";
+        g_Log.ShowLastLog();
+    }
+
+    return (mismatches == 0);
+}
+
+/**
+ * Times the pathfinder on random start and end cells.
+ *  Paths are found on level 1 and on a generated maze of rooms, and
+ *  checked against a search done the way ai::CPathfinder used to.
+ *  The reference search is far too slow for paths across the whole
+ *  maze, so it's only compared on short paths there. The generated
+ *  files are removed afterwards.
+ *
+ * @param u_int Number of paths to find on each map
+ * @return Zero if every compared path matched, non-zero otherwise.
+ **/
+int tools::benchmark_paths(const u_int pairs)
+{
+    std::vector<int> ends;
+    bool matched = true;
+
+    {
+        game::CLevel Level;
+        if(!Level.LoadLevel(1))
+            return 1;
+
+        ai::CPathGrid Grid;
+        Grid.Build(&Level);
+
+        pick_path_pairs(Grid, pairs, 0, ends);
+        matched = time_paths(Grid, ends, true, "Level 1") && matched;
+    }
+
+    std::ifstream names_file("Data/Levels/ValidNames.dat");
+    std::string texture;
+    while(std::getline(names_file, texture))
+    {
+        if(!texture.empty() && texture[0] != '/')
+            break;
+    }
+
+    // Rooms of 7x7 tiles, with walls between them and doorways of
+    // 3 tiles (wide enough to pass) in about two thirds of the walls.
+    const std::string name = "Data/Levels/BenchMaze";
+    const int rooms = BENCH_MAZE_SIZE / 8;
+    std::vector<bool> h_doors(rooms * rooms), v_doors(rooms * rooms);
+    for(size_t i = 0; i < h_doors.size(); ++i)
+    {
+        h_doors[i] = (rand() % 3 != 0);
+        v_doors[i] = (rand() % 3 != 0);
+    }
+
+    std::ofstream terrain_file((name + game::TERRAIN_MAP_EXT).c_str());
+    std::ofstream collision_file((name + game::COLLISION_MAP_EXT).c_str());
+    std::ofstream objective_file((name + game::OBJ_MAP_EXT).c_str());
+
+    for(int y = 0; y < BENCH_MAZE_SIZE; ++y)
+    {
+        for(int x = 0; x < BENCH_MAZE_SIZE; ++x)
+        {
+            const int px = x * game::TILE_SIZE, py = y * game::TILE_SIZE;
+            const int room = (y / 8) * rooms + (x / 8);
+            const bool door_x = (x % 8 >= 3 && x % 8 <= 5);
+            const bool door_y = (y % 8 >= 3 && y % 8 <= 5);
+
+            terrain_file << texture << ":" << px << "," << py << "\n";
+
+            if((x % 8 == 0 && !(door_y && v_doors[room])) ||
+               (y % 8 == 0 && !(door_x && h_doors[room])))
+            {
+                collision_file << px << "," << py << "\n";
+            }
+        }
+    }
+
+    terrain_file.close();
+    collision_file.close();
+    objective_file.close();
+
+    {
+        game::CLevel Maze;
+        if(Maze.LoadLevel(name, false))
+        {
+            ai::CPathGrid Grid;
+            Grid.Build(&Maze);
+
+            pick_path_pairs(Grid, pairs, 0, ends);
+            time_paths(Grid, ends, false, "Maze");
+
+            pick_path_pairs(Grid, pairs, 12, ends);
+            matched = time_paths(Grid, ends, true, "Maze, short paths") &&
+                matched;
+        }
+        else
+        {
+            matched = false;
+        }
+    }
+
+    remove((name + game::TERRAIN_MAP_EXT).c_str());
+    remove((name + game::COLLISION_MAP_EXT).c_str());
+    remove((name + game::OBJ_MAP_EXT).c_str());
+    remove((name + game::LEVEL_FILE_EXT).c_str());
+
+    return matched ? 0 : 1;
+}
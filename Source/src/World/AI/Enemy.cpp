@@ -34,7 +34,8 @@ CEnemy::CEnemy(game::CLevel* pCurrentLevel,
     m_tactic(e_PATROLLING),
     m_state(e_NONE),
     m_axis_to_player(0.0f),
-    m_axis_to_path(0.0f)
+    m_axis_to_path(0.0f),
+    m_scan_rate(3.0f)
 {
     m_id = p_allEnemies.size();
     p_allEnemies.push_back(this);
@@ -60,9 +61,12 @@ CEnemy::~CEnemy()
 
 /**
  * Gives the AI a destination to move towards.
- *  Uses the A* algorithm to find the path, if it exists.
+ *  The path is requested from the pathfinder, sent off to be solved
+ *  by the next Act(), and picked up by CollectPath() once it's
+ *  solved; until then, the enemy keeps following its current path.
  *
  * @param math::CVector2& Destination
+ * @see ai::CEnemy::CollectPath()
  **/        
 void CEnemy::SetDestination(const math::CVector2& Position)
 {
@@ -81,8 +85,25 @@ void CEnemy::SetDestination(const math::CVector2& Position)
 #endif // _DEBUG
 
     // A* for the path.
+    m_Pathfinder.RequestPath(p_CurrentTile, p_Destination);
+}
+
+/**
+ * Switches over to a newly solved path, if there is one.
+ *  Should be called once per frame, before processing AI.
+ *
+ * @see ai::CEnemy::SetDestination()
+ **/
+void CEnemy::CollectPath()
+{
+    ai::CPathfinder::PathStatus status = m_Pathfinder.Collect();
+
+    if(status == ai::CPathfinder::e_NO_REQUEST ||
+       status == ai::CPathfinder::e_WAITING)
+        return;
+
     /// @todo If there's no available path, find another point of interest.
-    if(!m_Pathfinder.FindPath(p_CurrentTile, p_Destination))
+    if(status == ai::CPathfinder::e_NOT_FOUND)
     {
 #ifdef _DEBUG
         printf("[DEBUG] No path found.\n");
@@ -163,3 +184,33 @@ int CEnemy::GetID()
 {
     return m_id;
 }
+
+/**
+ * Updates the line-of-sight of every enemy.
+ *  All of the sight lines are aimed first, then cut off at the walls
+ *  in a single pass over the collision grid.
+ *
+ * @param game::CCollisionMap& Walls that block sight
+ * @see game::CMap::CastRays()
+ **/
+void CEnemy::UpdateAllLOS(const game::CCollisionMap& Walls)
+{
+    static std::vector<math::CRay2> Rays;
+    Rays.clear();
+
+    for(CEnemies::iterator i = p_allEnemies.begin();
+        i != p_allEnemies.end(); ++i)
+    {
+        (*i)->AimLOS();
+        Rays.push_back((*i)->m_LineOfSight);
+    }
+
+    Walls.CastRays(Rays);
+
+    size_t index = 0;
+    for(CEnemies::iterator i = p_allEnemies.begin();
+        i != p_allEnemies.end(); ++i, ++index)
+    {
+        (*i)->m_LineOfSight.End = Rays[index].End;
+    }
+}
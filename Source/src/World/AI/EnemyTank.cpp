@@ -18,7 +18,7 @@ using asset::CAssetManager;
  **/       
 CEnemyTank::CEnemyTank(game::CLevel* pCurrentLevel,
     const obj::CPlayer& Player) : 
-    CEnemy(pCurrentLevel, Player) {}
+    CEnemy(pCurrentLevel, Player), m_wants_fire(false) {}
 
 bool CEnemyTank::Init(game::CSettings& Settings)
 {
@@ -52,20 +52,15 @@ void CEnemyTank::Spawn(const math::CVector2& Pos)
     this->AddState(e_PATHFINDING);
 }
 
-void CEnemyTank::Adjust(const math::CVector2& Rate)
-{
-    CTank::Adjust(Rate);
-}
-
 /**
- * Updates the enemy.
- *  All rendering of tank and tower entities is done here, as well
- *  as AI processing and, in case of a debug build, paths and
- *  states are rendered or printed.
+ * Decides what to do this tick.
+ *  AI processing is done here: the tank turns and drives along its
+ *  path and aims its tower, but weapons and path requests are left
+ *  for Act().
  *
- * @return The current enemy state.
- **/       
-int CEnemyTank::Update()
+ * @see ai::CEnemy::Think()
+ **/
+void CEnemyTank::Think()
 {
     // Remove firing states, because without this, the enemy fires
     // continuously regardless of reloading status.
@@ -73,26 +68,82 @@ int CEnemyTank::Update()
     this->RemoveState(e_FIRING_PRIMARY);
     this->RemoveState(e_FIRING_SECONDARY);
 
+    // Pick up any path that finished solving since last frame.
+    this->CollectPath();
+
     // Process AI based on player location and other factors.
     this->ProcessAI();
-    this->UpdateLOS();
-
-    // Show the A* path (debugging only)
-#ifdef _DEBUG
-    m_Pathfinder.ShowPath();
 
     // Print the current state and tactic (debugging only)
+#ifdef _DEBUG
     //PrintState(m_state);
     //printf("[DEBUG] AI Tactic: %s\n", m_tactic == e_PATROLLING ? 
     //    "patrol" : m_tactic == e_ATTACKING ? "attack" : "search");
 #endif // _DEBUG
+}
+
+/**
+ * Carries out the last Think().
+ *  Weapons are fired (which plays their sounds), any new path is
+ *  sent off to be solved, then the tank and weapons are moved.
+ *
+ * @return The current enemy state.
+ **/
+int CEnemyTank::Act()
+{
+    if(m_wants_fire)
+    {
+        m_wants_fire = false;
+
+        // Try and fire main gun.
+        if(m_Weapon1.Fire())
+            this->AddState(e_FIRING_PRIMARY);
+
+        // If unable, try and fire the secondary.
+        else
+        {
+            this->AddState(e_RELOADING_PRIMARY);
+            if(m_Weapon2.Fire())
+                this->AddState(e_FIRING_SECONDARY);
+            else
+                this->AddState(e_RELOADING_SECONDARY);
+        }
+    }
+
+    m_Pathfinder.Submit();
 
     // Update tank and weapons.
-    CTank::Update();
+    CTank::Tick();
 
     return m_state;
 }
 
+/**
+ * Advances the enemy by a simulation tick.
+ * @return The current enemy state.
+ **/
+int CEnemyTank::Tick()
+{
+    this->Think();
+    return this->Act();
+}
+
+/**
+ * Draws the enemy tank.
+ *  In debug builds, the A* path is drawn underneath it.
+ *
+ * @param gfx::CSpriteBatch& Batch to draw in, which has to be active
+ * @param float How far along the next tick is, [0, 1] (optional)
+ **/
+void CEnemyTank::Render(gfx::CSpriteBatch& Batch, const float alpha) const
+{
+#ifdef _DEBUG
+    m_Pathfinder.ShowPath(Batch);
+#endif // _DEBUG
+
+    CTank::Render(Batch, alpha);
+}
+
 /// Processes AI actions based on tactics.
 void CEnemyTank::ProcessAI()
 {
@@ -119,9 +170,6 @@ void CEnemyTank::ProcessAI()
 
     if(m_state & e_PATHFINDING)
         this->FollowPath();
-
-    // Update the current line-of-sight to reflect current location.
-    this->UpdateLOS();
 }
 
 /**
@@ -142,13 +190,14 @@ void CEnemyTank::OnPatrolling()
         return;
 
     // If we're done with our path, just go back to where we started from.
-    if(m_state & e_DONE)
+    // A path that's still being solved will set e_DONE again if needed.
+    if((m_state & e_DONE) && !m_Pathfinder.IsWaiting())
     {
         this->RemoveState(e_DONE);
         obj::CEntity* p_Dest = mp_Level->GetObjectiveMap().GetNearestPOI(
             m_Tank.GetPosition());
         this->SetDestination(p_Dest->GetPosition());
-        if(mp_DestinationTile == NULL)
+        if(mp_DestinationTile == NULL && !m_Pathfinder.IsWaiting())
             this->AddState(e_DONE);
         else
             this->AddState(e_PATHFINDING);
@@ -159,22 +208,19 @@ void CEnemyTank::OnPatrolling()
     // both directions from the tank front-center position, with a slight
     // pause upon reaching the end-points.
 
-    // This is the direction in which to rotate the tower.
-    static float rotation_speed = 3.0f;
-
     // Check that the rotation angle is within the closed interval
     // [Tower Rotation - 90, Tower Rotation + 90]
     if((m_Tower.GetRotationAngle() >= 90.0f + m_Tank.GetRotationAngle() &&
-        rotation_speed == 3.0f) ||
+        m_scan_rate == 3.0f) ||
 
         (m_Tower.GetRotationAngle() <= m_Tank.GetRotationAngle() - 90.0f &&
-        rotation_speed == -3.0f))
+        m_scan_rate == -3.0f))
     {
-        rotation_speed = -rotation_speed;
+        m_scan_rate = -m_scan_rate;
     }
     else
     {
-        this->RotateTower(rotation_speed);
+        this->RotateTower(m_scan_rate);
     }
 
     // Check if player is in line-of-sight. If he is, calculate the angle
@@ -260,19 +306,8 @@ void CEnemyTank::OnAttacking()
         }
     }
 
-    // Try and fire main gun.
-    if(m_Weapon1.Fire())
-        this->AddState(e_FIRING_PRIMARY);
-
-    // If unable, try and fire the secondary.
-    else
-    {
-        this->AddState(e_RELOADING_PRIMARY);
-        if(m_Weapon2.Fire())
-            this->AddState(e_FIRING_SECONDARY);
-        else
-            this->AddState(e_RELOADING_SECONDARY);
-    }
+    // Open fire once we're back on the main thread.
+    m_wants_fire = true;
 }
 
 /**
@@ -297,7 +332,7 @@ void CEnemyTank::OnSearching()
     // go back to patrolling.
     /// @todo Find the nearest point-of-interest rather than just choosing
     /// a random spot on the map.
-    if(m_state == e_DONE)
+    if(m_state == e_DONE && !m_Pathfinder.IsWaiting())
     {
 #ifdef _DEBUG
         printf("[DEBUG] Search path done!\n");
@@ -306,7 +341,7 @@ void CEnemyTank::OnSearching()
         obj::CEntity* p_Dest = mp_Level->GetObjectiveMap().GetNearestPOI(
             m_Tank.GetPosition());
         this->SetDestination(p_Dest->GetPosition());
-        if(mp_DestinationTile == NULL)
+        if(mp_DestinationTile == NULL && !m_Pathfinder.IsWaiting())
             this->AddState(e_DONE);
         else
             this->AddState(e_PATHFINDING);
@@ -319,9 +354,6 @@ void CEnemyTank::OnSearching()
     // But rather than rotating just 90 degrees from the tank front, 
     // rotate 90 degrees from the axis at which the player was spotted.
 
-    // This is the direction in which to rotate the tower.
-    static float rotation_speed = 3.0f;
-
     // Calculate the angle towards the player.
     float to_player = math::deg(atan2(
         this->GetPosition().x - m_Player.GetPosition().x,
@@ -330,14 +362,14 @@ void CEnemyTank::OnSearching()
     // Check that the rotation angle is within the closed interval
     // [Last spotted - 90, Last spotted + 90]
     if((m_Tower.GetRotationAngle() >= 90.0f + to_player &&
-        rotation_speed == 3.0f) ||
+        m_scan_rate == 3.0f) ||
         (m_Tower.GetRotationAngle() <= to_player - 90.0f &&
-        rotation_speed == -3.0f))
+        m_scan_rate == -3.0f))
     {
-        rotation_speed = -rotation_speed;
+        m_scan_rate = -m_scan_rate;
     }
 
-    this->RotateTower(rotation_speed);
+    this->RotateTower(m_scan_rate);
 
     // Similarly to patrolling, check if player is in line-of-sight.
     // If he is, calculate the angle toward him (for the pathfinding),
@@ -474,11 +506,12 @@ void CEnemyTank::FollowPath()
 }
 
 /**
- * Updates the tank's line-of-sight vector.
+ * Points the tank's line-of-sight vector where the tower is facing.
  *   Since the tank is constantly moving, it needs to constantly be 
- *   updating it's line-of-sight to find the player properly.
+ *   updating it's line-of-sight to find the player properly. Walls
+ *   are taken care of by CEnemy::UpdateAllLOS().
  **/        
-void CEnemyTank::UpdateLOS()
+void CEnemyTank::AimLOS()
 {
     // Refreshes barrel pos.
     this->RotateTower(0);
@@ -494,16 +527,6 @@ void CEnemyTank::UpdateLOS()
     m_LineOfSight = m_LineOfSight - Tank_Center;
     m_LineOfSight.End.Rotate(math::rad(m_Tower.GetRotationAngle()));
     m_LineOfSight = m_LineOfSight + Tank_Center;
-
-    // Cut off at walls
-    const std::vector<obj::CGameObject*>& p_allTiles = 
-        mp_Level->GetCollisionMap().GetTiles();
-    math::CVector2 Intersection;
-    for(size_t i = 0; i < p_allTiles.size(); ++i)
-    {
-        if(m_LineOfSight.CheckCollision(p_allTiles[i]->GetCollisionBox(), &Intersection))
-            m_LineOfSight.End = Intersection;
-    }
 }
 
 /**
@@ -0,0 +1,108 @@
+/**
+ * @file
+ *  Definitions for the CPathGrid class.
+ *
+ * @author George Kudrayvtsev
+ * @version 1.0
+ **/
+
+#include "World/AI/PathGrid.hpp"
+
+using ai::CPathGrid;
+
+CPathGrid::CPathGrid() : mp_Level(NULL), m_terrain_revision(0),
+    m_collision_revision(0), m_refs(0) {}
+
+/**
+ * Takes a snapshot of a level.
+ *  Must be called from the thread that owns the level.
+ *
+ * @param game::CLevel* Level to snapshot
+ **/
+void CPathGrid::Build(game::CLevel* pLevel)
+{
+    const game::CTerrainMap& Terrain = pLevel->GetTerrainMap();
+    const game::CCollisionMap& Collision = pLevel->GetCollisionMap();
+
+    mp_Level = pLevel;
+    m_terrain_revision   = Terrain.GetRevision();
+    m_collision_revision = Collision.GetRevision();
+    m_Bounds = Terrain.GetIndexBounds();
+    m_cells.assign(m_Bounds.w * m_Bounds.h, 0);
+
+    for(u_int y = 0; y < m_Bounds.h; ++y)
+    {
+        for(u_int x = 0; x < m_Bounds.w; ++x)
+        {
+            int cx = m_Bounds.x + x, cy = m_Bounds.y + y;
+            if(Terrain.GetTileAt(cx, cy) == NULL)
+                continue;
+
+            unsigned char& cell = m_cells[y * m_Bounds.w + x];
+            cell |= e_WALKABLE;
+
+            // Same check the pathfinder always did: does a slightly
+            // larger box around the tile touch a wall?
+            math::CRect Checker(cx * game::TILE_SIZE - 1,
+                cy * game::TILE_SIZE - 1, 34, 34);
+            if(Collision.FindTile(Checker) != NULL)
+                cell |= e_BLOCKED;
+        }
+    }
+}
+
+/**
+ * Checks if the snapshot still matches a level.
+ *
+ * @param game::CLevel* Level to compare against
+ * @return TRUE if neither the terrain nor the walls changed since
+ *  the snapshot was taken, FALSE otherwise.
+ **/
+bool CPathGrid::IsCurrent(game::CLevel* pLevel) const
+{
+    return (mp_Level == pLevel &&
+        m_terrain_revision   == pLevel->GetTerrainMap().GetRevision() &&
+        m_collision_revision == pLevel->GetCollisionMap().GetRevision());
+}
+
+/**
+ * Checks if a cell has terrain to move on.
+ *
+ * @param int Cell x-coordinate
+ * @param int Cell y-coordinate
+ * @return TRUE if walkable, FALSE if not or outside of the grid.
+ **/
+bool CPathGrid::IsWalkable(const int cx, const int cy) const
+{
+    if(cx < m_Bounds.x || cy < m_Bounds.y ||
+       cx >= m_Bounds.x + (int)m_Bounds.w ||
+       cy >= m_Bounds.y + (int)m_Bounds.h)
+        return false;
+
+    return (m_cells[(cy - m_Bounds.y) * m_Bounds.w +
+        (cx - m_Bounds.x)] & e_WALKABLE) != 0;
+}
+
+/**
+ * Checks if a cell is too close to a wall to move out of.
+ *
+ * @param int Cell x-coordinate
+ * @param int Cell y-coordinate
+ * @return TRUE if blocked, FALSE otherwise.
+ * @pre The cell is inside the grid.
+ **/
+bool CPathGrid::IsBlocked(const int cx, const int cy) const
+{
+    return (m_cells[(cy - m_Bounds.y) * m_Bounds.w +
+        (cx - m_Bounds.x)] & e_BLOCKED) != 0;
+}
+
+/**
+ * Retrieves the grid bounds.
+ * @return First cell (x, y) and dimensions (w, h), in cells.
+ * @see game::CMap::GetIndexBounds()
+ **/
+const math::CRect& CPathGrid::GetBounds() const
+{
+    return m_Bounds;
+}
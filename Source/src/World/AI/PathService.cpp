@@ -0,0 +1,424 @@
+/**
+ * @file
+ *  Definitions for the CPathService class.
+ *
+ * @author George Kudrayvtsev
+ * @version 1.0
+ **/
+
+#include "Timer.hpp"
+#include "World/AI/PathService.hpp"
+
+using ai::CPathService;
+using game::g_Log;
+
+CPathService::CPathService() : mp_Lock(NULL), mp_JobReady(NULL),
+    mp_JobDone(NULL), mp_Grid(NULL), m_next_ticket(1), m_running(false),
+    m_solved_count(0), m_total_time(0.0), m_max_time(0.0) {}
+
+CPathService::~CPathService()
+{
+    this->Shutdown();
+}
+
+CPathService& CPathService::GetInstance()
+{
+    static CPathService Service;
+    return Service;
+}
+
+/**
+ * Starts up the worker threads.
+ *
+ * @param u_int Number of worker threads, 0 solves requests inline
+ * @return TRUE if everything started, FALSE if a thread failed to
+ *  start. Requests are still serviced by the threads that did.
+ **/
+bool CPathService::Init(const u_int thread_count)
+{
+    if(mp_Lock != NULL)
+        return true;
+
+    mp_Lock     = SDL_CreateMutex();
+    mp_JobReady = SDL_CreateCond();
+    mp_JobDone  = SDL_CreateCond();
+    m_running   = true;
+
+    for(u_int i = 0; i < thread_count; ++i)
+    {
+        SDL_Thread* pThread = SDL_CreateThread(
+            &CPathService::WorkerThread, this);
+
+        if(pThread == NULL)
+        {
+            g_Log.Flush();
+            g_Log << "[ERROR] Failed to start pathfinding thread: ";
+            g_Log << SDL_GetError() << "\n";
+            return false;
+        }
+
+        mp_allThreads.push_back(pThread);
+    }
+
+    g_Log.Flush();
+    g_Log << "[INFO] Started " << mp_allThreads.size();
+    g_Log << " pathfinding thread(s).\n";
+
+    return true;
+}
+
+/**
+ * Stops the worker threads and throws away any unfinished requests.
+ *  Solve-time statistics are written to the log.
+ **/
+void CPathService::Shutdown()
+{
+    if(mp_Lock == NULL)
+        return;
+
+    SDL_mutexP(mp_Lock);
+    m_running = false;
+    SDL_CondBroadcast(mp_JobReady);
+    SDL_mutexV(mp_Lock);
+
+    for(size_t i = 0; i < mp_allThreads.size(); ++i)
+        SDL_WaitThread(mp_allThreads[i], NULL);
+
+    mp_allThreads.clear();
+
+    for(std::map<u_int, PathJob*>::iterator i = mp_allJobs.begin();
+        i != mp_allJobs.end(); ++i)
+    {
+        if(i->second->pGrid != NULL)
+            this->ReleaseGrid(i->second->pGrid);
+
+        delete i->second;
+    }
+
+    mp_allJobs.clear();
+    mp_allPending.clear();
+
+    if(mp_Grid != NULL)
+        this->ReleaseGrid(mp_Grid);
+
+    mp_Grid = NULL;
+
+    SDL_DestroyCond(mp_JobDone);
+    SDL_DestroyCond(mp_JobReady);
+    SDL_DestroyMutex(mp_Lock);
+    mp_JobDone = mp_JobReady = NULL;
+    mp_Lock = NULL;
+
+    g_Log.Flush();
+    g_Log << "[INFO] Pathfinding: " << m_solved_count << " paths solved, ";
+    g_Log << this->GetAverageSolveTime() << "ms average, ";
+    g_Log << m_max_time << "ms worst.\n";
+}
+
+/**
+ * Requests a path between two terrain grid cells.
+ *  If the level changed since the last request, a new snapshot of
+ *  it is taken first.
+ *
+ * @param game::CLevel* Level to search
+ * @param int Start cell x-coordinate
+ * @param int Start cell y-coordinate
+ * @param int End cell x-coordinate
+ * @param int End cell y-coordinate
+ *
+ * @return A ticket to collect the result with.
+ *
+ * @pre Init() has been called.
+ * @see game::CMap::GetTileCell()
+ **/
+u_int CPathService::Submit(game::CLevel* pLevel,
+    const int start_x, const int start_y,
+    const int end_x, const int end_y)
+{
+    // Only this thread ever replaces the snapshot, so reading it
+    // without the lock is fine.
+    ai::CPathGrid* pFresh = NULL;
+    if(mp_Grid == NULL || !mp_Grid->IsCurrent(pLevel))
+    {
+        pFresh = new ai::CPathGrid;
+        pFresh->Build(pLevel);
+    }
+
+    PathJob* pJob   = new PathJob;
+    pJob->state     = e_QUEUED;
+    pJob->cancelled = false;
+    pJob->start_x   = start_x;
+    pJob->start_y   = start_y;
+    pJob->end_x     = end_x;
+    pJob->end_y     = end_y;
+    pJob->Result.found = false;
+
+    SDL_mutexP(mp_Lock);
+
+    if(pFresh != NULL)
+    {
+        if(mp_Grid != NULL)
+            this->ReleaseGrid(mp_Grid);
+
+        mp_Grid = pFresh;
+        mp_Grid->m_refs = 1;
+    }
+
+    pJob->pGrid = mp_Grid;
+    ++mp_Grid->m_refs;
+
+    u_int ticket = m_next_ticket++;
+    if(m_next_ticket == 0)
+        m_next_ticket = 1;
+
+    mp_allJobs[ticket] = pJob;
+
+    if(mp_allThreads.empty())
+    {
+        SDL_mutexV(mp_Lock);
+        this->SolveJob(m_Solver, pJob);
+        return ticket;
+    }
+
+    mp_allPending.push_back(pJob);
+    SDL_CondSignal(mp_JobReady);
+    SDL_mutexV(mp_Lock);
+
+    return ticket;
+}
+
+/**
+ * Picks up the result of a request, if it's ready.
+ *  Once collected, the ticket is no longer valid.
+ *
+ * @param u_int Ticket from Submit()
+ * @param ai::PathResult& Output result
+ *
+ * @return TRUE if the request is finished, FALSE if it's still
+ *  waiting to be solved. Unknown tickets are treated as finished
+ *  requests that found no path.
+ **/
+bool CPathService::Collect(const u_int ticket, ai::PathResult& Result)
+{
+    SDL_mutexP(mp_Lock);
+
+    std::map<u_int, PathJob*>::iterator i = mp_allJobs.find(ticket);
+    if(i == mp_allJobs.end())
+    {
+        SDL_mutexV(mp_Lock);
+        Result.found = false;
+        Result.cells.clear();
+        return true;
+    }
+
+    if(i->second->state != e_FINISHED)
+    {
+        SDL_mutexV(mp_Lock);
+        return false;
+    }
+
+    PathJob* pJob = i->second;
+    mp_allJobs.erase(i);
+    SDL_mutexV(mp_Lock);
+
+    Result.found  = pJob->Result.found;
+    Result.Bounds = pJob->Result.Bounds;
+    Result.cells.swap(pJob->Result.cells);
+    delete pJob;
+
+    return true;
+}
+
+/**
+ * Blocks until a request is finished.
+ * @param u_int Ticket from Submit()
+ **/
+void CPathService::Wait(const u_int ticket)
+{
+    SDL_mutexP(mp_Lock);
+
+    std::map<u_int, PathJob*>::iterator i = mp_allJobs.find(ticket);
+    while(i != mp_allJobs.end() && i->second->state != e_FINISHED)
+    {
+        SDL_CondWait(mp_JobDone, mp_Lock);
+        i = mp_allJobs.find(ticket);
+    }
+
+    SDL_mutexV(mp_Lock);
+}
+
+/**
+ * Gives up on a request.
+ *  Requests that are currently being solved are thrown away
+ *  by the worker once it's done with them.
+ *
+ * @param u_int Ticket from Submit()
+ **/
+void CPathService::Cancel(const u_int ticket)
+{
+    SDL_mutexP(mp_Lock);
+
+    std::map<u_int, PathJob*>::iterator i = mp_allJobs.find(ticket);
+    if(i != mp_allJobs.end())
+    {
+        PathJob* pJob = i->second;
+        mp_allJobs.erase(i);
+
+        if(pJob->state == e_SOLVING)
+        {
+            pJob->cancelled = true;
+        }
+        else
+        {
+            if(pJob->state == e_QUEUED)
+            {
+                mp_allPending.remove(pJob);
+                this->ReleaseGrid(pJob->pGrid);
+            }
+
+            delete pJob;
+        }
+    }
+
+    SDL_mutexV(mp_Lock);
+}
+
+/**
+ * Retrieves the number of requests waiting for a worker.
+ * @return The queue depth.
+ **/
+u_int CPathService::GetQueueDepth() const
+{
+    SDL_mutexP(mp_Lock);
+    u_int depth = mp_allPending.size();
+    SDL_mutexV(mp_Lock);
+
+    return depth;
+}
+
+/**
+ * Retrieves the number of requests solved so far.
+ * @return The solved count.
+ **/
+u_int CPathService::GetSolvedCount() const
+{
+    return m_solved_count;
+}
+
+/**
+ * Retrieves the longest time spent solving a single request.
+ * @return The solve time, in milliseconds.
+ **/
+double CPathService::GetMaxSolveTime() const
+{
+    return m_max_time;
+}
+
+/**
+ * Retrieves the average time spent solving a request.
+ * @return The solve time, in milliseconds.
+ **/
+double CPathService::GetAverageSolveTime() const
+{
+    if(m_solved_count == 0)
+        return 0.0;
+
+    return m_total_time / m_solved_count;
+}
+
+/**
+ * Worker thread loop.
+ *  Takes requests off the queue and solves them until the
+ *  service is shut down.
+ *
+ * @param void* The path service
+ * @return 0
+ **/
+int CPathService::WorkerThread(void* pData)
+{
+    CPathService* pService = static_cast<CPathService*>(pData);
+    ai::CPathSolver Solver;
+
+    SDL_mutexP(pService->mp_Lock);
+
+    while(true)
+    {
+        while(pService->m_running && pService->mp_allPending.empty())
+            SDL_CondWait(pService->mp_JobReady, pService->mp_Lock);
+
+        if(!pService->m_running)
+            break;
+
+        PathJob* pJob = pService->mp_allPending.front();
+        pService->mp_allPending.pop_front();
+        pJob->state = e_SOLVING;
+
+        SDL_mutexV(pService->mp_Lock);
+        pService->SolveJob(Solver, pJob);
+        SDL_mutexP(pService->mp_Lock);
+    }
+
+    SDL_mutexV(pService->mp_Lock);
+    return 0;
+}
+
+/**
+ * Searches a request's grid.
+ *
+ * @param ai::CPathSolver& Solver to use
+ * @param PathJob* The request
+ *
+ * @pre The lock is not held.
+ **/
+void CPathService::SolveJob(ai::CPathSolver& Solver, PathJob* pJob)
+{
+    double start = game::CTimer::GetTime();
+
+    pJob->Result.Bounds = pJob->pGrid->GetBounds();
+    pJob->Result.found  = Solver.Solve(*pJob->pGrid,
+        pJob->start_x, pJob->start_y, pJob->end_x, pJob->end_y,
+        pJob->Result.cells);
+
+    double solve_time = (game::CTimer::GetTime() - start) * 1000.0;
+
+    SDL_mutexP(mp_Lock);
+    this->FinishJob(pJob, solve_time);
+    SDL_mutexV(mp_Lock);
+}
+
+/**
+ * Marks a request as solved and wakes anybody waiting on it.
+ *
+ * @param PathJob* The request
+ * @param double Time spent solving, in milliseconds
+ *
+ * @pre The lock is held.
+ **/
+void CPathService::FinishJob(PathJob* pJob, const double solve_time)
+{
+    this->ReleaseGrid(pJob->pGrid);
+    pJob->pGrid = NULL;
+
+    ++m_solved_count;
+    m_total_time += solve_time;
+    m_max_time = max(m_max_time, solve_time);
+
+    if(pJob->cancelled)
+        delete pJob;
+    else
+        pJob->state = e_FINISHED;
+
+    SDL_CondBroadcast(mp_JobDone);
+}
+
+/**
+ * Drops a reference to a grid snapshot, deleting it if it was the last.
+ *
+ * @param ai::CPathGrid* The snapshot
+ * @pre The lock is held, or no workers are running.
+ **/
+void CPathService::ReleaseGrid(ai::CPathGrid* pGrid)
+{
+    if(--pGrid->m_refs == 0)
+        delete pGrid;
+}
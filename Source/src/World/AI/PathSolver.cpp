@@ -0,0 +1,255 @@
+/**
+ * @file
+ *  Definitions for the CPathSolver class.
+ *
+ * @author George Kudrayvtsev
+ * @version 1.0
+ **/
+
+#include "World/AI/PathSolver.hpp"
+
+using ai::CPathSolver;
+
+CPathSolver::CPathSolver() : m_generation(0) {}
+
+/**
+ * Finds the shortest path between two cells using A*.
+ *  Every walkable cell is a node, and all 8 neighbours of a node are
+ *  one move away. Blocked nodes (touching a wall) aren't expanded.
+ *
+ * @param ai::CPathGrid& Grid to search
+ * @param int Start cell x-coordinate
+ * @param int Start cell y-coordinate
+ * @param int End cell x-coordinate
+ * @param int End cell y-coordinate
+ * @param std::vector<int>& Output path, as grid cell indices from the
+ *  end back to the start. If a complete path is not found, the path to
+ *  the last node searched is stored instead.
+ *
+ * @return TRUE if a path was found, FALSE if not.
+ *
+ * @see http://www.policyalmanac.org/games/aStarTutorial.htm
+ * @todo Remove corner-cutting when path-finding
+ * @todo Make sure the tank can actually fit in the path
+ **/
+bool CPathSolver::Solve(const ai::CPathGrid& Grid,
+    const int start_x, const int start_y,
+    const int end_x, const int end_y,
+    std::vector<int>& path)
+{
+    path.clear();
+
+    if(!Grid.IsWalkable(start_x, start_y))
+        return false;
+
+    this->PrepareNodes(Grid.GetBounds());
+
+    const int w = m_Bounds.w;
+    u_int order = 0;
+
+    // Add start node to open list
+    int current = (start_y - m_Bounds.y) * w + (start_x - m_Bounds.x);
+    m_Nodes[current].parent     = -1;
+    m_Nodes[current].move_count = 0;
+    m_Nodes[current].cost       = 0;
+    m_Nodes[current].order      = order++;
+    m_Nodes[current].generation = m_generation;
+    this->HeapPush(current);
+
+    bool found = false;
+
+    while(!m_OpenHeap.empty())
+    {
+        // Take the node with the lowest cost, this closes it.
+        current = this->HeapPop();
+
+        int cx = current % w + m_Bounds.x;
+        int cy = current / w + m_Bounds.y;
+
+        // Is this the destination?
+        if(cx == end_x && cy == end_y)
+        {
+            found = true;
+            break;
+        }
+
+        // Is it impassable?
+        if(Grid.IsBlocked(cx, cy))
+            continue;
+
+        // Iterate through the adjacent nodes
+        for(int x = -1; x <= 1; x++)
+        {
+            for(int y = -1; y <= 1; y++)
+            {
+                // No tile?
+                if(!Grid.IsWalkable(cx + x, cy + y))
+                    continue;
+
+                int next = current + (y * w) + x;
+                int move_count = m_Nodes[current].move_count + 1;
+                Node& Next = m_Nodes[next];
+
+                // First time we see it this query, open it.
+                if(Next.generation != m_generation)
+                {
+                    Next.generation = m_generation;
+                    Next.parent     = current;
+                    Next.move_count = move_count;
+                    Next.cost       = move_count +
+                        abs(end_x - (cx + x)) + abs(end_y - (cy + y));
+                    Next.order      = order++;
+                    this->HeapPush(next);
+                }
+
+                // Still open and is this way better?
+                else if(Next.heap_index >= 0 && move_count < Next.move_count)
+                {
+                    Next.cost      -= Next.move_count - move_count;
+                    Next.move_count = move_count;
+                    Next.parent     = current;
+                    this->HeapSiftUp(Next.heap_index);
+                }
+            }
+        }
+    }
+
+    // Final path backwards from end to start following parents.
+    for(int node = current; node != -1; node = m_Nodes[node].parent)
+        path.push_back(node);
+
+    return found;
+}
+
+/**
+ * Gets the node array ready for a new query.
+ *  The array is only reallocated when the grid changes shape,
+ *  otherwise bumping the generation stamp resets every node at once.
+ *
+ * @param math::CRect& Grid bounds, in cells
+ **/
+void CPathSolver::PrepareNodes(const math::CRect& Bounds)
+{
+    if(m_Nodes.empty() || !(m_Bounds == Bounds))
+    {
+        m_Bounds = Bounds;
+        m_Nodes.assign(Bounds.w * Bounds.h, Node());
+        m_OpenHeap.reserve(m_Nodes.size());
+        m_generation = 0;
+    }
+
+    // Generation 0 means "never touched", so skip it when wrapping.
+    if(++m_generation == 0)
+    {
+        for(size_t i = 0; i < m_Nodes.size(); ++i)
+            m_Nodes[i].generation = 0;
+
+        m_generation = 1;
+    }
+
+    m_OpenHeap.clear();
+}
+
+/**
+ * Compares two open nodes.
+ *  Ties are broken by the order the nodes were opened in.
+ *
+ * @param int First node
+ * @param int Second node
+ * @return TRUE if the first node should be expanded before the second.
+ **/
+bool CPathSolver::IsBetter(const int a, const int b) const
+{
+    if(m_Nodes[a].cost != m_Nodes[b].cost)
+        return m_Nodes[a].cost < m_Nodes[b].cost;
+
+    return m_Nodes[a].order < m_Nodes[b].order;
+}
+
+/**
+ * Adds a node to the open heap.
+ * @param int Node to open
+ **/
+void CPathSolver::HeapPush(const int node)
+{
+    m_Nodes[node].heap_index = m_OpenHeap.size();
+    m_OpenHeap.push_back(node);
+    this->HeapSiftUp(m_OpenHeap.size() - 1);
+}
+
+/**
+ * Removes the best node from the open heap.
+ *
+ * @return The node, which is now closed.
+ * @pre The heap isn't empty.
+ **/
+int CPathSolver::HeapPop()
+{
+    int top  = m_OpenHeap.front();
+    int last = m_OpenHeap.back();
+    m_OpenHeap.pop_back();
+
+    if(!m_OpenHeap.empty())
+    {
+        m_OpenHeap[0] = last;
+        m_Nodes[last].heap_index = 0;
+        this->HeapSiftDown(0);
+    }
+
+    m_Nodes[top].heap_index = -1;
+    return top;
+}
+
+/**
+ * Moves a node up the heap until its parent is better than it.
+ * @param int Heap position of the node
+ **/
+void CPathSolver::HeapSiftUp(int pos)
+{
+    int node = m_OpenHeap[pos];
+
+    while(pos > 0)
+    {
+        int parent = (pos - 1) / 2;
+        if(!this->IsBetter(node, m_OpenHeap[parent]))
+            break;
+
+        m_OpenHeap[pos] = m_OpenHeap[parent];
+        m_Nodes[m_OpenHeap[pos]].heap_index = pos;
+        pos = parent;
+    }
+
+    m_OpenHeap[pos] = node;
+    m_Nodes[node].heap_index = pos;
+}
+
+/**
+ * Moves a node down the heap until it's better than its children.
+ * @param int Heap position of the node
+ **/
+void CPathSolver::HeapSiftDown(int pos)
+{
+    int size = m_OpenHeap.size();
+    int node = m_OpenHeap[pos];
+
+    while(true)
+    {
+        int child = 2 * pos + 1;
+        if(child >= size)
+            break;
+
+        if(child + 1 < size && this->IsBetter(
+            m_OpenHeap[child + 1], m_OpenHeap[child]))
+            ++child;
+
+        if(!this->IsBetter(m_OpenHeap[child], node))
+            break;
+
+        m_OpenHeap[pos] = m_OpenHeap[child];
+        m_Nodes[m_OpenHeap[pos]].heap_index = pos;
+        pos = child;
+    }
+
+    m_OpenHeap[pos] = node;
+    m_Nodes[node].heap_index = pos;
+}
@@ -3,235 +3,185 @@
  *  Implementation of the CPathfinder class.
  *
  * @author George Kudrayvtsev
- * @version 1.1.2
+ * @version 1.3.0
  **/
 
 #include "World/AI/Pathfinder.hpp"
 
 using ai::CPathfinder;
 
+CPathfinder::~CPathfinder()
+{
+    this->Cancel();
+}
+
 /**
- * Finds the shortest path to a destination using A*.
+ * Finds the shortest path to a destination, waiting for the result.
  *
- * @param obj::CEntity* The tile to start from
- * @param obj::CEntity* The tile to end at
+ * @param obj::CGameObject* The tile to start from
+ * @param obj::CGameObject* The tile to end at
  *
  * @return TRUE if a path was found, FALSE if not.
  *  If a complete path is not found, what's done is still stored.
  *
- * @see http://www.policyalmanac.org/games/aStarTutorial.htm
- * @see game::CTerrainMap
- * @see game::CTerrainMap::FindTile(const math::CVector2&)
- *
- * @todo Remove corner-cutting when path-finding
- * @todo Make sure the tank can actually fit in the path
- * @todo Fix slight issues with not finding the shortest path
+ * @see ai::CPathfinder::RequestPath()
  **/
 bool CPathfinder::FindPath(obj::CGameObject* pStart_Tile,
     obj::CGameObject* pEnd_Tile)
 {
-    // Clear previous path
-    mp_Path.clear();
+    this->RequestPath(pStart_Tile, pEnd_Tile);
+    this->Submit();
+    ai::CPathService::GetInstance().Wait(m_ticket);
+    return (this->Collect() == e_FOUND);
+}
 
-    // Set up lists
-    std::vector<Node*> openList;
-    std::vector<Node*> closedList;
+/**
+ * Requests a path to a destination.
+ *  The current path is left alone until the new one is collected.
+ *  Nothing is sent to ai::CPathService until Submit() is called,
+ *  so this only touches the pathfinder itself and is safe to call
+ *  from a job thread.
+ *
+ * @param obj::CGameObject* The tile to start from
+ * @param obj::CGameObject* The tile to end at
+ *
+ * @see ai::CPathfinder::Submit()
+ * @see ai::CPathfinder::Collect()
+ * @see ai::CPathSolver::Solve()
+ **/
+void CPathfinder::RequestPath(obj::CGameObject* pStart_Tile,
+    obj::CGameObject* pEnd_Tile)
+{
+    const game::CTerrainMap& Terrain = mp_Level->GetTerrainMap();
 
-    // Add start node to open list
-    Node* pStart = new Node;
-    memset(pStart, 0, sizeof Node);
-    pStart->pTile = pStart_Tile;
-    openList.push_back(pStart);
+    Terrain.GetTileCell(pStart_Tile, m_start_x, m_start_y);
+    Terrain.GetTileCell(pEnd_Tile, m_end_x, m_end_y);
+    m_queued = true;
+}
 
-    while(openList.size() > 0)
-    {
-        // Find node with lowest cost in open list
-        int index = 0;
-        int min_cost = openList[index]->cost;
-        for(size_t i = 1; i < openList.size(); ++i)
-        {
-            if(min_cost > openList[i]->cost)
-            {
-                min_cost = openList[i]->cost;
-                index = i;
-            }
-        }
-        Node* pCurrent_Node = openList[index];
+/**
+ * Sends the last requested path off to be solved.
+ *  Any request that's still waiting is cancelled first.
+ *
+ * @pre Called from the main thread.
+ * @see ai::CPathfinder::RequestPath()
+ **/
+void CPathfinder::Submit()
+{
+    if(!m_queued)
+        return;
 
-        // Remove node from open list and add to closed list.
-        for(std::vector<Node*>::iterator i = openList.begin();
-            i != openList.end(); /* no third **/)
-        {
-            if(pCurrent_Node == (*i))
-            {
-                i = openList.erase(i);
-                break;
-            }
-            else
-                ++i;
-        }
-        closedList.push_back(pCurrent_Node);
+    this->Cancel();
 
-        // Is this the destination?
-        if(pCurrent_Node->pTile == pEnd_Tile)
-            break;
+    m_ticket = ai::CPathService::GetInstance().Submit(mp_Level,
+        m_start_x, m_start_y, m_end_x, m_end_y);
+}
 
-        // Iterate through the adjacent nodes
-        for(int x = -1; x <= 1; x++)
-        {
-            for(int y = -1; y <= 1; y++)
-            {
-                // Find tile in current (x, y) position
-                obj::CGameObject* pTile = NULL;
-                pTile = mp_Level->GetTerrainMap().FindTile(
-                    pCurrent_Node->pTile->GetX() + 1 + (32 * x),
-                    pCurrent_Node->pTile->GetY() + 1 + (32 * y));
-
-                // No tile?
-                if(pTile == NULL)
-                {
-                    continue;
-                }
-
-                // Is it impassable?
-                math::CRect Checker(pCurrent_Node->pTile->GetCollisionBox());
-                Checker.Resize(34, 34);
-                Checker.Move(Checker.x - 1, Checker.y - 1);
-                if(mp_Level->GetCollisionMap().FindTile(Checker)
-                    /*pCurrent_Node->pTile->GetX() + (64 * x),
-                    pCurrent_Node->pTile->GetY() + (64 * y))**/ != NULL)
-                {
-                    continue;
-                }
-
-                // Is it impossible to get to without hitting a wall?
-                // Create a rect that's midway between the parent and the 
-                // adjacent node.
-                /// @todo Make cutting corners illegal.
-                /*
-                math::Rect Midpt;
-                Midpt.x = (pCurrent_Node->pTile->GetX() + pTile->GetX()) / 2;
-                Midpt.y = (pCurrent_Node->pTile->GetY() + pTile->GetY()) / 2;
-                Midpt.Resize(31, 31);   // Edge case, rect collision problem
-                if(mp_Level->GetCollisionMap().FindTile(Midpt) != NULL)
-                    continue;
-                    **/
-
-                // Is it in the closed list?
-                bool is_closed = false;
-                for(size_t i = 0; i < closedList.size(); ++i)
-                {
-                    if(pTile == closedList[i]->pTile)
-                    {
-                        is_closed = true;
-                        break;
-                    }
-                }
-                if(is_closed)
-                    continue;
-
-                // Is it in the open list?
-                bool is_open = false;
-                for(size_t i = 0; i < openList.size(); ++i)
-                {
-                    if(pTile == openList[i]->pTile)
-                    {
-                        // Is it better?
-                        if(openList[i]->cost < (abs(pEnd_Tile->GetX() - pTile->GetX()) / 32) + 
-                            (abs(pEnd_Tile->GetY() - pTile->GetY()) / 32) + openList[i]->pParent->move_count + 1)
-                        {
-                            openList[i]->pParent = pCurrent_Node;
-                            openList[i]->move_count = openList[i]->pParent->move_count + 1;
-                            openList[i]->heuristic  = (abs(pEnd_Tile->GetX() - pTile->GetX()) / 32) + 
-                                (abs(pEnd_Tile->GetY() - pTile->GetY()) / 32);
-                            openList[i]->cost = openList[i]->move_count + openList[i]->heuristic;
-                        }
-                        is_open = true;
-                        break;
-                    }
-                }
-
-                // Not in open list?
-                if(!is_open)
-                {
-                    // Create a new node.
-                    Node* pTmp = new Node;
-                    memset(pTmp, 0, sizeof Node);
-
-                    pTmp->pParent   = pCurrent_Node;
-                    pTmp->pTile     = pTile;
-
-                    pTmp->heuristic = (abs(pEnd_Tile->GetX() - pTile->GetX()) / 32) + 
-                            (abs(pEnd_Tile->GetY() - pTile->GetY()) / 32);
-                    pTmp->move_count= pTmp->pParent->move_count + 1;
-                    pTmp->cost      = pTmp->heuristic + pTmp->move_count;
-
-                    openList.push_back(pTmp);
-                }
-            }
-        }
-    }
+/**
+ * Picks up the result of the last request, if it's ready.
+ *  The path is replaced with the result (even a partial one),
+ *  but following it only restarts if a full path was found.
+ *
+ * @return The request status.
+ **/
+CPathfinder::PathStatus CPathfinder::Collect()
+{
+    // A newer request makes the one in flight worthless.
+    if(m_queued)
+        return e_WAITING;
 
-    // Final path backwards from end to start following parents.
-    for(Node* pNode = closedList.back(); pNode != NULL; pNode = pNode->pParent)
-    {
-        mp_Path.push_back(pNode->pTile);
-    }
+    if(m_ticket == 0)
+        return e_NO_REQUEST;
+
+    ai::PathResult Result;
+    if(!ai::CPathService::GetInstance().Collect(m_ticket, Result))
+        return e_WAITING;
+
+    m_ticket = 0;
+    mp_Path.clear();
 
-    // If we didn't find a path
-    if(openList.empty())
+    // Grid cells back to tiles; walls may have moved in the meantime.
+    const game::CTerrainMap& Terrain = mp_Level->GetTerrainMap();
+    for(size_t i = 0; i < Result.cells.size(); ++i)
     {
-        // Clean up lists
-        for(size_t i = 0; i < closedList.size(); ++i)
-            delete closedList[i];
-        return false;
+        obj::CGameObject* pTile = Terrain.GetTileAt(
+            Result.cells[i] % Result.Bounds.w + Result.Bounds.x,
+            Result.cells[i] / Result.Bounds.w + Result.Bounds.y);
+
+        if(pTile != NULL)
+            mp_Path.push_back(pTile);
     }
-    else
+
+    if(!Result.found)
+        return e_NOT_FOUND;
+
+    m_current_node = 0;
+    return e_FOUND;
+}
+
+/// Gives up on the last request, if it's still waiting.
+void CPathfinder::Cancel()
+{
+    m_queued = false;
+
+    if(m_ticket != 0)
     {
-        // Clean up lists
-        for(size_t i = 0; i < closedList.size(); ++i)
-            delete closedList[i];
-        for(size_t i = 0; i < openList.size(); ++i)
-            delete openList[i];
+        ai::CPathService::GetInstance().Cancel(m_ticket);
+        m_ticket = 0;
     }
+}
 
-    m_current_node = 0;
-    return true;
+/**
+ * Checks if a request is still waiting to be collected.
+ * @return TRUE if waiting, FALSE otherwise.
+ **/
+bool CPathfinder::IsWaiting() const
+{
+    return (m_ticket != 0 || m_queued);
 }
 
-void CPathfinder::ShowPath()
+/**
+ * Draws a square over every node on the path.
+ *  The first node is purple, visited nodes are green, the rest are
+ *  red, and the node currently being headed for is blue.
+ *
+ * @param gfx::CSpriteBatch& Batch to draw in, which has to be active
+ **/
+void CPathfinder::ShowPath(gfx::CSpriteBatch& Batch) const
 {
-    SDL_Surface* pRender = gfx::create_surface_alpha(32, 32, gfx::RED);
-    
-    for(int i = mp_Path.size() - 1; i >= 0; --i)
+    enum {e_FIRST, e_VISITED, e_AHEAD, e_CURRENT, e_NODE_COLORS};
+
+    // The square textures are made once and kept for good.
+    static u_int s_textures[e_NODE_COLORS] = {0};
+    if(s_textures[e_FIRST] == 0)
     {
-        if(i == 0)
-            gfx::fill_rect(pRender, NULL, gfx::PURPLE);
-        else if(i < m_current_node)
-            gfx::fill_rect(pRender, NULL, gfx::GREEN);
-        else
-            gfx::fill_rect(pRender, NULL, gfx::RED);
-
-        obj::CEntity* pNew = new obj::CEntity;
-        pNew->LoadFromSurface(pRender);
-        pNew->Move(mp_Path[i]->GetPosition());
-        pNew->Update();
-        /// @todo Remove tile
-        //delete pNew;
+        const gfx::Color Colors[e_NODE_COLORS] =
+            {gfx::PURPLE, gfx::GREEN, gfx::RED, gfx::BLUE};
+
+        for(int i = 0; i < e_NODE_COLORS; ++i)
+        {
+            SDL_Surface* pSquare = gfx::create_surface_alpha(32, 32, Colors[i]);
+            s_textures[i] = gfx::SDL_Surface_to_texture(pSquare);
+            SDL_FreeSurface(pSquare);
+        }
     }
-    
-    gfx::fill_rect(pRender, NULL, gfx::BLUE);
 
-    if(m_current_node < mp_Path.size())
+    const math::CRectf UV(0, 0, 1, 1);
+    for(int i = mp_Path.size() - 1; i >= 0; --i)
     {
-        obj::CEntity* pNew = new obj::CEntity;
-        pNew->LoadFromSurface(pRender);
-        pNew->Move(mp_Path[m_current_node]->GetPosition());
-        pNew->Update();
-        delete pNew;
+        int color = (i == 0) ? e_FIRST :
+            (i < m_current_node) ? e_VISITED : e_AHEAD;
+
+        const math::CVector2& Node = mp_Path[i]->GetPosition();
+        Batch.Draw(s_textures[color], math::CRectf(Node.x, Node.y, 32, 32), UV);
     }
 
-    SDL_FreeSurface(pRender);
+    if(m_current_node < (int)mp_Path.size())
+    {
+        const math::CVector2& Node = mp_Path[m_current_node]->GetPosition();
+        Batch.Draw(s_textures[e_CURRENT],
+            math::CRectf(Node.x, Node.y, 32, 32), UV);
+    }
 }
 
 obj::CGameObject* CPathfinder::NextTile()
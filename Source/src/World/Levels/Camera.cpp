@@ -0,0 +1,148 @@
+/**
+ * @file
+ *  Definitions for the CCamera class.
+ *
+ * @author George Kudrayvtsev
+ * @version 1.0
+ **/
+
+#include "World/Levels/Camera.hpp"
+
+using game::CCamera;
+
+CCamera::CCamera() : m_pan_adjustment_rate(32) {}
+
+/**
+ * Pans the view in the proper direction if the given position
+ * is within 200 (horizontally) or 150 (vertically) pixels of the
+ * screen boundaries.
+ *
+ * @param math::CVector2& Position to keep in view, in world coordinates
+ * @return TRUE if panning was done, FALSE otherwise.
+ **/
+bool CCamera::Pan(const math::CVector2& Focus)
+{
+    math::CVector2 Position = this->ToScreen(Focus);
+    int dx = 0, dy = 0;
+
+    if(Position.x > 800.0f - 200.0f)
+        dx = -m_pan_adjustment_rate;
+    else if(Position.x < 200.0f)
+        dx = m_pan_adjustment_rate;
+    if(Position.y > 600.0f - 150.0f)
+        dy = -m_pan_adjustment_rate;
+    else if(Position.y < 150.0f)
+        dy = m_pan_adjustment_rate;
+
+    m_PanRate.Move(dx, dy);
+    m_Offset = m_Offset + m_PanRate;
+
+    return (dx != 0 || dy != 0);
+}
+
+/**
+ * Starts rendering through the camera.
+ *  Anything rendered until the matching Disable() call is treated
+ *  as being in world coordinates.
+ *
+ * @param float How far along the next tick is, [0, 1] (optional)
+ * @see CCamera::GetRenderOffset()
+ **/
+void CCamera::Enable(const float alpha) const
+{
+    if(gfx::is_headless())
+        return;
+
+    math::CVector2 Offset = this->GetRenderOffset(alpha);
+
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glTranslatef(Offset.x, Offset.y, 0.0f);
+}
+
+/**
+ * Stops rendering through the camera, going back to screen coordinates.
+ * @pre Enable() has been called.
+ **/
+void CCamera::Disable() const
+{
+    if(gfx::is_headless())
+        return;
+
+    glMatrixMode(GL_MODELVIEW);
+    glPopMatrix();
+}
+
+/**
+ * Sets the rate at which to pan the view.
+ * @param int Rate
+ **/
+void CCamera::SetPanRate(const int rate)
+{
+    m_pan_adjustment_rate = rate;
+}
+
+/**
+ * Converts a screen position (such as the mouse) to world coordinates.
+ *
+ * @param math::CVector2& Screen position
+ * @return The position in the world.
+ **/
+math::CVector2 CCamera::ToWorld(const math::CVector2& Screen) const
+{
+    return Screen - m_Offset;
+}
+
+/**
+ * Converts a world position to screen coordinates.
+ *
+ * @param math::CVector2& World position
+ * @return The position on-screen.
+ **/
+math::CVector2 CCamera::ToScreen(const math::CVector2& World) const
+{
+    return World + m_Offset;
+}
+
+/**
+ * Retrieves the part of the world that's on-screen.
+ * @return The view rectangle, in world coordinates.
+ **/
+math::CRect CCamera::GetView() const
+{
+    return math::CRect(-m_Offset.x, -m_Offset.y, 800, 600);
+}
+
+/**
+ * Retrieves the current view offset.
+ * @return Offset from world coordinates to screen coordinates.
+ **/
+const math::CVector2& CCamera::GetOffset() const
+{
+    return m_Offset;
+}
+
+/**
+ * Retrieves the offset to draw with between two ticks.
+ *  The view is placed part way through the last pan, the same way
+ *  entities are placed part way through their last move.
+ *
+ * @param float How far along the next tick is, [0, 1]
+ * @return Offset from world coordinates to screen coordinates.
+ * @see obj::CEntity::Render()
+ **/
+math::CVector2 CCamera::GetRenderOffset(const float alpha) const
+{
+    return m_Offset - m_PanRate * (1.0f - alpha);
+}
+
+/**
+ * Retrieves the latest panning rate.
+ *
+ * @see CCamera::Pan()
+ * @return A vector representing the pan rate.
+ **/
+const math::CVector2& CCamera::GetPanRate() const
+{
+    return m_PanRate;
+}
@@ -10,6 +10,7 @@
 #include <fstream>
 
 #include "World/Levels/CollisionMap.hpp"
+#include "World/Levels/LevelFile.hpp"
 
 using game::CCollisionMap;
 using asset::CAssetManager;
@@ -23,6 +24,7 @@ using asset::CAssetManager;
 CCollisionMap::CCollisionMap(bool edit) : CMap(edit)
 {
     mp_Overlay = gfx::create_surface_alpha(32, 32, gfx::YELLOW);
+    m_OverlayTexture.LoadFromSurface(mp_Overlay);
 
     if(edit)
     {
@@ -71,9 +73,7 @@ bool CCollisionMap::Load(const char* pfilename)
         return false;
     }
 
-    for(size_t i = 0; i < mp_allTiles.size(); ++i)
-        delete mp_allTiles[i];
-    mp_allTiles.clear();
+    this->ClearTiles();
 
     while(std::getline(map, line))
     {
@@ -106,18 +106,58 @@ bool CCollisionMap::Load(const char* pfilename)
 
         // Move tile to parsed coordinates.
         pTile->Move(x, y);
-        pTile->Update();
+        pTile->Tick();
 
         // Add to all ptiles.
         mp_allTiles.push_back(pTile);
     }
 
+    // Index everything in one go.
+    this->RebuildIndex();
+
     tileData.clear();
     map.close();
 
     return true;
 }
 
+/**
+ * Loads the walls from a compiled level.
+ *  Every tile shares one texture, and they're all created in a
+ *  single block.
+ *
+ * @param game::CLevelFile& Compiled level
+ * @return TRUE.
+ **/
+bool CCollisionMap::Load(const game::CLevelFile& Level)
+{
+    const game::CLevelFile::Header& Info = Level.GetHeader();
+
+    this->ClearTiles();
+
+    obj::CGameObject* pTiles = this->CreateTiles(Info.collision_count);
+    u_int count = 0;
+
+    for(u_int y = 0; y < Info.h; ++y)
+    {
+        for(u_int x = 0; x < Info.w && count < Info.collision_count; ++x)
+        {
+            if(!Level.IsWall(x, y))
+                continue;
+
+            obj::CGameObject* pTile = &pTiles[count++];
+            pTile->LoadFromTexture(&m_OverlayTexture);
+            pTile->Move((Info.x + (int)x) * TILE_SIZE,
+                (Info.y + (int)y) * TILE_SIZE);
+            pTile->Tick();
+            mp_allTiles.push_back(pTile);
+        }
+    }
+
+    this->RebuildIndex();
+    return true;
+}
+
 /**
  * Saves a map file.
  * 
@@ -136,23 +176,9 @@ bool CCollisionMap::Save(const char* pfilename)
     std::stringstream line;
     std::ofstream map_file(pfilename);
 
-    // First, adjust all map tiles so the first one is at (0, 0)
-    // Basically, undo any panning operations.
-    float min_x = mp_allTiles[0]->GetX();
-    float min_y = mp_allTiles[0]->GetY();
-    for(size_t i = 0; i < mp_allTiles.size(); ++i)
-    {
-        min_x = min(mp_allTiles[i]->GetX(), min_x);
-    }
-    for(size_t i = 0; i < mp_allTiles.size(); ++i)
-    {
-        min_y = min(mp_allTiles[i]->GetY(), min_y);
-    }
-
+    // Tiles are stored in world coordinates, so they can be written as-is.
     for(size_t i = 0; i < mp_allTiles.size(); ++i)
     {
-        mp_allTiles[i]->Move_Rate(-min_x, -min_y);
-
         line << (int)mp_allTiles[i]->GetX() << ",";
         line << (int)mp_allTiles[i]->GetY() << std::endl;
 
@@ -185,44 +211,41 @@ void CCollisionMap::PlaceTile(int x, int y)
         pTile = this->FindTile(x, y);
         if(pTile == NULL)
         {
+            pTile = new obj::CGameObject;
             pTile->LoadFromSurface(mp_Overlay);
             pTile->Move(x, y);
-            mp_allTiles.push_back(pTile);
+            pTile->Tick();
+            this->AddTile(pTile);
         }
         else
         {
-            for(std::vector<obj::CGameObject*>::iterator i = mp_allTiles.begin();
-                i != mp_allTiles.end(); /* no third **/)
-            {
-                if((*i) == pTile)
-                    i = mp_allTiles.erase(i);
-                else
-                    ++i;
-            }
+            this->RemoveTile(pTile);
         }
     }
     else
     {
-        for(std::vector<obj::CGameObject*>::iterator i = mp_allTiles.begin();
-            i != mp_allTiles.end(); /* no third **/)
-        {
-            if((*i) == pTile)
-                i = mp_allTiles.erase(i);
-            else
-                ++i;
-        }
+        this->RemoveTile(pTile);
     }
 }
 
 /**
- * Updates all the tiles on-screen if edit mode is enabled.
+ * Draws all the tiles, and the placeable tile if edit mode is enabled.
+ *  Tiles are only drawn when they're displayed as tiles, but the
+ *  placeable tile is shown in any display mode.
+ *
  * @param bool Should we show the main placeable tile?
  **/
-void CCollisionMap::Update(bool show_active)
+void CCollisionMap::Render(bool show_active)
 {
-    for(size_t i = 0; i < mp_allTiles.size(); ++i)
-        if(mp_allTiles[i] != NULL)
-            mp_allTiles[i]->Update();
+    if(m_display == e_DISPLAY_TILES)
+    {
+        // Tiles never overlap, so they can be drawn in any order.
+        m_Batch.Begin(gfx::CSpriteBatch::e_SORT_TEXTURE);
+        for(size_t i = 0; i < mp_allTiles.size(); ++i)
+            if(mp_allTiles[i] != NULL)
+                mp_allTiles[i]->Render(m_Batch);
+        m_Batch.End();
+    }
 
     if(m_can_edit)
     {
@@ -1,24 +1,64 @@
 #include "World/Levels/Level.hpp"
+#include "World/Levels/LevelFile.hpp"
 
 using game::CLevel;
 
-CLevel::CLevel() 
+CLevel::CLevel() :
 #ifdef _DEBUG
-    : m_TerrainMap(true), m_CollisionMap(true),
-        m_ObjectiveMap(true)
+    m_TerrainMap(true), m_CollisionMap(true), m_ObjectiveMap(true),
 #endif // _DEBUG
-    {}
+    m_source_key(0)
+{
+    // Walls and objectives are only there for their data, debug
+    // builds show them as outlines.
+    m_CollisionMap.SetDisplayMode(game::CMap::e_DISPLAY_HIDDEN);
+    m_ObjectiveMap.SetDisplayMode(game::CMap::e_DISPLAY_HIDDEN);
+
+#ifdef _DEBUG
+    this->ToggleOverlay();
+#endif // _DEBUG
+}
 
-bool CLevel::LoadLevel(const int level_no)
+/**
+ * @overload CLevel::LoadLevel(const std::string&, const bool)
+ * @param int Level number, the level is Data/Levels/LevelN
+ **/
+bool CLevel::LoadLevel(const int level_no, const bool compiled)
+{
+    std::stringstream name;
+    name << "Data/Levels/Level" << level_no;
+    return this->LoadLevel(name.str(), compiled);
+}
+
+/**
+ * Loads the maps of a level.
+ *  Release builds use the compiled level if it was compiled from
+ *  the current text maps, and fall back to the text maps otherwise.
+ *  Debug builds always load the text maps, since that's what gets
+ *  edited. Either way, a missing or stale compiled level is
+ *  compiled again from the text maps.
+ *
+ * @param std::string& Level filename, without an extension
+ * @param bool Use the compiled level if there is one (optional)
+ * @return TRUE if loaded, FALSE if one of the maps failed to load.
+ **/
+bool CLevel::LoadLevel(const std::string& name, const bool compiled)
 {
     std::stringstream filename;
-    filename << "Data/Levels/Level" << level_no;
-    m_levelname = filename.str();
+    filename << name;
+    m_levelname = name;
 
     g_Log.Flush();
     g_Log << "[INFO] Loading level " << m_levelname << "*\n";
     g_Log.ShowLastLog();
 
+    m_source_key = game::CLevelFile::HashSources(m_levelname);
+
+#ifndef _DEBUG
+    if(compiled && this->LoadCompiled())
+        return true;
+#endif // _DEBUG
+
     filename << game::TERRAIN_MAP_EXT;
     if(!m_TerrainMap.Load(filename.str().c_str()))
         return false;
@@ -33,9 +73,72 @@ bool CLevel::LoadLevel(const int level_no)
     if(!m_ObjectiveMap.Load(filename.str().c_str()))
         return false;
 
+    if(compiled && !this->IsCompiled())
+        this->Compile();
+
     return true;
 }
 
+/**
+ * Writes the loaded maps out as a compiled level, next to the
+ * text maps.
+ *
+ * @return TRUE if written, FALSE otherwise.
+ * @see game::CLevelFile::Write()
+ **/
+bool CLevel::Compile() const
+{
+    std::string filename = m_levelname + game::LEVEL_FILE_EXT;
+    return game::CLevelFile::Write(filename.c_str(),
+        m_TerrainMap, m_CollisionMap, m_ObjectiveMap, m_source_key);
+}
+
+/**
+ * Loads every map from the compiled level.
+ *  The file is mapped into memory and read in place, so the only
+ *  work done is creating the tiles.
+ *
+ * @return TRUE if loaded, FALSE if there's no valid compiled level
+ *  or it's out of date.
+ **/
+bool CLevel::LoadCompiled()
+{
+    std::string filename = m_levelname + game::LEVEL_FILE_EXT;
+    game::CLevelFile Level;
+
+    if(!Level.Open(filename.c_str()))
+        return false;
+
+    if(Level.GetHeader().source_key != m_source_key)
+    {
+        g_Log.Flush();
+        g_Log << "[INFO] Ignoring out of date compiled level: ";
+        g_Log << filename << ".\n";
+        return false;
+    }
+
+    return (m_TerrainMap.Load(Level) && m_CollisionMap.Load(Level) &&
+            m_ObjectiveMap.Load(Level));
+}
+
+/**
+ * Checks for a compiled level made from the current text maps.
+ * @return TRUE if there's one, FALSE if it's missing or stale.
+ **/
+bool CLevel::IsCompiled() const
+{
+    std::string filename = m_levelname + game::LEVEL_FILE_EXT;
+    game::CLevelFile Level;
+
+    return (Level.Open(filename.c_str()) &&
+            Level.GetHeader().source_key == m_source_key);
+}
+
+const game::CCamera& CLevel::GetCamera() const
+{
+    return m_Camera;
+}
+
 game::CTerrainMap& CLevel::GetTerrainMap()
 {
     return m_TerrainMap;
@@ -56,29 +159,73 @@ const std::string& CLevel::GetLevelName() const
     return m_levelname;
 }
 
+/**
+ * Retrieves the hash of the level's text maps.
+ * @see game::CLevelFile::HashSources()
+ **/
+unsigned long long CLevel::GetSourceKey() const
+{
+    return m_source_key;
+}
+
 void CLevel::SetPanRate(const float rate)
 {
-    m_TerrainMap.SetPanRate(rate);
-    m_CollisionMap.SetPanRate(rate);
-    m_ObjectiveMap.SetPanRate(rate);
+    m_Camera.SetPanRate(rate);
 }
 
-void CLevel::Update()
+/**
+ * Draws every visible map layer.
+ * @pre The level camera is enabled.
+ **/
+void CLevel::Render()
 {
-    m_TerrainMap.Update(false);
-#ifdef _DEBUG
-    glColor4f(1, 1, 1, 0.3f);
-#else
-    glColor4f(1, 1, 1, 0);
-#endif // _DEBUG
-    m_CollisionMap.Update(false);
-    m_ObjectiveMap.Update(false);
-    glColor4f(1, 1, 1, 1);
+    m_TerrainMap.SetView(m_Camera.GetView());
+    m_TerrainMap.Render(false);
+    m_CollisionMap.Render(false);
+    m_ObjectiveMap.Render(false);
+}
+
+/**
+ * Outlines the tiles of every layer shown as an overlay.
+ *  All of the outlines are drawn with a single call.
+ *
+ * @pre The level camera is enabled.
+ **/
+void CLevel::RenderOverlay()
+{
+    const math::CRect View = m_Camera.GetView();
+
+    m_Overlay.Begin();
+    m_CollisionMap.DrawOverlay(m_Overlay, gfx::RED, View);
+    m_ObjectiveMap.DrawOverlay(m_Overlay, gfx::GREEN, View);
+    m_Overlay.End();
+}
+
+/**
+ * Shows or hides the outlines of the collision and objective maps.
+ * @return TRUE if they're now shown, FALSE otherwise.
+ **/
+bool CLevel::ToggleOverlay()
+{
+    const bool show = (m_CollisionMap.GetDisplayMode() !=
+        game::CMap::e_DISPLAY_OVERLAY);
+    const game::CMap::DisplayMode mode = show ?
+        game::CMap::e_DISPLAY_OVERLAY : game::CMap::e_DISPLAY_HIDDEN;
+
+    m_CollisionMap.SetDisplayMode(mode);
+    m_ObjectiveMap.SetDisplayMode(mode);
+    return show;
 }
 
-bool CLevel::PanMaps(const math::CVector2& Pos)
+/**
+ * Pans the level camera to keep a position in view.
+ *  Tiles stay where they are, only the camera offset changes.
+ *
+ * @param math::CVector2& Position to follow, in world coordinates
+ * @return TRUE if the view was panned, FALSE otherwise.
+ * @see game::CCamera::Pan()
+ **/
+bool CLevel::Pan(const math::CVector2& Pos)
 {
-    return( m_TerrainMap.Pan(Pos)   && 
-            m_CollisionMap.Pan(Pos) &&
-            m_ObjectiveMap.Pan(Pos));
+    return m_Camera.Pan(Pos);
 }
@@ -0,0 +1,489 @@
+/**
+ * @file
+ *  Definitions for the CLevelFile class.
+ *
+ * @author George Kudrayvtsev
+ * @version 1.0
+ **/
+
+#include <map>
+#include <fstream>
+#include <iterator>
+
+#include "World/Levels/LevelFile.hpp"
+
+#ifdef _WIN32
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <unistd.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+#endif // _WIN32
+
+using game::CLevelFile;
+using game::g_Log;
+
+/// Identifies a compiled level.
+static const char LEVEL_FILE_MAGIC[4] = {'C', 'L', 'V', 'L'};
+
+/**
+ * Rounds an offset up so the section there is aligned.
+ *
+ * @param size_t Offset, in bytes
+ * @return The offset, rounded up to a multiple of 4.
+ **/
+static size_t align_section(const size_t offset)
+{
+    return (offset + 3) & ~(size_t)3;
+}
+
+/**
+ * Checks that a section lies inside of the file.
+ *
+ * @param size_t Section offset
+ * @param size_t Section length
+ * @param size_t File size
+ *
+ * @return TRUE if it fits, FALSE otherwise.
+ **/
+static bool section_fits(const size_t offset, const size_t length,
+    const size_t size)
+{
+    return (offset % 4 == 0 && offset <= size && length <= size - offset);
+}
+
+CLevelFile::CLevelFile() : mp_Data(NULL), m_size(0) {}
+
+CLevelFile::~CLevelFile()
+{
+    this->Close();
+}
+
+/**
+ * Maps a compiled level into memory.
+ *  Nothing is read up front besides checking that the sections
+ *  all fit in the file, pages are read in as the maps use them.
+ *
+ * @param char* Filename
+ * @return TRUE if the level can be used, FALSE if it's missing,
+ *  from another version, or broken.
+ **/
+bool CLevelFile::Open(const char* pfilename)
+{
+    this->Close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(pfilename, GENERIC_READ, FILE_SHARE_READ,
+        NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if(file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER size;
+    if(!GetFileSizeEx(file, &size) || size.QuadPart < sizeof(Header))
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    // The view keeps the file open, the handles aren't needed after.
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY,
+        0, 0, NULL);
+    CloseHandle(file);
+    if(mapping == NULL)
+        return false;
+
+    mp_Data = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if(mp_Data == NULL)
+        return false;
+
+    m_size = (size_t)size.QuadPart;
+#else
+    int file = open(pfilename, O_RDONLY);
+    if(file < 0)
+        return false;
+
+    struct stat info;
+    if(fstat(file, &info) != 0 || (size_t)info.st_size < sizeof(Header))
+    {
+        close(file);
+        return false;
+    }
+
+    void* pmapping = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE,
+        file, 0);
+    close(file);
+    if(pmapping == MAP_FAILED)
+        return false;
+
+    mp_Data = (const char*)pmapping;
+    m_size  = info.st_size;
+#endif // _WIN32
+
+    if(!this->Validate())
+    {
+        g_Log.Flush();
+        g_Log << "[INFO] Ignoring invalid compiled level: ";
+        g_Log << pfilename << ".\n";
+
+        this->Close();
+        return false;
+    }
+
+    return true;
+}
+
+/// Unmaps the level, any pointers into it can't be used after this.
+void CLevelFile::Close()
+{
+    if(mp_Data == NULL)
+        return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(mp_Data);
+#else
+    munmap((void*)mp_Data, m_size);
+#endif // _WIN32
+
+    mp_Data = NULL;
+    m_size  = 0;
+}
+
+/**
+ * Compiles loaded maps into a level file.
+ *  Every layer is put on a single grid covering all of them.
+ *  Tiles are stored by cell, so two terrain tiles in the same
+ *  cell become one.
+ *
+ * @param char* Filename
+ * @param game::CTerrainMap& Terrain map
+ * @param game::CCollisionMap& Collision map
+ * @param game::CObjectiveMap& Objective map
+ * @param unsigned long long Hash of the text maps they came from
+ *
+ * @return TRUE if the level was written, FALSE otherwise.
+ * @see HashSources()
+ **/
+bool CLevelFile::Write(const char* pfilename,
+    const game::CTerrainMap& Terrain,
+    const game::CCollisionMap& Collision,
+    const game::CObjectiveMap& Objectives,
+    const unsigned long long source_key)
+{
+    const game::CMap* pLayers[3] = {&Terrain, &Collision, &Objectives};
+    int left = 0, top = 0, right = 0, bottom = 0;
+    bool empty = true;
+
+    for(int i = 0; i < 3; ++i)
+    {
+        const math::CRect& Cells = pLayers[i]->GetIndexBounds();
+        if(Cells.w == 0 || Cells.h == 0)
+            continue;
+
+        if(empty)
+        {
+            left   = Cells.x;
+            top    = Cells.y;
+            right  = Cells.x + Cells.w;
+            bottom = Cells.y + Cells.h;
+            empty = false;
+            continue;
+        }
+
+        left   = min(left,   Cells.x);
+        top    = min(top,    Cells.y);
+        right  = max(right,  Cells.x + (int)Cells.w);
+        bottom = max(bottom, Cells.y + (int)Cells.h);
+    }
+
+    Header Info;
+    memset(&Info, 0, sizeof Info);
+    memcpy(Info.magic, LEVEL_FILE_MAGIC, sizeof Info.magic);
+    Info.version = LEVEL_FILE_VERSION;
+    Info.source_key = source_key;
+    Info.x = left;
+    Info.y = top;
+    Info.w = right - left;
+    Info.h = bottom - top;
+
+    const size_t cells = (size_t)Info.w * Info.h;
+    std::vector<unsigned short> terrain(cells, 0);
+    std::vector<unsigned char>  collision((cells + 7) / 8, 0);
+    std::vector<Objective>      objectives;
+    std::vector<std::string>    names;
+    std::map<std::string, unsigned short> ids;
+    int cx, cy;
+
+    const std::vector<obj::CGameObject*>& Tiles = Terrain.GetTiles();
+    for(size_t i = 0; i < Tiles.size(); ++i)
+    {
+        if(Tiles[i] == NULL)
+            continue;
+
+        const std::string& name = Tiles[i]->GetFilename();
+        std::map<std::string, unsigned short>::iterator id = ids.find(name);
+        if(id == ids.end())
+        {
+            names.push_back(name);
+            id = ids.insert(std::make_pair(name,
+                (unsigned short)names.size())).first;
+        }
+
+        Terrain.GetTileCell(Tiles[i], cx, cy);
+        unsigned short& cell = terrain[(cy - top) * Info.w + (cx - left)];
+        if(cell == 0)
+            ++Info.terrain_count;
+
+        cell = id->second;
+    }
+
+    const std::vector<obj::CGameObject*>& Walls = Collision.GetTiles();
+    for(size_t i = 0; i < Walls.size(); ++i)
+    {
+        if(Walls[i] == NULL)
+            continue;
+
+        Collision.GetTileCell(Walls[i], cx, cy);
+        const size_t bit = (cy - top) * Info.w + (cx - left);
+        if(collision[bit / 8] & (1 << (bit % 8)))
+            continue;
+
+        collision[bit / 8] |= (1 << (bit % 8));
+        ++Info.collision_count;
+    }
+
+    const std::vector<obj::CGameObject*>& Points = Objectives.GetTiles();
+    for(size_t i = 0; i < Points.size(); ++i)
+    {
+        if(Points[i] == NULL)
+            continue;
+
+        Objective Record;
+        Objectives.GetTileCell(Points[i], Record.cx, Record.cy);
+        Record.type = Objectives.GetAttribute(i);
+        objectives.push_back(Record);
+    }
+
+    // Lay out the sections, each aligned to 4 bytes.
+    std::vector<u_int> name_offsets;
+    std::string all_names;
+    for(size_t i = 0; i < names.size(); ++i)
+    {
+        name_offsets.push_back(all_names.size());
+        all_names.append(names[i].c_str(), names[i].size() + 1);
+    }
+
+    Info.texture_count   = names.size();
+    Info.strings_size    = all_names.size();
+    Info.objective_count = objectives.size();
+
+    Info.strings    = align_section(sizeof(Header));
+    Info.terrain    = align_section(Info.strings +
+        name_offsets.size() * sizeof(u_int) + all_names.size());
+    Info.collision  = align_section(Info.terrain +
+        terrain.size() * sizeof(unsigned short));
+    Info.objectives = align_section(Info.collision + collision.size());
+    Info.size       = Info.objectives + objectives.size() * sizeof(Objective);
+
+    std::vector<char> data(Info.size, 0);
+    memcpy(&data[0], &Info, sizeof Info);
+
+    if(!name_offsets.empty())
+    {
+        memcpy(&data[Info.strings], &name_offsets[0],
+            name_offsets.size() * sizeof(u_int));
+        memcpy(&data[Info.strings + name_offsets.size() * sizeof(u_int)],
+            all_names.data(), all_names.size());
+    }
+
+    if(cells > 0)
+    {
+        memcpy(&data[Info.terrain], &terrain[0],
+            terrain.size() * sizeof(unsigned short));
+        memcpy(&data[Info.collision], &collision[0], collision.size());
+    }
+
+    if(!objectives.empty())
+    {
+        memcpy(&data[Info.objectives], &objectives[0],
+            objectives.size() * sizeof(Objective));
+    }
+
+    std::ofstream file(pfilename,
+        std::ios::out | std::ios::binary | std::ios::trunc);
+    file.write(&data[0], data.size());
+
+    if(!file.good())
+    {
+        g_Log.Flush();
+        g_Log << "[ERROR] Failed to write compiled level: ";
+        g_Log << pfilename << ".\n";
+        return false;
+    }
+
+    g_Log.Flush();
+    g_Log << "[INFO] Compiled " << pfilename << ": " << Info.w << "x";
+    g_Log << Info.h << " cells, " << Info.terrain_count << " terrain, ";
+    g_Log << Info.collision_count << " collision, " << Info.objective_count;
+    g_Log << " objective tile(s).\n";
+
+    return true;
+}
+
+/**
+ * Hashes the text maps of a level.
+ *  A compiled level is only current if it was written with the
+ *  same hash, so any edit to the text maps makes it stale.
+ *
+ * @param std::string& Level filename, without an extension
+ * @return A hash of the terrain, collision, and objective maps.
+ *  Missing maps are hashed as empty.
+ **/
+unsigned long long CLevelFile::HashSources(const std::string& name)
+{
+    const char* pexts[3] = {game::TERRAIN_MAP_EXT, game::COLLISION_MAP_EXT,
+        game::OBJ_MAP_EXT};
+    unsigned long long key = gk::HASH_SEED;
+
+    for(int i = 0; i < 3; ++i)
+    {
+        std::ifstream file((name + pexts[i]).c_str(),
+            std::ios::in | std::ios::binary);
+        std::string data((std::istreambuf_iterator<char>(file)),
+            std::istreambuf_iterator<char>());
+
+        // The length goes in too, so bytes can't move between maps.
+        const size_t size = data.size();
+        key = gk::hash(&size, sizeof size, key);
+        if(size > 0)
+            key = gk::hash(data.data(), size, key);
+    }
+
+    return key;
+}
+
+/**
+ * Retrieves the level header.
+ * @pre Open() succeeded.
+ **/
+const CLevelFile::Header& CLevelFile::GetHeader() const
+{
+    return *reinterpret_cast<const Header*>(mp_Data);
+}
+
+/**
+ * Retrieves a terrain texture name from the string table.
+ *
+ * @param u_int Texture index (terrain grid value - 1)
+ * @return The name, NULL if the index is out of range.
+ **/
+const char* CLevelFile::GetTextureName(const u_int index) const
+{
+    const Header& Info = this->GetHeader();
+    if(index >= Info.texture_count)
+        return NULL;
+
+    const u_int* poffsets = reinterpret_cast<const u_int*>(
+        mp_Data + Info.strings);
+    const char* pnames = reinterpret_cast<const char*>(
+        poffsets + Info.texture_count);
+
+    return pnames + poffsets[index];
+}
+
+/**
+ * Retrieves the terrain grid.
+ * @return w * h texture indices + 1, row by row. 0 means no tile.
+ **/
+const unsigned short* CLevelFile::GetTerrain() const
+{
+    return reinterpret_cast<const unsigned short*>(
+        mp_Data + this->GetHeader().terrain);
+}
+
+/**
+ * Retrieves the collision grid.
+ * @return w * h bits, row by row, lowest bit first.
+ * @see IsWall()
+ **/
+const unsigned char* CLevelFile::GetCollision() const
+{
+    return reinterpret_cast<const unsigned char*>(
+        mp_Data + this->GetHeader().collision);
+}
+
+const CLevelFile::Objective* CLevelFile::GetObjectives() const
+{
+    return reinterpret_cast<const Objective*>(
+        mp_Data + this->GetHeader().objectives);
+}
+
+/**
+ * Checks the collision grid for a wall.
+ *
+ * @param u_int Column, from the first cell of the grid
+ * @param u_int Row, from the first cell of the grid
+ *
+ * @return TRUE if there's a wall there, FALSE otherwise.
+ **/
+bool CLevelFile::IsWall(const u_int x, const u_int y) const
+{
+    const size_t bit = (size_t)y * this->GetHeader().w + x;
+    return (this->GetCollision()[bit / 8] & (1 << (bit % 8))) != 0;
+}
+
+/**
+ * Checks that the header matches the file.
+ *  Every section has to be inside of the file and every texture
+ *  name has to end in it, since they're used straight from it.
+ *
+ * @return TRUE if the file is safe to use, FALSE otherwise.
+ **/
+bool CLevelFile::Validate() const
+{
+    const Header& Info = this->GetHeader();
+
+    if(memcmp(Info.magic, LEVEL_FILE_MAGIC, sizeof Info.magic) != 0 ||
+       Info.version != LEVEL_FILE_VERSION || Info.size != m_size)
+    {
+        return false;
+    }
+
+    const size_t cells = (size_t)Info.w * Info.h;
+    if((Info.w > 0 && cells / Info.w != Info.h) ||
+       Info.texture_count > m_size / sizeof(u_int) ||
+       Info.objective_count > m_size / sizeof(Objective))
+    {
+        return false;
+    }
+
+    if(!section_fits(Info.strings, Info.texture_count * sizeof(u_int) +
+            Info.strings_size, m_size) ||
+       !section_fits(Info.terrain, cells * sizeof(unsigned short), m_size) ||
+       !section_fits(Info.collision, (cells + 7) / 8, m_size) ||
+       !section_fits(Info.objectives,
+            Info.objective_count * sizeof(Objective), m_size))
+    {
+        return false;
+    }
+
+    if(Info.texture_count == 0)
+        return true;
+
+    const u_int* poffsets = reinterpret_cast<const u_int*>(
+        mp_Data + Info.strings);
+    const char* pnames = reinterpret_cast<const char*>(
+        poffsets + Info.texture_count);
+
+    if(Info.strings_size == 0 || pnames[Info.strings_size - 1] != '\0')
+        return false;
+
+    for(u_int i = 0; i < Info.texture_count; ++i)
+    {
+        if(poffsets[i] >= Info.strings_size)
+            return false;
+    }
+
+    return true;
+}
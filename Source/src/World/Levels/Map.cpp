@@ -3,18 +3,20 @@
  *  Definitions for the CMap class.
  *
  * @author George Kudrayvtsev
- * @version 1.2.1
+ * @version 1.3.0
  **/
 
 #include <sstream>
 #include <fstream>
+#include <cmath>
 
 #include "World/Levels/Map.hpp"
 
 using game::CMap;
 
 CMap::CMap(bool edit_mode /*= false**/) : 
-    m_can_edit(edit_mode), m_pan_adjustment_rate(32), mp_CurrentTile(NULL)
+    mp_CurrentTile(NULL), m_display(e_DISPLAY_TILES),
+    m_can_edit(edit_mode), m_revision(0)
 {
     mp_allTiles.clear();
 }
@@ -24,10 +26,7 @@ CMap::CMap(bool edit_mode /*= false**/) :
  **/
 CMap::~CMap()
 {
-    for(size_t i = 0; i < mp_allTiles.size(); ++i)
-        delete mp_allTiles[i];
-
-    mp_allTiles.clear();
+    this->ClearTiles();
 }
 
 /**
@@ -43,15 +42,34 @@ obj::CGameObject* CMap::FindTile(const int x, const int y) const
 
 /**
  * Finds a tile in the list of tiles that's located in the given position.
+ *  Only the grid cell containing the point and its direct neighbours
+ *  are checked, since tile edges are inclusive.
  *
  * @param math::CVector2& Position to find tile in.
  * @return Tile that collides with area given, NULL otherwise.
  **/
 obj::CGameObject* CMap::FindTile(const math::CVector2& Pos) const
 {
-    for(size_t i = 0; i < mp_allTiles.size(); ++i)
-        if(mp_allTiles[i]->CheckCollision(Pos.x, Pos.y))
-            return mp_allTiles[i];
+    int cx, cy;
+    this->GetPointCell(Pos.x, Pos.y, cx, cy);
+
+    // The cell actually containing the point takes priority.
+    obj::CGameObject* pTile = this->FindInCell(cx, cy, Pos.x, Pos.y);
+    if(pTile != NULL)
+        return pTile;
+
+    for(int y = cy - 1; y <= cy + 1; ++y)
+    {
+        for(int x = cx - 1; x <= cx + 1; ++x)
+        {
+            if(x == cx && y == cy)
+                continue;
+
+            pTile = this->FindInCell(x, y, Pos.x, Pos.y);
+            if(pTile != NULL)
+                return pTile;
+        }
+    }
 
     return NULL;
 }
@@ -62,9 +80,24 @@ obj::CGameObject* CMap::FindTile(const math::CVector2& Pos) const
  **/
 obj::CGameObject* CMap::FindTile(const math::CRect& Area) const
 {
-    for(size_t i = 0; i < mp_allTiles.size(); ++i)
-        if(mp_allTiles[i]->CheckCollision(Area))
-            return mp_allTiles[i];
+    int left, top, right, bottom;
+    this->GetPointCell(Area.x, Area.y, left, top);
+    this->GetPointCell(Area.x + Area.w, Area.y + Area.h, right, bottom);
+
+    // Pad by a cell for inclusive edges.
+    for(int y = top - 1; y <= bottom + 1; ++y)
+    {
+        for(int x = left - 1; x <= right + 1; ++x)
+        {
+            const TileCell* pCell = this->GetCell(x, y);
+            if(pCell == NULL)
+                continue;
+
+            for(size_t i = 0; i < pCell->size(); ++i)
+                if((*pCell)[i]->CheckCollision(Area))
+                    return (*pCell)[i];
+        }
+    }
 
     return NULL;
 }
@@ -77,17 +110,7 @@ obj::CGameObject* CMap::FindTile(const math::CRect& Area) const
  **/
 void CMap::RemoveTile(int x, int y)
 {
-    /// @todo This shouldn't even work.
-    obj::CGameObject* pTile = this->FindTile(x, y);
-
-    for(std::vector<obj::CGameObject*>::iterator i = mp_allTiles.begin();
-        i != mp_allTiles.end(); /* no third **/)
-    {
-        if((*i) == pTile)
-            i = mp_allTiles.erase(i);
-        else
-            ++i;
-    }
+    this->RemoveTile(this->FindTile(x, y));
 }
 
 /**
@@ -96,7 +119,21 @@ void CMap::RemoveTile(int x, int y)
  **/
 void CMap::RemoveTile(const math::CVector2& Pos)
 {
-    obj::CGameObject* pTile = this->FindTile(Pos);
+    this->RemoveTile(this->FindTile(Pos));
+}
+
+/**
+ * @overload CMap::RemoveTile(const int x, const int y);
+ * @param obj::CGameObject* Tile to remove.
+ **/
+void CMap::RemoveTile(const obj::CGameObject* pTile)
+{
+    if(pTile == NULL)
+        return;
+
+    this->OnTileChanged(pTile);
+    this->UnindexTile(pTile);
+    ++m_revision;
 
     for(std::vector<obj::CGameObject*>::iterator i = mp_allTiles.begin();
         i != mp_allTiles.end(); /* no third **/)
@@ -109,77 +146,430 @@ void CMap::RemoveTile(const math::CVector2& Pos)
 }
 
 /**
- * @overload CMap::RemoveTile(const int x, const int y);
- * @param obj::CGameObject* Tile to remove.
+ * Finds the first tile along a line segment.
+ *  Walks the grid cells the segment passes through, in order, and
+ *  stops at the first one with a tile in the way, so the cost depends
+ *  on the length of the segment rather than the number of tiles.
+ *
+ * @param math::CRay2& Line segment to cast
+ * @param math::CVector2* Output point where the segment enters the
+ *  tile (optional)
+ * @param float* Output time of impact, the fraction of the segment
+ *  covered before entering the tile (optional)
+ *
+ * @return The tile that was hit, NULL if nothing was.
+ * @see http://www.cse.yorku.ca/~amana/research/grid.pdf
  **/
-void CMap::RemoveTile(const obj::CGameObject* pTile)
+obj::CGameObject* CMap::CastRay(const math::CRay2& Ray,
+    math::CVector2* p_Hit, float* p_Time) const
 {
-    for(std::vector<obj::CGameObject*>::iterator i = mp_allTiles.begin();
-        i != mp_allTiles.end(); /* no third **/)
+    const float dx = Ray.End.x - Ray.Start.x;
+    const float dy = Ray.End.y - Ray.Start.y;
+
+    int cx, cy, end_cx, end_cy;
+    this->GetPointCell(Ray.Start.x, Ray.Start.y, cx, cy);
+    this->GetPointCell(Ray.End.x, Ray.End.y, end_cx, end_cy);
+
+    // Distance (as a fraction of the segment) to the next cell edge
+    // on each axis, and between consecutive edges. An axis the
+    // segment doesn't move along is never stepped.
+    int step_x = (dx > 0.0f) ? 1 : -1;
+    int step_y = (dy > 0.0f) ? 1 : -1;
+    float next_x = 2.0f, next_y = 2.0f;
+    float delta_x = 0.0f, delta_y = 0.0f;
+
+    if(dx != 0.0f)
     {
-        if((*i) == pTile)
-            i = mp_allTiles.erase(i);
+        next_x  = ((cx + (step_x > 0)) * TILE_SIZE - Ray.Start.x) / dx;
+        delta_x = TILE_SIZE / fabs(dx);
+    }
+
+    if(dy != 0.0f)
+    {
+        next_y  = ((cy + (step_y > 0)) * TILE_SIZE - Ray.Start.y) / dy;
+        delta_y = TILE_SIZE / fabs(dy);
+    }
+
+    while(true)
+    {
+        const TileCell* pCell = this->GetCell(cx, cy);
+        if(pCell != NULL && !pCell->empty())
+        {
+            obj::CGameObject* pClosest = NULL;
+            float closest = 2.0f, t;
+
+            for(size_t i = 0; i < pCell->size(); ++i)
+            {
+                if(Ray.Clip((*pCell)[i]->GetCollisionBox(), t) &&
+                   t < closest)
+                {
+                    pClosest = (*pCell)[i];
+                    closest  = t;
+                }
+            }
+
+            if(pClosest != NULL)
+            {
+                if(p_Hit != NULL)
+                    *p_Hit = Ray.Start + math::CVector2(dx, dy) * closest;
+
+                if(p_Time != NULL)
+                    *p_Time = closest;
+
+                return pClosest;
+            }
+        }
+
+        // Past the end of the segment?
+        if((cx == end_cx && cy == end_cy) || min(next_x, next_y) > 1.0f)
+            break;
+
+        if(next_x < next_y)
+        {
+            cx += step_x;
+            next_x += delta_x;
+        }
         else
-            ++i;
+        {
+            cy += step_y;
+            next_y += delta_y;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Casts a batch of line segments.
+ *  Every segment that hits a tile is cut off where it enters it.
+ *
+ * @param std::vector<math::CRay2>& Segments to cast
+ * @param std::vector<obj::CGameObject*>* Output tile hit by each
+ *  segment, NULL for misses (optional)
+ *
+ * @see CMap::CastRay()
+ **/
+void CMap::CastRays(std::vector<math::CRay2>& Rays,
+    std::vector<obj::CGameObject*>* p_Hits) const
+{
+    if(p_Hits != NULL)
+        p_Hits->resize(Rays.size());
+
+    math::CVector2 Hit;
+    for(size_t i = 0; i < Rays.size(); ++i)
+    {
+        obj::CGameObject* pTile = this->CastRay(Rays[i], &Hit);
+        if(pTile != NULL)
+            Rays[i].End = Hit;
+
+        if(p_Hits != NULL)
+            (*p_Hits)[i] = pTile;
+    }
+}
+
+/**
+ * Retrieves the current map tiles.
+ * @return An unmodifiable vector reference to the current tiles.
+ **/
+const std::vector<obj::CGameObject*>& CMap::GetTiles() const
+{
+    return mp_allTiles;
+}
+
+/**
+ * Retrieves the tile occupying a grid cell.
+ *
+ * @param int Cell x-coordinate
+ * @param int Cell y-coordinate
+ * @return The first tile in the cell, NULL if it's empty.
+ * @see CMap::GetTileCell()
+ **/
+obj::CGameObject* CMap::GetTileAt(const int cx, const int cy) const
+{
+    const TileCell* pCell = this->GetCell(cx, cy);
+    if(pCell == NULL || pCell->empty())
+        return NULL;
+
+    return pCell->front();
+}
+
+/**
+ * Retrieves the map revision.
+ *  The revision changes every time a tile is added or removed, so
+ *  anything derived from the tiles can tell when it's out of date.
+ *
+ * @return The current revision.
+ **/
+u_int CMap::GetRevision() const
+{
+    return m_revision;
+}
+
+/**
+ * Outlines the collision box of every tile in view.
+ *  Nothing is added unless the layer is shown as an overlay.
+ *
+ * @param gfx::CLineBatch& Batch to add the outlines to
+ * @param gfx::Color& Outline color
+ * @param math::CRect& Area to outline tiles in, in world coordinates
+ **/
+void CMap::DrawOverlay(gfx::CLineBatch& Batch, const gfx::Color& Color,
+    const math::CRect& View) const
+{
+    if(m_display != e_DISPLAY_OVERLAY)
+        return;
+
+    // Tiles are indexed by their nearest cell, so one may reach
+    // into the view from a cell just outside of it.
+    int left, top, right, bottom;
+    this->GetPointCell(View.x, View.y, left, top);
+    this->GetPointCell(View.x + View.w, View.y + View.h, right, bottom);
+
+    for(int cy = top - 1; cy <= bottom + 1; ++cy)
+    {
+        for(int cx = left - 1; cx <= right + 1; ++cx)
+        {
+            const TileCell* pCell = this->GetCell(cx, cy);
+            if(pCell == NULL)
+                continue;
+
+            for(size_t i = 0; i < pCell->size(); ++i)
+                Batch.DrawRect((*pCell)[i]->GetCollisionBox(), Color);
+        }
     }
 }
 
 /**
- * Pans the map in the proper direction if the given position
- * is within 100 pixels of the screen boundaries.
+ * Changes how the layer is drawn.
+ * @param DisplayMode New display mode
+ **/
+void CMap::SetDisplayMode(const DisplayMode mode)
+{
+    m_display = mode;
+}
+
+CMap::DisplayMode CMap::GetDisplayMode() const
+{
+    return m_display;
+}
+
+/**
+ * Retrieves the bounds of the spatial index.
+ * @return The first cell (x, y) and the grid dimensions (w, h) in cells.
+ **/
+const math::CRect& CMap::GetIndexBounds() const
+{
+    return m_IndexBounds;
+}
+
+/**
+ * Adds a tile to the map and places it in the spatial index.
+ *  The tile must already have been moved to its final position.
+ *
+ * @param obj::CGameObject* Tile to add (the map takes ownership)
+ **/
+void CMap::AddTile(obj::CGameObject* pTile)
+{
+    mp_allTiles.push_back(pTile);
+    this->IndexTile(pTile);
+    ++m_revision;
+    this->OnTileChanged(pTile);
+}
+
+/**
+ * Creates a block of tiles at once, for loading a whole map.
+ *  The tiles are owned by the map, but aren't added to it. They're
+ *  freed together by ClearTiles() rather than deleted one by one.
+ *
+ * @param u_int Number of tiles
+ * @return The first tile of the block.
  *
- * @param math::CVector2& Position
- * @return TRUE if panning was done, FALSE otherwise.
+ * @pre The map has no tiles, see ClearTiles().
  **/
-bool CMap::Pan(const math::CVector2& Position)
+obj::CGameObject* CMap::CreateTiles(const u_int count)
 {
-    int dx = 0, dy = 0;
-    m_PanRate.Move(dx, dy);
+    m_TileBlock.resize(count);
+    mp_allTiles.reserve(count);
 
-    if(Position.x > 800.0f - 200.0f)
-        dx = -m_pan_adjustment_rate;
-    else if(Position.x < 200.0f)
-        dx = m_pan_adjustment_rate;
-    if(Position.y > 600.0f - 150.0f)
-        dy = -m_pan_adjustment_rate;
-    else if(Position.y < 150.0f)
-        dy = m_pan_adjustment_rate;
+    return m_TileBlock.empty() ? NULL : &m_TileBlock[0];
+}
 
-    for(size_t i = 0; i < mp_allTiles.size(); i++)
+/**
+ * Deletes all tiles and empties the spatial index.
+ **/
+void CMap::ClearTiles()
+{
+    const obj::CGameObject* pFirst = m_TileBlock.empty() ?
+        NULL : &m_TileBlock.front();
+    const obj::CGameObject* pLast  = m_TileBlock.empty() ?
+        NULL : &m_TileBlock.back();
+
+    for(size_t i = 0; i < mp_allTiles.size(); ++i)
     {
-        mp_allTiles[i]->Move_Rate(dx, dy);
+        if(mp_allTiles[i] < pFirst || mp_allTiles[i] > pLast)
+            delete mp_allTiles[i];
     }
 
-    m_PanRate.Move(dx, dy);
+    mp_allTiles.clear();
+    m_TileBlock.clear();
+    m_TileIndex.clear();
+    m_IndexBounds = math::CRect();
+    ++m_revision;
+}
+
+/**
+ * Rebuilds the spatial index from scratch.
+ *  The grid is sized to fit every tile up front, so a freshly
+ *  loaded map is indexed with a single allocation.
+ **/
+void CMap::RebuildIndex()
+{
+    ++m_revision;
+    m_TileIndex.clear();
+    m_IndexBounds = math::CRect();
+
+    if(mp_allTiles.empty())
+        return;
+
+    int min_x, min_y, max_x, max_y, cx, cy;
+    this->GetTileCell(mp_allTiles[0], min_x, min_y);
+    max_x = min_x;
+    max_y = min_y;
 
-    return (dx != 0 || dy != 0);
+    for(size_t i = 1; i < mp_allTiles.size(); ++i)
+    {
+        this->GetTileCell(mp_allTiles[i], cx, cy);
+        min_x = min(min_x, cx); max_x = max(max_x, cx);
+        min_y = min(min_y, cy); max_y = max(max_y, cy);
+    }
+
+    m_IndexBounds = math::CRect(min_x, min_y,
+        max_x - min_x + 1, max_y - min_y + 1);
+    m_TileIndex.resize(m_IndexBounds.w * m_IndexBounds.h);
+
+    for(size_t i = 0; i < mp_allTiles.size(); ++i)
+    {
+        this->GetTileCell(mp_allTiles[i], cx, cy);
+        m_TileIndex[(cy - min_y) * m_IndexBounds.w + (cx - min_x)].
+            push_back(mp_allTiles[i]);
+    }
 }
 
 /**
- * Sets the rate at which to pan the map.
- * @param int Rate
+ * Places a single tile in the spatial index, growing the grid
+ * if the tile lies outside of it.
+ *
+ * @param obj::CGameObject* Tile to index
  **/
-void CMap::SetPanRate(const int rate)
+void CMap::IndexTile(obj::CGameObject* pTile)
 {
-    m_pan_adjustment_rate = rate;
+    int cx, cy;
+    this->GetTileCell(pTile, cx, cy);
+
+    if(this->GetCell(cx, cy) == NULL)
+    {
+        this->RebuildIndex();
+        return;
+    }
+
+    m_TileIndex[(cy - m_IndexBounds.y) * m_IndexBounds.w +
+        (cx - m_IndexBounds.x)].push_back(pTile);
+}
+
+/**
+ * Takes a tile out of the spatial index.
+ * @param obj::CGameObject* Tile to remove
+ **/
+void CMap::UnindexTile(const obj::CGameObject* pTile)
+{
+    int cx, cy;
+    this->GetTileCell(pTile, cx, cy);
+
+    if(this->GetCell(cx, cy) == NULL)
+        return;
+
+    TileCell& Cell = m_TileIndex[(cy - m_IndexBounds.y) *
+        m_IndexBounds.w + (cx - m_IndexBounds.x)];
+
+    for(TileCell::iterator i = Cell.begin(); i != Cell.end(); ++i)
+    {
+        if((*i) == pTile)
+        {
+            Cell.erase(i);
+            return;
+        }
+    }
 }
 
 /**
- * Retrieves the latest panning rate.
+ * Calculates the grid cell a tile belongs to.
+ *  Movement that hasn't been applied yet (via Tick()) is taken into
+ *  account, so tiles can be indexed right after a call to Move().
  *
- * @see CMap::Pan()
- * @return A vector representing the pan rate.
+ * @param obj::CGameObject* Tile
+ * @param int& Cell x-coordinate (output)
+ * @param int& Cell y-coordinate (output)
  **/
-const math::CVector2& CMap::GetPanRate() const
+void CMap::GetTileCell(const obj::CGameObject* pTile, int& cx, int& cy) const
 {
-    return m_PanRate;
+    math::CVector2 Pos = pTile->GetPosition() + pTile->GetMovementRate();
+
+    // Round to the nearest cell, tiles are aligned to the grid.
+    cx = (int)floor(Pos.x / TILE_SIZE + 0.5f);
+    cy = (int)floor(Pos.y / TILE_SIZE + 0.5f);
 }
 
 /**
- * Retrieves the current map tiles.
- * @return An unmodifiable vector reference to the current tiles.
+ * Calculates the grid cell containing a point.
+ *
+ * @param float X-coordinate
+ * @param float Y-coordinate
+ * @param int& Cell x-coordinate (output)
+ * @param int& Cell y-coordinate (output)
  **/
-const std::vector<obj::CGameObject*>& CMap::GetTiles() const
+void CMap::GetPointCell(float x, float y, int& cx, int& cy) const
 {
-    return mp_allTiles;
+    cx = (int)floor(x / TILE_SIZE);
+    cy = (int)floor(y / TILE_SIZE);
+}
+
+/**
+ * Retrieves the tiles in a grid cell.
+ *
+ * @param int Cell x-coordinate
+ * @param int Cell y-coordinate
+ * @return The cell, or NULL if it lies outside of the grid.
+ **/
+const CMap::TileCell* CMap::GetCell(const int cx, const int cy) const
+{
+    if(cx < m_IndexBounds.x || cy < m_IndexBounds.y ||
+       cx >= m_IndexBounds.x + (int)m_IndexBounds.w ||
+       cy >= m_IndexBounds.y + (int)m_IndexBounds.h)
+        return NULL;
+
+    return &m_TileIndex[(cy - m_IndexBounds.y) * m_IndexBounds.w +
+        (cx - m_IndexBounds.x)];
+}
+
+/**
+ * Finds a tile in a single grid cell that collides with a point.
+ *
+ * @param int Cell x-coordinate
+ * @param int Cell y-coordinate
+ * @param float X-coordinate
+ * @param float Y-coordinate
+ * @return The first colliding tile, or NULL if there is none.
+ **/
+obj::CGameObject* CMap::FindInCell(const int cx, const int cy,
+    const float x, const float y) const
+{
+    const TileCell* pCell = this->GetCell(cx, cy);
+    if(pCell == NULL)
+        return NULL;
+
+    for(size_t i = 0; i < pCell->size(); ++i)
+        if((*pCell)[i]->CheckCollision(x, y))
+            return (*pCell)[i];
+
+    return NULL;
 }
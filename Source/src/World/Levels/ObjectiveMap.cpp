@@ -10,6 +10,7 @@
 #include <fstream>
 
 #include "World/Levels/ObjectiveMap.hpp"
+#include "World/Levels/LevelFile.hpp"
 
 using game::CObjectiveMap;
 using asset::CAssetManager;
@@ -21,6 +22,16 @@ using asset::CAssetManager;
  **/
 CObjectiveMap::CObjectiveMap(bool can_edit) : CMap(can_edit)
 {
+    const gfx::Color Type_Colors[4] = {gfx::PURPLE, gfx::RED, gfx::BLACK,
+        gfx::create_color(255, 255, 0)};
+
+    for(int i = 0; i < 4; ++i)
+    {
+        SDL_Surface* pSwatch = gfx::create_surface_alpha(32, 32, Type_Colors[i]);
+        m_TypeTextures[i].LoadFromSurface(pSwatch);
+        SDL_FreeSurface(pSwatch);
+    }
+
     mp_Overlay = gfx::create_surface_alpha(32, 32, gfx::PURPLE);
 
     if(can_edit)
@@ -67,9 +78,7 @@ bool CObjectiveMap::Load(const char* pfilename)
         return false;
     }
 
-    for(size_t i = 0; i < mp_allTiles.size(); ++i)
-        delete mp_allTiles[i];
-    mp_allTiles.clear();
+    this->ClearTiles();
 
     while(std::getline(map, line))
     {
@@ -120,10 +129,13 @@ bool CObjectiveMap::Load(const char* pfilename)
 
         // Move the tile and it to all tiles
         pTile->Move(x, y);
-        pTile->Update();
+        pTile->Tick();
         mp_allTiles.push_back(pTile);
     }
 
+    // Index everything in one go.
+    this->RebuildIndex();
+
     if(m_can_edit)
         mp_CurrentTile->LoadFromSurface(mp_Overlay);
 
@@ -133,6 +145,54 @@ bool CObjectiveMap::Load(const char* pfilename)
     return true;
 }
 
+/**
+ * Loads the objectives from a compiled level.
+ *  Tiles of the same type share a texture, and they're all created
+ *  in a single block.
+ *
+ * @param game::CLevelFile& Compiled level
+ * @return TRUE.
+ **/
+bool CObjectiveMap::Load(const game::CLevelFile& Level)
+{
+    const game::CLevelFile::Header& Info = Level.GetHeader();
+    const game::CLevelFile::Objective* pRecords = Level.GetObjectives();
+
+    this->ClearTiles();
+    m_allTileAttributes.clear();
+
+    for(size_t i = 0; i < mp_allLights.size(); ++i)
+        delete mp_allLights[i];
+    mp_allLights.clear();
+
+    obj::CGameObject* pTiles = this->CreateTiles(Info.objective_count);
+    m_allTileAttributes.reserve(Info.objective_count);
+
+    for(u_int i = 0; i < Info.objective_count; ++i)
+    {
+        const TileAttributes type = (TileAttributes)min(pRecords[i].type,
+            (u_int)e_LIGHT);
+        const int x = pRecords[i].cx * TILE_SIZE;
+        const int y = pRecords[i].cy * TILE_SIZE;
+
+        if(type == e_LIGHT)
+        {
+            mp_allLights.push_back(new gfx::CLight);
+            mp_allLights.back()->SetPosition(x, y);
+        }
+
+        pTiles[i].LoadFromTexture(&m_TypeTextures[type]);
+        pTiles[i].Move(x, y);
+        pTiles[i].Tick();
+        mp_allTiles.push_back(&pTiles[i]);
+        m_allTileAttributes.push_back(type);
+    }
+
+    this->RebuildIndex();
+
+    return true;
+}
+
 /**
  * Saves a map file.
  *
@@ -152,23 +212,9 @@ bool CObjectiveMap::Save(const char* pfilename)
     std::stringstream line;
     std::ofstream map_file(pfilename);
 
-    // First, adjust all map tiles so the first one is at (0, 0)
-    // Basically, undo any panning operations.
-    float min_x = mp_allTiles[0]->GetX();
-    float min_y = mp_allTiles[0]->GetY();
-    for(size_t i = 0; i < mp_allTiles.size(); ++i)
-    {
-        min_x = min(mp_allTiles[i]->GetX(), min_x);
-    }
+    // Tiles are stored in world coordinates, so they can be written as-is.
     for(size_t i = 0; i < mp_allTiles.size(); ++i)
     {
-        min_y = min(mp_allTiles[i]->GetY(), min_y);
-    }
-
-    for(size_t i = 0; i < mp_allTiles.size(); ++i)
-    {
-        mp_allTiles[i]->Move_Rate(-min_x, -min_y);
-
         line << m_allTileAttributes[i] << ":";
         line << (int)mp_allTiles[i]->GetX() << ",";
         line << (int)mp_allTiles[i]->GetY() << std::endl;
@@ -229,9 +275,11 @@ void CObjectiveMap::PlaceTile(int x, int y)
         pTile = this->FindTile(x, y);
         if(pTile == NULL)
         {
+            pTile = new obj::CGameObject;
             pTile->LoadFromSurface(mp_Overlay);
             pTile->Move(x, y);
-            mp_allTiles.push_back(pTile);
+            pTile->Tick();
+            this->AddTile(pTile);
             Uint32 raw_color = gfx::get_pixel(mp_Overlay, 0, 0);
 
             // Convert 32-bit int to rgb values
@@ -259,38 +307,33 @@ void CObjectiveMap::PlaceTile(int x, int y)
         }
         else
         {
-            for(std::vector<obj::CGameObject*>::iterator i = mp_allTiles.begin();
-                i != mp_allTiles.end(); /* no third **/)
-            {
-                if((*i) == pTile)
-                    i = mp_allTiles.erase(i);
-                else
-                    ++i;
-            }
+            this->RemoveTile(pTile);
         }
     }
     else
     {
-        for(std::vector<obj::CGameObject*>::iterator i = mp_allTiles.begin();
-            i != mp_allTiles.end(); /* no third **/)
-        {
-            if((*i) == pTile)
-                i = mp_allTiles.erase(i);
-            else
-                ++i;
-        }
+        this->RemoveTile(pTile);
     }
 }
 
 /**
- * Updates all the tiles on-screen if edit mode is enabled.
+ * Draws all the tiles, and the placeable tile if edit mode is enabled.
+ *  Tiles are only drawn when they're displayed as tiles, but the
+ *  placeable tile is shown in any display mode.
+ *
  * @param bool Should we show the main placeable tile?
  **/
-void CObjectiveMap::Update(bool show_active)
+void CObjectiveMap::Render(bool show_active)
 {
-    for(size_t i = 0; i < mp_allTiles.size(); ++i)
-        if(mp_allTiles[i] != NULL)
-            mp_allTiles[i]->Update();
+    if(m_display == e_DISPLAY_TILES)
+    {
+        // Tiles never overlap, so they can be drawn in any order.
+        m_Batch.Begin(gfx::CSpriteBatch::e_SORT_TEXTURE);
+        for(size_t i = 0; i < mp_allTiles.size(); ++i)
+            if(mp_allTiles[i] != NULL)
+                mp_allTiles[i]->Render(m_Batch);
+        m_Batch.End();
+    }
 
     if(m_can_edit)
     {
@@ -305,23 +348,6 @@ void CObjectiveMap::Update(bool show_active)
     }
 }
 
-/**
- * Pans the map in the proper direction if the given position
- * is within 100 pixels of the screen boundaries.
- *
- * @param math::CVector2& Position
- * @return TRUE if panning was done, FALSE otherwise.
- **/
-bool CObjectiveMap::Pan(const math::CVector2& Position)
-{
-    bool val = CMap::Pan(Position);
-
-    for(size_t i = 0; i < mp_allLights.size(); ++i)
-        mp_allLights[i]->Adjust(m_PanRate);
-
-    return val;
-}
-
 /**
  * Finds the nearest point-of-interest.
  *  Given a location, finds the nearest point of interest that is at
@@ -422,3 +448,15 @@ std::vector<gfx::CLight*>& CObjectiveMap::GetLights()
 {
     return mp_allLights;
 }
+
+/**
+ * Retrieves the type of a tile.
+ *
+ * @param size_t Index of the tile, as in GetTiles()
+ * @return The tile's attribute.
+ **/
+CObjectiveMap::TileAttributes CObjectiveMap::GetAttribute(
+    const size_t index) const
+{
+    return m_allTileAttributes[index];
+}
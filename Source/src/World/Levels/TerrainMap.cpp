@@ -3,13 +3,14 @@
  *  Definitions for the CTerrainMap class
  *
  * @author George Kudrayvtsev
- * @version 1.1.2
+ * @version 1.2.0
  **/
 
 #include <sstream>
 #include <fstream>
 
 #include "World/Levels/TerrainMap.hpp"
+#include "World/Levels/LevelFile.hpp"
 
 using game::CTerrainMap;
 using asset::CAssetManager;
@@ -62,6 +63,7 @@ CTerrainMap::~CTerrainMap()
     g_Log.Flush();
     g_Log << "[DEBUG] CTerrainMap::~CTerrainMap() called.\n";
     m_textureNames.clear();
+    this->ClearChunks();
 }
 
 /**
@@ -93,10 +95,7 @@ bool CTerrainMap::Load(const char* pfilename)
         return false;
     }
 
-    for(size_t i = 0; i < mp_allTiles.size(); ++i)
-        delete mp_allTiles[i];
-
-    mp_allTiles.clear();
+    this->ClearTiles();
 
     while(std::getline(map, line))
     {
@@ -133,18 +132,76 @@ bool CTerrainMap::Load(const char* pfilename)
 
         // Move tile to parsed coordinates.
         p_Tile->Move(x, y);
-        p_Tile->Update();
+        p_Tile->Tick();
 
         // Add to all tiles.
         mp_allTiles.push_back(p_Tile);
     }
 
+    // Index everything in one go, the meshes follow on the next Render().
+    this->RebuildIndex();
+    this->ClearChunks();
+
     tileData.clear();
     map.close();
     
     return true;
 }
 
+/**
+ * Loads the terrain from a compiled level.
+ *  Each texture is looked up once, and every tile is created in a
+ *  single block.
+ *
+ * @param game::CLevelFile& Compiled level
+ * @return TRUE.
+ **/
+bool CTerrainMap::Load(const game::CLevelFile& Level)
+{
+    const game::CLevelFile::Header& Info = Level.GetHeader();
+
+    this->ClearTiles();
+
+    std::vector<const asset::CTexture*> pTextures(Info.texture_count, NULL);
+    for(u_int i = 0; i < Info.texture_count; ++i)
+    {
+        if(this->IsValidTextureName(Level.GetTextureName(i)))
+        {
+            pTextures[i] = (const asset::CTexture*)CAssetManager::Find(
+                Level.GetTextureName(i));
+        }
+    }
+
+    const unsigned short* pGrid = Level.GetTerrain();
+    obj::CGameObject* pTiles = this->CreateTiles(Info.terrain_count);
+    u_int count = 0;
+
+    for(u_int y = 0; y < Info.h; ++y)
+    {
+        for(u_int x = 0; x < Info.w; ++x)
+        {
+            const u_int id = pGrid[y * Info.w + x];
+            if(id == 0 || id > Info.texture_count || pTextures[id - 1] == NULL ||
+               count == Info.terrain_count)
+            {
+                continue;
+            }
+
+            obj::CGameObject* pTile = &pTiles[count++];
+            pTile->LoadFromTexture(pTextures[id - 1]);
+            pTile->Move((Info.x + (int)x) * TILE_SIZE,
+                (Info.y + (int)y) * TILE_SIZE);
+            pTile->Tick();
+            mp_allTiles.push_back(pTile);
+        }
+    }
+
+    this->RebuildIndex();
+    this->ClearChunks();
+
+    return true;
+}
+
 /**
  * Saves a map file.
  *
@@ -170,23 +227,9 @@ bool CTerrainMap::Save(const char* p_filename)
     g_Log.Flush();
     g_Log << "[INFO] Saving terrain map: " << p_filename << ".\n";
 
-    // First, adjust all map tiles so the first one is at (0, 0)
-    // Basically, undo any panning operations.
-    float min_x = mp_allTiles[0]->GetX();
-    float min_y = mp_allTiles[0]->GetY();
-    for(size_t i = 0; i < mp_allTiles.size(); ++i)
-    {
-        min_x = min(mp_allTiles[i]->GetX(), min_x);
-    }
+    // Tiles are stored in world coordinates, so they can be written as-is.
     for(size_t i = 0; i < mp_allTiles.size(); ++i)
     {
-        min_y = min(mp_allTiles[i]->GetY(), min_y);
-    }
-
-    for(size_t i = 0; i < mp_allTiles.size(); ++i)
-    {
-        mp_allTiles[i]->Move_Rate(-min_x, -min_y);
-
         line << mp_allTiles[i]->GetFilename();
         line << ":" << (int)mp_allTiles[i]->GetX() << ",";
         line << (int)mp_allTiles[i]->GetY() << std::endl;
@@ -245,7 +288,8 @@ void CTerrainMap::PlaceTile(int x, int y)
             p_Tile->LoadFromTexture((asset::CTexture*)CAssetManager::Find(
                 mp_CurrentTile->GetFilename().c_str()));
             p_Tile->Move(x, y);
-            mp_allTiles.push_back(p_Tile);
+            p_Tile->Tick();
+            this->AddTile(p_Tile);
         }
         else
         {
@@ -269,14 +313,47 @@ void CTerrainMap::PlaceTile(int x, int y)
 }
 
 /**
- * Updates all the tiles on-screen.
+ * Draws all the tiles on-screen.
  * @param bool Should we show the main placeable tile?
  **/
-void CTerrainMap::Update(bool show_active)
+void CTerrainMap::Render(bool show_active)
 {
-    for(size_t i = 0; i < mp_allTiles.size(); ++i)
+    if(m_display != e_DISPLAY_TILES)
+        return;
+
+    // Tiles were added outside of the current chunks, or a new map
+    // was loaded.
+    if(mp_allChunks.empty() || !(m_ChunkBounds == this->GetIndexBounds()))
+        this->LayoutChunks();
+
+    int w = (m_ChunkBounds.w + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    int h = (m_ChunkBounds.h + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    int left = 0, top = 0, right = w - 1, bottom = h - 1;
+
+    // Only draw the chunks in view. Tiles are placed by rounding, so
+    // allow for one poking a little into the next chunk.
+    if(m_View.w > 0 && m_View.h > 0)
     {
-        mp_allTiles[i]->Update();
+        const float span = CHUNK_SIZE * TILE_SIZE;
+        float x = m_View.x - TILE_SIZE - m_ChunkBounds.x * TILE_SIZE;
+        float y = m_View.y - TILE_SIZE - m_ChunkBounds.y * TILE_SIZE;
+
+        left   = max(left,   (int)floor(x / span));
+        top    = max(top,    (int)floor(y / span));
+        right  = min(right,  (int)floor((x + m_View.w + 2 * TILE_SIZE) / span));
+        bottom = min(bottom, (int)floor((y + m_View.h + 2 * TILE_SIZE) / span));
+    }
+
+    for(int y = top; y <= bottom; ++y)
+    {
+        for(int x = left; x <= right; ++x)
+        {
+            Chunk* pChunk = mp_allChunks[y * w + x];
+            if(pChunk->dirty)
+                this->BuildChunk(x, y);
+
+            pChunk->Mesh.Render();
+        }
     }
 
     if(m_can_edit && show_active)
@@ -289,6 +366,102 @@ void CTerrainMap::Update(bool show_active)
     }
 }
 
+/**
+ * Sets the part of the world that needs to be drawn.
+ *
+ * @param math::CRect& View rectangle in world coordinates, or an
+ *  empty one to draw the whole map
+ *
+ * @see game::CCamera::GetView()
+ **/
+void CTerrainMap::SetView(const math::CRect& View)
+{
+    m_View = View;
+}
+
+/**
+ * Marks the chunk a tile is in as needing a rebuild.
+ * @param obj::CGameObject* Tile that was added or removed
+ **/
+void CTerrainMap::OnTileChanged(const obj::CGameObject* pTile)
+{
+    int cx, cy;
+    this->GetTileCell(pTile, cx, cy);
+
+    // Outside of the chunks means the index grows, which
+    // lays out the chunks from scratch anyway.
+    int x = cx - m_ChunkBounds.x, y = cy - m_ChunkBounds.y;
+    if(mp_allChunks.empty() || x < 0 || y < 0 ||
+       x >= (int)m_ChunkBounds.w || y >= (int)m_ChunkBounds.h)
+        return;
+
+    int w = (m_ChunkBounds.w + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    mp_allChunks[(y / CHUNK_SIZE) * w + (x / CHUNK_SIZE)]->dirty = true;
+}
+
+/// Throws away all of the chunk meshes.
+void CTerrainMap::ClearChunks()
+{
+    for(size_t i = 0; i < mp_allChunks.size(); ++i)
+        delete mp_allChunks[i];
+
+    mp_allChunks.clear();
+    m_ChunkBounds = math::CRect();
+}
+
+/**
+ * Splits the map into chunks covering the whole tile index.
+ *  Every chunk starts out dirty, and is built when it's first drawn.
+ **/
+void CTerrainMap::LayoutChunks()
+{
+    this->ClearChunks();
+    m_ChunkBounds = this->GetIndexBounds();
+
+    int w = (m_ChunkBounds.w + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    int h = (m_ChunkBounds.h + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+    for(int i = 0; i < w * h; ++i)
+    {
+        Chunk* pChunk = new Chunk;
+        pChunk->dirty = true;
+        mp_allChunks.push_back(pChunk);
+    }
+}
+
+/**
+ * Builds the mesh for a single chunk.
+ *
+ * @param int Chunk x-coordinate
+ * @param int Chunk y-coordinate
+ **/
+void CTerrainMap::BuildChunk(const int x, const int y)
+{
+    int w = (m_ChunkBounds.w + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    Chunk* pChunk = mp_allChunks[y * w + x];
+
+    int first_x = m_ChunkBounds.x + x * CHUNK_SIZE;
+    int first_y = m_ChunkBounds.y + y * CHUNK_SIZE;
+
+    // Tiles never overlap, so they can be drawn in any order.
+    pChunk->Mesh.Begin(gfx::CSpriteBatch::e_SORT_TEXTURE);
+    for(int cy = first_y; cy < first_y + CHUNK_SIZE; ++cy)
+    {
+        for(int cx = first_x; cx < first_x + CHUNK_SIZE; ++cx)
+        {
+            const TileCell* pCell = this->GetCell(cx, cy);
+            if(pCell == NULL)
+                continue;
+
+            for(size_t i = 0; i < pCell->size(); ++i)
+                (*pCell)[i]->Render(pChunk->Mesh);
+        }
+    }
+    pChunk->Mesh.End(false);
+
+    pChunk->dirty = false;
+}
+
 /**
  * Tests for a valid, available texture name.
  *
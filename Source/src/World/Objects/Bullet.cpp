@@ -84,13 +84,13 @@ void CBullet::Fire(const math::CVector2& Target)
 }
 
 /**
- * Renders the bullet on-screen and updates its position.
+ * Updates the bullet's position.
  * @pre A bullet image has been loaded.
  */
-void CBullet::Update()
+void CBullet::Tick()
 {
     this->Move_Rate(m_Rate);
-    this->CEntity::Update();
+    this->CEntity::Tick();
 }
 
 /**
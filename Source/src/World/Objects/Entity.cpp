@@ -3,7 +3,7 @@
 using obj::CEntity;
 
 CEntity::CEntity() : m_RenderDimensions(0, 0, 1.0f, 1.0f), 
-    m_rotation_angle(0.0f), m_useblending(false)
+    m_rotation_angle(0.0f), m_useblending(false), m_snap(true)
 {
     memset(&m_vertices, 0, sizeof m_vertices);
 }
@@ -45,11 +45,13 @@ bool CEntity::LoadFromEntity(CEntity* pOther)
 void CEntity::Move(const math::CVector2& Position)
 {
     m_MovementRate.Move(Position - m_Position);
+    m_snap = true;
 }
 
 void CEntity::Move(const float x, const float y)
 {
     m_MovementRate.Move(x - m_Position.x, y - m_Position.y);
+    m_snap = true;
 }
 
 void CEntity::Move_Rate(const math::CVector2& Rate)
@@ -84,55 +86,83 @@ void CEntity::ResizeTexture(const math::CRect& NewSize)
     m_Texture.Resize(NewSize.w, NewSize.h);
 }
 
-void CEntity::Update()
-{
+/**
+ * Advances the entity by a simulation tick.
+ *  Any movement queued up since the last tick is applied. Nothing
+ *  is drawn, see Render() for that. Ticks are a fixed length,
+ *  see game::SIM_RATE.
+ **/
+void CEntity::Tick()
+{
+    m_LastPosition = m_Position;
     m_Position = m_Position + m_MovementRate;
     m_MovementRate.Move(0, 0);
 
+    // Jumping somewhere with Move() shouldn't be drawn as a slide.
+    if(m_snap)
+        m_LastPosition = m_Position;
+
+    m_snap = false;
+
     m_vertices[0] = m_Position.x;
     m_vertices[1] = m_Position.y;
     m_vertices[2] = m_Position.x + m_Texture.GetW();
     m_vertices[3] = m_Position.y + m_Texture.GetH();
+}
 
-    float* pvertices = this->GetVertices();
-    const math::CRectf& Rendering = this->GetRenderDimensions();
-
-    glLoadIdentity();
-
-    // Rotate the object around its origin.
-    glTranslatef(
-        this->GetX() + this->GetW() / 2,
-        this->GetY() + this->GetH() / 2,
-        0.0f);
-    glRotatef(this->GetRotationAngle(), 0.0f, 0.0f, 1.0f);
-    glTranslatef(
-        -this->GetX() - this->GetW() / 2,
-        -this->GetY() - this->GetH() / 2,
-        0.0f);
-
-    // Activate the texture
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, this->GetGLTexture());
-
-    glBegin(GL_QUADS);
+/**
+ * Queues the entity up in a sprite batch.
+ *  The entity is drawn part way between where it was before the
+ *  last Tick() and where it is now, so movement stays smooth when
+ *  frames and ticks don't line up.
+ *
+ * @param gfx::CSpriteBatch& Batch to draw in, which has to be active
+ * @param float How far along the next tick is, [0, 1] (optional)
+ **/
+void CEntity::Render(gfx::CSpriteBatch& Batch, const float alpha) const
+{
+    math::CVector2 Position = m_LastPosition +
+        (m_Position - m_LastPosition) * alpha;
 
-    // Top left corner
-    glTexCoord2f(Rendering.x, Rendering.y);
-    glVertex2f(pvertices[0], pvertices[1]);
+    math::CRectf Dest(Position.x, Position.y,
+        m_Texture.GetW(), m_Texture.GetH());
 
-    // Top right corner
-    glTexCoord2f(Rendering.x + Rendering.w, Rendering.y);
-    glVertex2f(pvertices[2], pvertices[1]);
+    // Render dimensions are relative to the texture, which may
+    // only be part of an atlas page.
+    const math::CRectf& UV = m_Texture.GetUV();
+    const math::CRectf& Rendering = this->GetRenderDimensions();
+    math::CRectf TexCoords(UV.x + Rendering.x * UV.w,
+        UV.y + Rendering.y * UV.h, Rendering.w * UV.w, Rendering.h * UV.h);
 
-    // Bottom right corner
-    glTexCoord2f(Rendering.x + Rendering.w, Rendering.y + Rendering.h);
-    glVertex2f(pvertices[2], pvertices[3]);
+    Batch.Draw(this->GetGLTexture(), Dest, TexCoords,
+        this->GetRotationAngle());
+}
 
-    // Bottom left corner
-    glTexCoord2f(Rendering.x, Rendering.y + Rendering.h);
-    glVertex2f(pvertices[0], pvertices[3]);
+/// Queues up in the active batch, or draws right away if there isn't one.
+void CEntity::Draw() const
+{
+    gfx::CSpriteBatch* pBatch = gfx::CSpriteBatch::GetActive();
+    if(pBatch != NULL)
+    {
+        this->Render(*pBatch);
+    }
+    else
+    {
+        static gfx::CSpriteBatch Immediate;
+        Immediate.Begin(gfx::CSpriteBatch::e_SORT_NONE);
+        this->Render(Immediate);
+        Immediate.End();
+    }
+}
 
-    glEnd();
+/**
+ * Ticks and draws the entity in one go.
+ *  Meant for menus and other things that aren't simulated.
+ **/
+void CEntity::Update()
+{
+    this->Tick();
+    this->Draw();
 }
 
 void CEntity::SetBlending(bool flag)
@@ -86,9 +86,9 @@ void CGameObject::ResizeCollisionBox(const math::CRect& NewSize)
     m_CollisionBox = NewSize;
 }
 
-void CGameObject::Update()
+void CGameObject::Tick()
 {
-    CEntity::Update();
+    CEntity::Tick();
     m_CollisionBox.Move(m_Position);
 }
 
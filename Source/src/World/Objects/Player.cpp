@@ -18,7 +18,7 @@ CPlayer::CPlayer() : m_kills(0), m_survivors_saved(0), m_days_survived(1){}
  *  The main sprite image is loaded here, which resides in "Data/Images"
  *  for the time being. Since there are multiple sprites in the sheet,
  *  they are each cut out, and the GL_Entity is resized to 64x64 to
- *  exclusively accompany the first sprite. Then, in the Update() method,
+ *  exclusively accompany the first sprite. Then, in the Render() method,
  *  only half of the whole texture is rendered, properly displaying the
  *  sprite in use.
  **/
@@ -50,15 +50,6 @@ bool CPlayer::Init(game::CSettings& Settings)
     return true;
 }
 
-/**
- * Render the tank and the tower on-screen.
- * @todo Animate tank tower on firing.
- **/
-int CPlayer::Update()
-{
-    return CTank::Update();
-}
-
 void CPlayer::SetSpawn(const math::CVector2& Pos)
 {
     m_Tank.Move(Pos);
@@ -54,18 +54,28 @@ void CProjectile::Launch(const math::CVector2& Start,
 }
 
 /**
- * Renders the bullet on-screen and updates its position.
- * @pre A bullet image has been loaded.
+ * Moves the bullet, if it's still flying.
+ * @pre The bullet has been launched.
  **/
-void CProjectile::Update()
+void CProjectile::Tick()
 {
     if(m_lifetime > 0.0f)
     {
         this->Move_Rate(m_Rate);
-        this->CGameObject::Update();
+        this->CGameObject::Tick();
     }
 }
 
+/**
+ * Draws the bullet, if it's still flying.
+ * @see obj::CEntity::Render()
+ **/
+void CProjectile::Render(gfx::CSpriteBatch& Batch, const float alpha) const
+{
+    if(m_lifetime > 0.0f)
+        this->CGameObject::Render(Batch, alpha);
+}
+
 void CProjectile::SetLifetime(const float value)
 {
     m_lifetime = value;
@@ -0,0 +1,220 @@
+/**
+ * @file
+ *  Definitions for the CProjectilePool class.
+ *
+ * @author George Kudrayvtsev
+ * @version 1.0
+ **/
+
+#include "World/Objects/ProjectilePool.hpp"
+
+using obj::CProjectilePool;
+
+CProjectilePool::CProjectilePool(const u_int capacity) :
+    m_x(capacity), m_y(capacity), m_vx(capacity), m_vy(capacity),
+    m_lifetime(capacity), m_angle(capacity), m_damage(capacity),
+    m_owner(capacity, e_PLAYER_SHOT), mp_allTextures(capacity, NULL),
+    m_count(0), m_capacity(capacity) {}
+
+CProjectilePool::~CProjectilePool()
+{}
+
+/**
+ * Launches a projectile toward a target.
+ *
+ * @param asset::CTexture* Projectile texture
+ * @param math::CVector2& Starting position
+ * @param math::CVector2& Position to fly towards
+ * @param float Rotation, in degrees
+ * @param u_int Damage done on impact
+ * @param ProjectileOwner Who fired it
+ * @param float Distance moved every frame, in pixels (optional)
+ *
+ * @return TRUE if launched, FALSE if the pool is full or the
+ *  target is on top of the starting position.
+ **/
+bool CProjectilePool::Fire(const asset::CTexture* pTexture,
+    const math::CVector2& Start, const math::CVector2& Target,
+    const float angle, const u_int damage, const ProjectileOwner owner,
+    const float speed)
+{
+    math::CVector2 Direction = Target - Start;
+    float length = Direction.Magnitude();
+
+    if(m_count == m_capacity || pTexture == NULL || length == 0.0f)
+        return false;
+
+    // v = c * (x1 - x0) / ||x1 - x0||
+    u_int i = m_count++;
+    m_x[i]          = Start.x;
+    m_y[i]          = Start.y;
+    m_vx[i]         = Direction.x / length * speed;
+    m_vy[i]         = Direction.y / length * speed;
+    m_lifetime[i]   = PROJECTILE_LIFETIME;
+    m_angle[i]      = angle;
+    m_damage[i]     = damage;
+    m_owner[i]      = owner;
+    mp_allTextures[i] = pTexture;
+
+    return true;
+}
+
+/**
+ * Moves every projectile and ages it by a frame.
+ *  Projectiles that are out of time (including sparks from the
+ *  last frame) are removed.
+ **/
+void CProjectilePool::Integrate()
+{
+    for(u_int i = 0; i < m_count; /* no third */)
+    {
+        if(m_lifetime[i] <= 0.0f)
+        {
+            this->Remove(i);
+            continue;
+        }
+
+        ++i;
+    }
+
+    for(u_int i = 0; i < m_count; ++i)
+    {
+        m_x[i] += m_vx[i];
+        m_y[i] += m_vy[i];
+        m_lifetime[i] -= 1.0f;
+    }
+}
+
+/**
+ * Turns a projectile into a spark where it is.
+ *  The spark is drawn by the next Render() and removed
+ *  by the next Integrate().
+ *
+ * @param u_int Projectile index
+ * @param asset::CTexture* Spark texture
+ **/
+void CProjectilePool::Explode(const u_int index, const asset::CTexture* pSpark)
+{
+    m_vx[index] = m_vy[index] = 0.0f;
+    m_lifetime[index]       = 0.0f;
+    mp_allTextures[index]   = pSpark;
+}
+
+/**
+ * @overload CProjectilePool::Explode(const u_int, const asset::CTexture*)
+ *
+ * @param math::CVector2& Where to put the spark
+ **/
+void CProjectilePool::Explode(const u_int index, const asset::CTexture* pSpark,
+    const math::CVector2& Position)
+{
+    m_x[index] = Position.x;
+    m_y[index] = Position.y;
+    this->Explode(index, pSpark);
+}
+
+/**
+ * Removes a projectile, moving the last one into its place.
+ * @param u_int Projectile index
+ **/
+void CProjectilePool::Remove(const u_int index)
+{
+    u_int last = --m_count;
+    if(index == last)
+        return;
+
+    m_x[index]          = m_x[last];
+    m_y[index]          = m_y[last];
+    m_vx[index]         = m_vx[last];
+    m_vy[index]         = m_vy[last];
+    m_lifetime[index]   = m_lifetime[last];
+    m_angle[index]      = m_angle[last];
+    m_damage[index]     = m_damage[last];
+    m_owner[index]      = m_owner[last];
+    mp_allTextures[index] = mp_allTextures[last];
+}
+
+/// Removes every projectile.
+void CProjectilePool::Clear()
+{
+    m_count = 0;
+}
+
+/**
+ * Draws every projectile (and spark) in one batch.
+ *  Projectiles are drawn part way through their last move.
+ *
+ * @param float How far along the next tick is, [0, 1] (optional)
+ **/
+void CProjectilePool::Render(const float alpha)
+{
+    const float behind = 1.0f - alpha;
+
+    m_Batch.Begin(gfx::CSpriteBatch::e_SORT_TEXTURE);
+
+    for(u_int i = 0; i < m_count; ++i)
+    {
+        const asset::CTexture* pTexture = mp_allTextures[i];
+        m_Batch.Draw(pTexture->GetTexture(),
+            math::CRectf(m_x[i] - m_vx[i] * behind, m_y[i] - m_vy[i] * behind,
+                pTexture->GetW(), pTexture->GetH()),
+            pTexture->GetUV(), m_angle[i]);
+    }
+
+    m_Batch.End();
+}
+
+u_int CProjectilePool::GetCount() const
+{
+    return m_count;
+}
+
+/**
+ * Checks if a projectile can still hit anything.
+ *
+ * @param u_int Projectile index
+ * @return TRUE if it's in flight, FALSE if it's a spark.
+ **/
+bool CProjectilePool::IsLive(const u_int index) const
+{
+    return (m_lifetime[index] > 0.0f);
+}
+
+math::CVector2 CProjectilePool::GetPosition(const u_int index) const
+{
+    return math::CVector2(m_x[index], m_y[index]);
+}
+
+/**
+ * Retrieves the path a projectile took during the last Integrate().
+ *
+ * @param u_int Projectile index
+ * @return Segment from the previous position to the current one.
+ **/
+math::CRay2 CProjectilePool::GetMotion(const u_int index) const
+{
+    return math::CRay2(m_x[index] - m_vx[index], m_y[index] - m_vy[index],
+        m_x[index], m_y[index]);
+}
+
+/**
+ * Retrieves the area a projectile covers, ignoring rotation.
+ *
+ * @param u_int Projectile index
+ * @return The projectile's collision box.
+ **/
+math::CRect CProjectilePool::GetBounds(const u_int index) const
+{
+    return math::CRect(m_x[index], m_y[index],
+        mp_allTextures[index]->GetW(), mp_allTextures[index]->GetH());
+}
+
+u_int CProjectilePool::GetDamage(const u_int index) const
+{
+    return m_damage[index];
+}
+
+obj::ProjectileOwner CProjectilePool::GetOwner(const u_int index) const
+{
+    return m_owner[index];
+}
@@ -45,16 +45,6 @@ void CTank::Drive(const float speed)
     }
 }
 
-/**
- * Adjusts the tank position.
- * @param math::CVector2 Tank adjustment rate
- **/
-void CTank::Adjust(const math::CVector2& Rate)
-{
-    m_Tank.Move_Rate(Rate);
-    m_Tower.Move_Rate(Rate);
-}
-
 /**
  * Aim the tank barrel.
  *
@@ -180,17 +170,35 @@ bool CTank::IsMoving() const
 }
 
 /**
- * Updates weapons and tank entities.
+ * Advances the tank and its weapons by a simulation tick.
+ * @return The tank state, 0 for a plain tank.
  **/
-int CTank::Update()
+int CTank::Tick()
 {
-    m_Tank.Update();
-    m_Tower.Update();
-    m_Weapon1.Update();
-    m_Weapon2.Update();
+    m_Tank.Tick();
+    m_Tower.Tick();
+    m_Weapon1.Tick();
+    m_Weapon2.Tick();
     return 0;
 }
 
+/**
+ * Draws the tank body, then the tower and weapons on top of it.
+ *
+ * @param gfx::CSpriteBatch& Batch to draw in, which has to be active
+ * @param float How far along the next tick is, [0, 1] (optional)
+ *
+ * @see obj::CEntity::Render()
+ * @todo Animate tank tower on firing.
+ **/
+void CTank::Render(gfx::CSpriteBatch& Batch, const float alpha) const
+{
+    m_Tank.Render(Batch, alpha);
+    m_Tower.Render(Batch, alpha);
+    m_Weapon1.Render(Batch, alpha);
+    m_Weapon2.Render(Batch, alpha);
+}
+
 /**
  * Retrieves barrel position.
  * @return Barrel position.
@@ -98,7 +98,8 @@ bool CWeapon::Fire()
     return true;
 }
 
-void CWeapon::Update()
+/// Counts down the firing and reloading delays.
+void CWeapon::Tick()
 {
     if(m_fire_delay > 0) m_fire_delay--;
     if(m_reload_delay > 0)
@@ -111,7 +112,12 @@ void CWeapon::Update()
         }
     }
 
-    m_OnTankSprite.Update();
+    m_OnTankSprite.Tick();
+}
+
+void CWeapon::Render(gfx::CSpriteBatch& Batch, const float alpha) const
+{
+    m_OnTankSprite.Render(Batch, alpha);
 }
 
 void CWeapon::SetClipCount(const u_int count)
@@ -13,11 +13,16 @@ using game::g_Log;
 using game::g_Settings;
 using asset::CAssetManager;
 
+/// Enemies given to a job thread at a time while thinking.
+static const u_int ENEMY_THINK_GRAIN = 8;
+
 /**
  * Initialize all of the internal components.
  * @param GameState& The current engine state
  */
-CWorld::CWorld(game::GameState& engine_state) :  m_engine_state(engine_state) {}
+CWorld::CWorld(game::GameState& engine_state) :
+    m_ViewOffset(gfx::INVALID_UNIFORM), mp_Spark(NULL),
+    m_engine_state(engine_state) {}
 
 void CWorld::Init()
 {
@@ -25,6 +30,18 @@ void CWorld::Init()
     g_Log << "[INFO] Initializing world.\n";
     g_Log.ShowLastLog();
 
+    // Start solving enemy paths in the background.
+    if(!ai::CPathService::GetInstance().Init(2))
+        g_Log.ShowLastLog();
+
+    // Let the enemies think on every core, this thread included.
+    int job_threads = g_Settings.GetInt("JobThreads", -1);
+    if(job_threads < 0)
+        job_threads = game::CJobSystem::GetCoreCount() - 1;
+
+    if(!game::CJobSystem::GetInstance().Init(job_threads))
+        g_Log.ShowLastLog();
+
     // Load first level
     game::CLevel* pLevelOne = new game::CLevel;
     if(!pLevelOne->LoadLevel(1))
@@ -37,13 +54,16 @@ void CWorld::Init()
     mp_Levels.push_back(pLevelOne);
 
     mp_Levels[0]->SetPanRate(3.0f);
-    mp_Levels[0]->Update();
     mp_ActiveLevel = mp_Levels[0];
 
     // Load game background
     m_Background.LoadFromTexture(CAssetManager::Create<asset::CTexture>(
         g_Settings.GetValueAt("GameBackground").c_str()));
 
+    // What projectiles turn into when they hit something.
+    mp_Spark = CAssetManager::Create<asset::CTexture>(
+        "Data/Textures/Sprites/Spark.png");
+
     // Load lighting shader
     if(!m_Lighting.LoadFromFile("Data/Shaders/Lighting.vs",
         "Data/Shaders/Lighting.fs"))
@@ -59,6 +79,9 @@ void CWorld::Init()
 
     m_Lighting.PassVariableiv("scr_height", screen, 1, 1);
 
+    // Changes every frame, so it's looked up once here.
+    m_ViewOffset = m_Lighting.Find("view_offset");
+
     // Set player spawn location.
     if(!m_Player.Init(g_Settings))
     {
@@ -68,55 +91,68 @@ void CWorld::Init()
     }
     m_Player.SetSpawn(
         mp_ActiveLevel->GetObjectiveMap().GetPlayerSpawn()->GetPosition());
-    m_Player.Update();
+    m_Player.Tick();
 
-    while(!mp_ActiveLevel->PanMaps(m_Player.GetPosition()));
+    // Bring the player into view.
+    while(mp_ActiveLevel->Pan(m_Player.GetPosition()));
 
     // Spawn enemies at all available spawns.
     while(this->SpawnEnemy());
+    ai::CEnemy::UpdateAllLOS(mp_ActiveLevel->GetCollisionMap());
 
-    // Add map lights to shader.
-    std::vector<gfx::CLight*>& allLights = mp_ActiveLevel->GetObjectiveMap().GetLights();
-
-    if(!m_Lighting.SetMacro("MAX_LIGHTS", allLights.size()))
+    // Lights are sorted into screen tiles every frame, so the shader
+    // doesn't depend on how many there are in the level.
+    math::CRect View = mp_ActiveLevel->GetCamera().GetView();
+    if(!m_LightGrid.Init(m_Lighting, View.w, View.h))
     {
         g_Log.Flush();
-        g_Log << "[ERROR] Failed to set shader macro!\n";
+        g_Log << "[ERROR] Failed to set up lighting!\n";
         g_Log << "[ERROR] " << m_Lighting.GetError() << "\n";
         g_Log.ShowLastLog();
         gk::handle_error(g_Log.GetLastLog().c_str());
     }
 
-    float* positions    = new float[allLights.size() * 2];
-    float* attns        = new float[allLights.size() * 3];
-    float* cols         = new float[allLights.size() * 3];
-    float* brightnesses = new float[allLights.size()];
+    // Level lights never move, so they're baked into a lightmap once,
+    // or loaded if they were baked for the same lights and walls
+    // before. Only lights that move are left to the tiles.
+    const math::CRect& Cells =
+        mp_ActiveLevel->GetTerrainMap().GetIndexBounds();
+    math::CRect Bounds(Cells.x * game::TILE_SIZE, Cells.y * game::TILE_SIZE,
+        Cells.w * game::TILE_SIZE, Cells.h * game::TILE_SIZE);
 
-    for(size_t i = 0; i < allLights.size(); ++i)
-    {
-        positions[i * 2]    = allLights[i]->GetPosition()[0];
-        positions[i * 2 + 1]= allLights[i]->GetPosition()[1];
+    const std::vector<gfx::CLight*>& Level_Lights =
+        mp_ActiveLevel->GetObjectiveMap().GetLights();
+    std::string lightmap = mp_ActiveLevel->GetLevelName() + gfx::LIGHTMAP_EXT;
 
-        attns[i * 3]        = allLights[i]->GetAttenuation()[0];
-        attns[i * 3 + 1]    = allLights[i]->GetAttenuation()[1];
-        attns[i * 3 + 2]    = allLights[i]->GetAttenuation()[2];
+    const unsigned long long level_key = mp_ActiveLevel->GetSourceKey();
 
-        cols[i * 3]         = allLights[i]->GetColor()[0];
-        cols[i * 3 + 1]     = allLights[i]->GetColor()[1];
-        cols[i * 3 + 2]     = allLights[i]->GetColor()[2];
+    if(!m_Lightmap.LoadFromFile(lightmap.c_str(), Level_Lights, Bounds,
+        level_key))
+    {
+        g_Log.Flush();
+        g_Log << "[INFO] Baking " << Level_Lights.size() << " light(s) into ";
+        g_Log << m_Lightmap.GetW() << "x" << m_Lightmap.GetH() << " lightmap.\n";
+        g_Log.ShowLastLog();
 
-        brightnesses[i]     = allLights[i]->GetBrightness();
+        m_Lightmap.Bake(Level_Lights, Bounds, level_key);
+        if(!m_Lightmap.SaveToFile(lightmap.c_str()))
+        {
+            g_Log.Flush();
+            g_Log << "[INFO] Failed to save lightmap to " << lightmap << ".\n";
+            g_Log.ShowLastLog();
+        }
     }
 
-    m_Lighting.PassVariablefv("light_pos", positions,    2, allLights.size());
-    m_Lighting.PassVariablefv("light_att", attns,        3, allLights.size());
-    m_Lighting.PassVariablefv("light_col", cols,         3, allLights.size());
-    m_Lighting.PassVariablefv("light_brt", brightnesses, 1, allLights.size());
+    m_Lightmap.Init(m_Lighting);
 
-    delete[] positions;
-    delete[] attns;
-    delete[] cols;
-    delete[] brightnesses;
+    // The scene is drawn offscreen, then lit in a single pass.
+    if(!m_Compositor.Init(View.w, View.h))
+    {
+        g_Log.Flush();
+        g_Log << "[ERROR] Failed to create offscreen render targets.\n";
+        g_Log.ShowLastLog();
+        gk::handle_error(g_Log.GetLastLog().c_str());
+    }
 
     //mp_enemy_light_poss = new float[mp_Enemies.size() * 2];
     //mp_enemy_light_atts = new float[mp_Enemies.size() * 3];
@@ -143,22 +179,6 @@ CWorld::~CWorld()
     g_Log.Flush();
     g_Log << "[DEBUG] Destroying CWorld instance.\n";
     
-    for(obj::pBulletCollection::iterator i = mp_playerBullets.begin(); 
-        i != mp_playerBullets.end(); /* no third */)
-    {
-        delete (*i);
-        i = mp_playerBullets.erase(i);
-    }
-    mp_playerBullets.clear();
-
-    for(obj::pBulletCollection::iterator i = mp_enemyBullets.begin();
-        i != mp_enemyBullets.end(); )
-    {
-        delete (*i);
-        i = mp_enemyBullets.erase(i);
-    }        
-    mp_enemyBullets.clear();
-
     for(ai::CEnemies::iterator i = ai::CEnemy::p_allEnemies.begin(); 
         i != ai::CEnemy::p_allEnemies.end(); /* no third */)
     {
@@ -166,6 +186,8 @@ CWorld::~CWorld()
     }
 
     ai::CEnemy::p_allEnemies.clear();
+    ai::CPathService::GetInstance().Shutdown();
+    game::CJobSystem::GetInstance().Shutdown();
     m_engine_state = game::e_QUIT;
 }
 
@@ -223,6 +245,10 @@ void CWorld::HandleSystemEvent(const SDL_Event& Evt)
         case SDLK_e:
             this->SpawnEnemy();
             break;
+
+        case SDLK_o:
+            mp_ActiveLevel->ToggleOverlay();
+            break;
 #endif // _DEBUG
         }
         break;
@@ -249,88 +275,125 @@ void CWorld::HandleSystemEvent(const SDL_Event& Evt)
     m_PlayerRate.Move(speed, -angle);
 }
 
-/// Updates all World elements.
-void CWorld::Update()
+/**
+ * Advances the world by a simulation tick.
+ *  Player and enemy logic, projectiles, and collisions all happen
+ *  here. Nothing is drawn, so this can be called as often as needed
+ *  before drawing the result with Render().
+ *
+ *  A tick is always 1 / game::SIM_RATE seconds long, which is what
+ *  every per-tick speed and delay is tuned for, so no time step is
+ *  passed down to the entities.
+ **/
+void CWorld::Tick()
 {
     // Player logic
     m_Player.Drive(m_PlayerRate.x);
     m_Player.Turn(m_PlayerRate.y);
 
-    // Pan maps based on player position
-    mp_ActiveLevel->PanMaps(m_Player.GetPosition());
+    // Pan the camera based on player position
+    mp_ActiveLevel->Pan(m_Player.GetPosition());
 
     // Listener is player position.
     //alListener3f(AL_POSITION,
     //    m_Player.GetPosition().x,
     //    m_Player.GetPosition().y, 
     //    0.0f);
-    
-    std::vector<gfx::CLight*>& allLights = mp_ActiveLevel->GetObjectiveMap().GetLights();
-    float* positions = new float[allLights.size() * 2];
-    for(size_t i = 0; i < allLights.size(); ++i)
-    {
-        positions[i * 2]    = allLights[i]->GetPosition()[0];
-        positions[i * 2 + 1]= allLights[i]->GetPosition()[1];
-    }
-
-    m_Lighting.PassVariablefv("light_pos", positions, 2, allLights.size());
-    delete[] positions;
-
-    // Adjust objects to go with map panning
-    m_Player.Adjust(mp_Levels[0]->GetTerrainMap().GetPanRate());
-    for(std::list<ai::CEnemyTank*>::iterator i = mp_Enemies.begin();
-        i != mp_Enemies.end(); ++i)
-    {
 
-        (*i)->Adjust(mp_ActiveLevel->GetTerrainMap().GetPanRate());
-    }
+    m_Player.Tick();
 
-    // Render everything
-    m_Lighting.Link();
-    m_Background.Update();
-    mp_Levels[0]->Update();
-    m_Player.Update();
+    // Every enemy thinks at once, only looking at itself and at the
+    // world as it was after the player moved.
+    mp_allThinking.assign(mp_Enemies.begin(), mp_Enemies.end());
+    game::CJobSystem::GetInstance().ParallelFor(mp_allThinking.size(),
+        ENEMY_THINK_GRAIN, &CWorld::ThinkEnemies, &mp_allThinking);
 
-    // Update all of the enemies, rendering them and shooting if
-    // the returned state specifies it.
+    // Then they act on it one by one, shooting if the returned state
+    // specifies it.
     for(std::list<ai::CEnemyTank*>::iterator i = mp_Enemies.begin();
         i != mp_Enemies.end(); ++i)
     {
-        int state = (*i)->Update();
+        int state = (*i)->Act();
 
         /// @todo Add a GetBarrelPosition() to the enemy base class.
         if(state & ai::e_FIRING_SECONDARY)
         {
             math::CVector2 Aim_Vec = (*i)->GetPosition() - 
                 m_Player.GetPosition();
-            obj::CBullet* pBullet = new obj::CBullet;
-            pBullet->LoadFromTexture((*i)->GetSecondary().GetProjectileTexture());
-            pBullet->SetDamage((*i)->GetSecondary().GetDamage());
-            pBullet->Launch((*i)->GetBarrelPosition(), m_Player.GetPosition());
-            pBullet->Rotate(math::deg(atan2(Aim_Vec.y, Aim_Vec.x)));
-            mp_enemyBullets.push_back(pBullet);
+            m_Projectiles.Fire((*i)->GetSecondary().GetProjectileTexture(),
+                (*i)->GetBarrelPosition(), m_Player.GetPosition(),
+                math::deg(atan2(Aim_Vec.y, Aim_Vec.x)),
+                (*i)->GetSecondary().GetDamage(), obj::e_ENEMY_SHOT);
         }
         else if(state & ai::e_FIRING_PRIMARY)
         {
             math::CVector2 Aim_Vec = (*i)->GetPosition() - 
                 m_Player.GetPosition();
-            obj::CBullet* pBullet = new obj::CBullet;
-            pBullet->LoadFromTexture((*i)->GetPrimary().GetProjectileTexture());
-            pBullet->SetDamage((*i)->GetPrimary().GetDamage());
-            pBullet->Launch((*i)->GetBarrelPosition(), m_Player.GetPosition());
-            pBullet->Rotate(math::deg(atan2(Aim_Vec.y, Aim_Vec.x)) + 180);
-            mp_enemyBullets.push_back(pBullet);
+            m_Projectiles.Fire((*i)->GetPrimary().GetProjectileTexture(),
+                (*i)->GetBarrelPosition(), m_Player.GetPosition(),
+                math::deg(atan2(Aim_Vec.y, Aim_Vec.x)) + 180,
+                (*i)->GetPrimary().GetDamage(), obj::e_ENEMY_SHOT);
         }
     }
 
-    // Finished rendering.
-    m_Lighting.Unlink();
+    // Refresh what every enemy can see for the next frame.
+    ai::CEnemy::UpdateAllLOS(mp_ActiveLevel->GetCollisionMap());
 
     // World logic
     this->HandleWorldEvents();
     this->HandleCollisions();
 }
 
+/**
+ * Draws the world as of the last Tick().
+ *  Anything that moves is drawn part way between where it was
+ *  before the last tick and where it is now.
+ *
+ * @param float How far along the next tick is, [0, 1] (optional)
+ * @see game::CTimer::GetAlpha()
+ **/
+void CWorld::Render(const float alpha)
+{
+    // Lights stay in world coordinates, the shader just needs to
+    // know where the camera is.
+    const game::CCamera& Camera = mp_ActiveLevel->GetCamera();
+    math::CVector2 Offset = Camera.GetRenderOffset(alpha);
+    float offset[2] = {Offset.x, Offset.y};
+    m_Lighting.SetUniform(m_ViewOffset, offset, 2, 1);
+
+    m_Lightmap.Update(m_Lighting);
+    m_LightGrid.Update(mp_Lights, Offset, m_Lighting);
+
+    // The scene is drawn without lighting, so pixels drawn over
+    // each other aren't lit more than once.
+    m_Compositor.BeginScene();
+    m_Background.Draw();
+
+    Camera.Enable(alpha);
+    mp_ActiveLevel->Render();
+
+    // Tanks overlap each other, so they're drawn in order.
+    m_Batch.Begin(gfx::CSpriteBatch::e_SORT_NONE);
+    m_Player.Render(m_Batch, alpha);
+    for(std::list<ai::CEnemyTank*>::iterator i = mp_Enemies.begin();
+        i != mp_Enemies.end(); ++i)
+    {
+        (*i)->Render(m_Batch, alpha);
+    }
+    m_Batch.End();
+    Camera.Disable();
+
+    m_Compositor.Light(m_Lighting);
+
+    // Projectiles (and the debug overlay) aren't lit.
+    Camera.Enable(alpha);
+    m_Projectiles.Render(alpha);
+    mp_ActiveLevel->RenderOverlay();
+    Camera.Disable();
+
+    m_Compositor.Present();
+}
+
 /// Handles all collisions with elements such as the player and map.
 void CWorld::HandleCollisions()
 {
@@ -344,97 +407,116 @@ void CWorld::HandleCollisions()
             m_Player.Turn(-m_PlayerRate.y);
     }
     
-    // Update player bullets on-screen and check if they are
-    // off-screen. If they are, delete them. If they are currently
-    // colliding with something, change the entity to a spark for one
-    // frame, and delete it.
-    for(obj::pBulletCollection::iterator i = mp_playerBullets.begin();
-        i != mp_playerBullets.end(); /* no third */)
+    // Move every projectile, then check what the ones still in flight
+    // hit. Anything hitting a wall or an enemy turns into a spark for a
+    // frame; shots hitting the player just disappear.
+    m_Projectiles.Integrate();
+
+    // Walls are already on a grid, so walk each projectile's path for
+    // this frame through it. Nothing can tunnel through a wall, no
+    // matter how fast it goes.
+    game::CCollisionMap& Walls = mp_ActiveLevel->GetCollisionMap();
+    math::CVector2 Impact;
+    for(u_int i = 0; i < m_Projectiles.GetCount(); ++i)
     {
-        if((*i)->GetLifetime() <= 0.0f)
-        {
-            i = mp_playerBullets.erase(i);
+        if(!m_Projectiles.IsLive(i))
             continue;
-        }
 
-        obj::CGameObject* pCurrent_Tile = mp_ActiveLevel->GetCollisionMap().
-            FindTile((*i)->GetPosition());
+        obj::CGameObject* pCurrent_Tile = Walls.CastRay(
+            m_Projectiles.GetMotion(i), &Impact);
 
         if(pCurrent_Tile != NULL)
         {
-            (*i)->LoadFromTexture(
-                asset::CAssetManager::Create<asset::CTexture>(
-                "Data/Textures/Sprites/Spark.png"));
-            (*i)->Update();
-            mp_ActiveLevel->GetCollisionMap().RemoveTile(pCurrent_Tile);
-            i = mp_playerBullets.erase(i);
+            m_Projectiles.Explode(i, mp_Spark, Impact);
+            Walls.RemoveTile(pCurrent_Tile);
         }
+    }
+
+    // Everything that moves goes into the broad phase, which only
+    // hands back shots that are near something they can hit.
+    m_BroadPhase.Clear();
+    mp_allTargets.assign(mp_Enemies.begin(), mp_Enemies.end());
+
+    for(u_int i = 0; i < m_Projectiles.GetCount(); ++i)
+    {
+        if(!m_Projectiles.IsLive(i))
+            continue;
+
+        if(m_Projectiles.GetOwner(i) == obj::e_PLAYER_SHOT)
+            m_BroadPhase.Add(m_Projectiles.GetBounds(i),
+                e_LAYER_PLAYER_SHOT, e_LAYER_ENEMY, i);
         else
-        {
-            for(std::list<ai::CEnemyTank*>::iterator j = mp_Enemies.begin();
-                j != mp_Enemies.end(); /* no third */)
-            {
-                if((*i)->CheckCollision((*j)->GetMainEntity()))
-                {
-                    (*i)->LoadFromTexture(
-                        asset::CAssetManager::Create<asset::CTexture>(
-                        "Data/Textures/Sprites/Spark.png"));
-                    (*i)->SetLifetime(0.0f);    // It'll be deleted next frame
-                    (*j)->Damage((*i)->GetDamage());
-                    if(!(*j)->IsAlive())
-                    {
-                        j = mp_Enemies.erase(j);
-                        m_Player.IncreaseKillCount();
-                    }
-                    else ++j;
-                    continue;
-                }
-
-                ++j;
-            }
+            m_BroadPhase.Add(m_Projectiles.GetBounds(i),
+                e_LAYER_ENEMY_SHOT, e_LAYER_PLAYER, i);
+    }
 
-            (*i)->Update();
-            ++i;
-        }
+    for(u_int i = 0; i < mp_allTargets.size(); ++i)
+    {
+        m_BroadPhase.Add(mp_allTargets[i]->GetMainEntity()->GetCollisionBox(),
+            e_LAYER_ENEMY, 0, i);
     }
 
-    // Update all enemy bullets on-screen and check if they are
-    // off-screen. If they are, delete them. If they are currently
-    // colliding with something, change the entity to a spark for one
-    // frame, and delete it.
-    for(obj::pBulletCollection::iterator j = mp_enemyBullets.begin();
-            j != mp_enemyBullets.end(); /* no third */)
+    m_BroadPhase.Add(m_Player.GetTankEntity()->GetCollisionBox(),
+        e_LAYER_PLAYER, 0, 0);
+    m_BroadPhase.Add(m_Player.GetTowerEntity()->GetCollisionBox(),
+        e_LAYER_PLAYER, 0, 1);
+
+    const std::vector<math::CBroadPhase::Pair>& Pairs =
+        m_BroadPhase.FindPairs();
+
+    // Narrow phase, only on the candidates.
+    m_spent.clear();
+    for(size_t p = 0; p < Pairs.size(); ++p)
     {
-        if((*j)->GetLifetime() <= 0.0f)
+        // Put the projectile first.
+        u_int shot = Pairs[p].first_id, target = Pairs[p].second_id;
+        u_int layer = Pairs[p].first_layer;
+        if(layer == e_LAYER_ENEMY || layer == e_LAYER_PLAYER)
         {
-            j = mp_enemyBullets.erase(j);
-            continue;
+            std::swap(shot, target);
+            layer = Pairs[p].second_layer;
         }
 
-        obj::CGameObject* pCurrent_Tile = mp_ActiveLevel->GetCollisionMap().
-            FindTile((*j)->GetPosition());
-        
-        if(pCurrent_Tile != NULL)
-        {
-            (*j)->LoadFromTexture(
-                asset::CAssetManager::Create<asset::CTexture>(
-                "Data/Textures/Sprites/Spark.png"));
-            (*j)->Update();
-            mp_ActiveLevel->GetCollisionMap().RemoveTile(pCurrent_Tile);
-            j = mp_enemyBullets.erase(j);
-        }
-        else if(m_Player.GetTankEntity()->CheckCollision(*j) ||
-            m_Player.GetTowerEntity()->CheckCollision(*j))
+        math::CRect Bounds = m_Projectiles.GetBounds(shot);
+
+        if(layer == e_LAYER_PLAYER_SHOT)
         {
-            m_Player.Damage((*j)->GetDamage());
-            j = mp_enemyBullets.erase(j);
+            ai::CEnemyTank* pEnemy = mp_allTargets[target];
+            // A shot only hits the first enemy it overlaps.
+            if(!m_Projectiles.IsLive(shot) || !pEnemy->IsAlive() ||
+                !pEnemy->GetMainEntity()->CheckCollision(Bounds))
+            {
+                continue;
+            }
+
+            m_Projectiles.Explode(shot, mp_Spark);
+            pEnemy->Damage(m_Projectiles.GetDamage(shot));
+            if(!pEnemy->IsAlive())
+            {
+                mp_Enemies.remove(pEnemy);
+                m_Player.IncreaseKillCount();
+            }
         }
         else
         {
-            (*j)->Update();
-            ++j;
+            obj::CGameObject* pPart = (target == 0) ?
+                m_Player.GetTankEntity() : m_Player.GetTowerEntity();
+
+            // Hitting both the tank and tower only counts once.
+            if(!m_Projectiles.IsLive(shot) || !pPart->CheckCollision(Bounds))
+                continue;
+
+            m_Player.Damage(m_Projectiles.GetDamage(shot));
+            m_Projectiles.Explode(shot, mp_Spark);
+            m_spent.push_back(shot);
         }
     }
+
+    // Shots that hit the player don't leave a spark. Remove them from
+    // the back, so swapping doesn't move any that are still to go.
+    std::sort(m_spent.begin(), m_spent.end());
+    for(size_t i = m_spent.size(); i > 0; --i)
+        m_Projectiles.Remove(m_spent[i - 1]);
 }
 
 /**
@@ -443,7 +525,8 @@ void CWorld::HandleCollisions()
  */
 void CWorld::HandleWorldEvents()
 {
-    const math::CVector2 Mouse   = game::GetMousePosition();
+    const math::CVector2 Mouse   = mp_ActiveLevel->GetCamera().ToWorld(
+        game::GetMousePosition());
     const math::CVector2 Aim_Vec = m_Player.GetPosition() - Mouse;
 
     m_Player.Aim(Mouse);
@@ -457,26 +540,20 @@ void CWorld::HandleWorldEvents()
     {
         if(m_Player.FirePrimary())
         {
-            obj::CBullet* pBullet = new obj::CBullet;
-            pBullet->LoadFromTexture(m_Player.GetPrimary().GetProjectileTexture());
-            pBullet->SetDamage(m_Player.GetPrimary().GetDamage());
-            pBullet->Launch(m_Player.GetBarrelPosition(), Mouse);
-            pBullet->Rotate(math::deg(atan2(Aim_Vec.y, Aim_Vec.x)) + 180);
-
-            mp_playerBullets.push_back(pBullet);
+            m_Projectiles.Fire(m_Player.GetPrimary().GetProjectileTexture(),
+                m_Player.GetBarrelPosition(), Mouse,
+                math::deg(atan2(Aim_Vec.y, Aim_Vec.x)) + 180,
+                m_Player.GetPrimary().GetDamage(), obj::e_PLAYER_SHOT);
         }
     }
     if(game::IsPressed(SDL_BUTTON_RIGHT))
     {
         if(m_Player.FireSecondary())
         {
-            obj::CBullet* pBullet = new obj::CBullet;
-            pBullet->LoadFromTexture(m_Player.GetSecondary().GetProjectileTexture());
-            pBullet->SetDamage(m_Player.GetSecondary().GetDamage());
-            pBullet->Launch(m_Player.GetBarrelPosition(), Mouse);
-            pBullet->Rotate(math::deg(atan2(Aim_Vec.y, Aim_Vec.x)));
-
-            mp_playerBullets.push_back(pBullet);
+            m_Projectiles.Fire(m_Player.GetSecondary().GetProjectileTexture(),
+                m_Player.GetBarrelPosition(), Mouse,
+                math::deg(atan2(Aim_Vec.y, Aim_Vec.x)),
+                m_Player.GetSecondary().GetDamage(), obj::e_PLAYER_SHOT);
         }
     }
 }
@@ -493,7 +570,6 @@ bool CWorld::SpawnEnemy()
     for(ai::CEnemies::iterator i = ai::CEnemy::p_allEnemies.begin();
         i != ai::CEnemy::p_allEnemies.end(); ++i)
     {
-        (*i)->Update();
         p_allObjs.push_back((*i)->GetMainEntity());
     }
 
@@ -511,13 +587,31 @@ bool CWorld::SpawnEnemy()
     
     p_Enemy->Init(g_Settings);
     p_Enemy->Spawn(p_Spawn->GetPosition());
-    p_Enemy->Update();
+    p_Enemy->Tick();
     p_Enemy->SetDestination(p_Dest->GetPosition() + math::CVector2(1.0f, 1.0f));
     mp_Enemies.push_back(p_Enemy);
 
     return true;
 }
 
+/**
+ * Lets a range of enemies think, on a job thread.
+ *
+ * @param void* std::vector<ai::CEnemyTank*> of every enemy
+ * @param u_int First enemy
+ * @param u_int One past the last enemy
+ *
+ * @see ai::CEnemy::Think()
+ **/
+void CWorld::ThinkEnemies(void* pData, const u_int begin, const u_int end)
+{
+    std::vector<ai::CEnemyTank*>& Enemies =
+        *static_cast<std::vector<ai::CEnemyTank*>*>(pData);
+
+    for(u_int i = begin; i < end; ++i)
+        Enemies[i]->Think();
+}
+
 void CWorld::HandleGameEvent(const game::GameEvent* const pEvt)
 {
 }
@@ -526,3 +620,21 @@ obj::CPlayer& CWorld::GetPlayer()
 {
     return m_Player;
 }
+
+/**
+ * Retrieves the broad phase used for projectiles, mostly for its stats.
+ * @return The broad phase, as of the last frame.
+ **/
+const math::CBroadPhase& CWorld::GetBroadPhase() const
+{
+    return m_BroadPhase;
+}
+
+/**
+ * Retrieves the compositor the world is drawn through, for its timings.
+ * @return The compositor, as of the last frame.
+ **/
+const gfx::CCompositor& CWorld::GetCompositor() const
+{
+    return m_Compositor;
+}